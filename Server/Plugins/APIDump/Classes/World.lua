@@ -1706,6 +1706,28 @@ function OnAllChunksAvailable()</pre> All return values from the callbacks are i
 				},
 				Notes = "Returns the block type and metadata for the block at the specified coords. The first value specifies if the block is in a valid loaded chunk, the other values are valid only if BlockValid is true.",
 			},
+			GetBlocksInCuboid =
+			{
+				Params =
+				{
+					{
+						Name = "Cuboid",
+						Type = "cCuboid",
+					},
+				},
+				Returns =
+				{
+					{
+						Name = "Blocks",
+						Type = "table",
+					},
+					{
+						Name = "AreAllChunksValid",
+						Type = "boolean",
+					},
+				},
+				Notes = "Reads all the blocks in the cuboid (both coords inclusive) into a flat array-table of BlockState IDs, without creating a table per block. The block at the relative coords {x, y, z} (from the cuboid's minimum corner) is at index 1 + x + z * SizeX + y * SizeX * SizeZ. Blocks in chunks that are not loaded are reported as air, in which case the second value is false. The whole read is done under a single chunkmap lock, making it much faster than calling GetBlock() for each block.",
+			},
 			GetDataPath =
 			{
 				Returns =
@@ -1944,6 +1966,46 @@ function OnAllChunksAvailable()</pre> All return values from the callbacks are i
 				},
 				Notes = "Returns the number of unused dirty chunks. That's the number of chunks that we can save and then unload.",
 			},
+			GetPregenerationNumChunksDone =
+			{
+				Returns =
+				{
+					{
+						Type = "number",
+					},
+				},
+				Notes = "Returns the number of chunks processed (generated or skipped) by the current or last pregeneration in this world. See {{cWorld#StartPregenerationSpiral|StartPregenerationSpiral}}().",
+			},
+			GetPregenerationNumChunksTotal =
+			{
+				Returns =
+				{
+					{
+						Type = "number",
+					},
+				},
+				Notes = "Returns the number of chunks in the area of the current or last pregeneration in this world, 0 if there was none.",
+			},
+			GetPregenerationStatus =
+			{
+				Returns =
+				{
+					{
+						Type = "string",
+					},
+				},
+				Notes = "Returns a human readable, single-line description of the pregeneration progress in this world.",
+			},
+			GetRandomTickSpeed =
+			{
+				Returns =
+				{
+					{
+						Type = "number",
+					},
+				},
+				Notes = "Returns the number of random block ticks done in each chunk section per game tick. Defaults to 3, as in vanilla.",
+			},
 			GetScoreBoard =
 			{
 				Returns =
@@ -2315,6 +2377,16 @@ function OnAllChunksAvailable()</pre> All return values from the callbacks are i
 				},
 				Notes = "Returns whether PVP is enabled in the world settings.",
 			},
+			IsPregenerating =
+			{
+				Returns =
+				{
+					{
+						Type = "boolean",
+					},
+				},
+				Notes = "Returns true if a pregeneration is running in this world.",
+			},
 			IsSavingEnabled =
 			{
 				Returns =
@@ -2769,6 +2841,69 @@ function OnAllChunksAvailable()</pre> All return values from the callbacks are i
 				},
 				Notes = "Sets the block at the specified coords, replaces the block entities for the previous block type, creates a new block entity for the new block, if appropriate, and wakes up the simulators. This is the preferred way to set blocks, as opposed to FastSetBlock(), which is only to be used under special circumstances.",
 			},
+			SetBlocks =
+			{
+				Params =
+				{
+					{
+						Name = "Edits",
+						Type = "table",
+					},
+				},
+				Returns =
+				{
+					{
+						Name = "NumBlocksSet",
+						Type = "number",
+					},
+				},
+				Notes = "Sets many blocks at once, each one the same way as SetBlock() does. Edits is a flat array-table of {X1, Y1, Z1, BlockState1, X2, Y2, Z2, BlockState2, ...}, BlockStates are the numeric IDs as returned by GetBlock(). The whole batch is applied under a single chunkmap lock, the changes are sent to the clients once per chunk section and the light is recalculated once per chunk. For the best performance, keep the edits in the same chunk together. Blocks in chunks that are not loaded are skipped. Returns the number of blocks that were set.",
+			},
+			SetBlocksInCuboid =
+			{
+				{
+					Params =
+					{
+						{
+							Name = "Cuboid",
+							Type = "cCuboid",
+						},
+						{
+							Name = "BlockState",
+							Type = "number",
+						},
+					},
+					Returns =
+					{
+						{
+							Name = "NumBlocksSet",
+							Type = "number",
+						},
+					},
+					Notes = "Fills the cuboid (both coords inclusive) with the specified BlockState, as a single batch (see SetBlocks()). Blocks in chunks that are not loaded are skipped. Returns the number of blocks that were set.",
+				},
+				{
+					Params =
+					{
+						{
+							Name = "Cuboid",
+							Type = "cCuboid",
+						},
+						{
+							Name = "Blocks",
+							Type = "table",
+						},
+					},
+					Returns =
+					{
+						{
+							Name = "NumBlocksSet",
+							Type = "number",
+						},
+					},
+					Notes = "Sets the blocks in the cuboid (both coords inclusive) from a flat array-table of BlockStates, in the same order as returned by GetBlocksInCuboid(), as a single batch (see SetBlocks()). Blocks in chunks that are not loaded are skipped. Returns the number of blocks that were set.",
+				},
+			},
 			SetChunkAlwaysTicked =
 			{
 				Params =
@@ -2957,6 +3092,17 @@ function OnAllChunksAvailable()</pre> All return values from the callbacks are i
 				},
 				Notes = "Requests that the specified block be ticked at the start of the next world tick. Only one block per chunk can be queued this way; a second call to the same chunk overwrites the previous call.",
 			},
+			SetRandomTickSpeed =
+			{
+				Params =
+				{
+					{
+						Name = "RandomTickSpeed",
+						Type = "number",
+					},
+				},
+				Notes = "Sets the number of random block ticks done in each chunk section per game tick. Zero disables random ticking (crop growth, grass spreading, leaf decay etc.). Negative values are clamped to zero.",
+			},
 			SetSavingEnabled =
 			{
 				Params =
@@ -3644,6 +3790,70 @@ function OnAllChunksAvailable()</pre> All return values from the callbacks are i
 				},
 				Notes = "Spawns experience orbs of the specified total value at the given location. The orbs' values are split according to regular Minecraft rules. Returns an array-table of UniqueID of all the orbs.",
 			},
+			StartPregenerationSpiral =
+			{
+				Params =
+				{
+					{
+						Name = "CenterChunkX",
+						Type = "number",
+					},
+					{
+						Name = "CenterChunkZ",
+						Type = "number",
+					},
+					{
+						Name = "Radius",
+						Type = "number",
+					},
+				},
+				Returns =
+				{
+					{
+						Type = "boolean",
+					},
+				},
+				Notes = "Starts pregenerating the chunks within Radius chunks of the center chunk, in the background, outwards from the center. The chunks are generated, lit and written directly into the world storage without being loaded into the world; chunks that are already stored or loaded are skipped. The pregeneration survives server restarts, and is throttled by the [Pregenerator] settings in world.ini. Returns false if a pregeneration is already running in this world.",
+			},
+			StartPregenerationSquare =
+			{
+				Params =
+				{
+					{
+						Name = "Chunk1X",
+						Type = "number",
+					},
+					{
+						Name = "Chunk1Z",
+						Type = "number",
+					},
+					{
+						Name = "Chunk2X",
+						Type = "number",
+					},
+					{
+						Name = "Chunk2Z",
+						Type = "number",
+					},
+				},
+				Returns =
+				{
+					{
+						Type = "boolean",
+					},
+				},
+				Notes = "Starts pregenerating the chunks in the rectangle between the two chunks (inclusive), in the background. Works the same as {{cWorld#StartPregenerationSpiral|StartPregenerationSpiral}}(), except for the order in which the chunks are generated. Returns false if a pregeneration is already running in this world.",
+			},
+			StopPregeneration =
+			{
+				Returns =
+				{
+					{
+						Type = "boolean",
+					},
+				},
+				Notes = "Stops the pregeneration running in this world, it will not be resumed after a restart. The chunks generated so far are kept. Returns false if there was no pregeneration running.",
+			},
 			TryGetHeight =
 			{
 				Params =
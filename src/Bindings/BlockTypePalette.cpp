@@ -145,6 +145,29 @@ std::map<UInt32, UInt32> BlockTypePalette::createTransformMapWithFallback(const
 
 
 
+std::vector<UInt32> BlockTypePalette::createTransformTableWithFallback(const BlockTypePalette & aFrom, UInt32 aFallbackIndex) const
+{
+	std::vector<UInt32> res;
+	if (aFrom.mNumberToBlock.empty())
+	{
+		return res;
+	}
+	res.resize(static_cast<size_t>(aFrom.mNumberToBlock.rbegin()->first) + 1, aFallbackIndex);
+	for (const auto & fromEntry: aFrom.mNumberToBlock)
+	{
+		auto thisIndex = maybeIndex(fromEntry.second.first, fromEntry.second.second);
+		if (thisIndex.second)
+		{
+			res[fromEntry.first] = thisIndex.first;
+		}
+	}
+	return res;
+}
+
+
+
+
+
 void BlockTypePalette::loadFromString(const AString & aString)
 {
 	static const AString hdrTsvRegular = "BlockTypePalette";
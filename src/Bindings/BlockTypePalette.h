@@ -94,6 +94,11 @@ public:
 	Used for protocol block type mapping. */
 	std::map<UInt32, UInt32> createTransformMapWithFallback(const BlockTypePalette & aFrom, UInt32 aFallbackIndex) const;
 
+	/** Returns a dense index-transform table from aFrom to this (this.entry(res[idx]) == aFrom.entry(idx)).
+	Same as createTransformMapWithFallback(), but as a flat array indexed by aFrom's index, for fast lookups.
+	Indices not present in aFrom, and entries not present in this, are assigned the fallback index. */
+	std::vector<UInt32> createTransformTableWithFallback(const BlockTypePalette & aFrom, UInt32 aFallbackIndex) const;
+
 	/** Loads the palette from the string representation.
 	Throws a LoadFailedException if the loading fails hard (bad string format);
 	but still a part of the data may already be loaded at that point.
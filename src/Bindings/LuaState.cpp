@@ -20,6 +20,7 @@ extern "C"
 #include "../Entities/Entity.h"
 #include "../BlockEntities/BlockEntity.h"
 #include "../DeadlockDetect.h"
+#include "../TickTrace.h"
 #include "../UUID.h"
 
 
@@ -1662,6 +1663,7 @@ bool cLuaState::CallFunction(int a_NumResults)
 	m_NumCurrentFunctionArgs = -1;
 
 	// Call the function:
+	cTickTrace::cScope Trace("Lua", CurrentFunctionName);
 	int s = lua_pcall(m_LuaState, NumArgs, a_NumResults, -NumArgs - 2);
 	if (s != 0)
 	{
@@ -11,6 +11,7 @@
 #include "LuaState.h"
 #include "PluginLua.h"
 #include "LuaChunkStay.h"
+#include "../Cuboid.h"
 
 #include "BlockEntities/BeaconEntity.h"
 #include "BlockEntities/BedEntity.h"
@@ -1224,6 +1225,60 @@ static int tolua_cWorld_GetBlockTypeMeta(lua_State * tolua_S)
 
 
 
+static int tolua_cWorld_GetBlocksInCuboid(lua_State * tolua_S)
+{
+	/* Function signature:
+	World:GetBlocksInCuboid(Cuboid) -> Blocks, AreAllChunksValid
+	Blocks == { BlockState1, BlockState2, ... }, a flat array indexed by 1 + X + Z * SizeX + Y * SizeX * SizeZ (relative to the cuboid's min corner)
+	Exported manually to avoid creating a Lua table per block.
+	*/
+
+	cLuaState L(tolua_S);
+	if (
+		!L.CheckParamSelf("cWorld") ||
+		!L.CheckParamUserType(2, "cCuboid") ||
+		!L.CheckParamEnd(3)
+	)
+	{
+		return 0;
+	}
+
+	cWorld * World;
+	cCuboid * Cuboid;
+	if (!L.GetStackValues(1, World, Cuboid))
+	{
+		return 0;
+	}
+	if (World == nullptr)
+	{
+		return cManualBindings::lua_do_error(tolua_S, "Error in function call '#funcname#': Invalid 'self'");
+	}
+	if (Cuboid == nullptr)
+	{
+		return L.ApiParamError("Invalid parameter #2, expected a cCuboid");
+	}
+
+	cCuboid Area(*Cuboid);
+	Area.Sort();
+	std::vector<BlockState> Blocks;
+	const bool AreAllChunksValid = World->GetBlocksInCuboid(Area, Blocks);
+
+	// Push the blocks as a single flat array of numbers:
+	lua_createtable(tolua_S, static_cast<int>(Blocks.size()), 0);
+	int Index = 1;
+	for (const auto Block : Blocks)
+	{
+		lua_pushnumber(tolua_S, static_cast<lua_Number>(Block.ID));
+		lua_rawseti(tolua_S, -2, Index++);
+	}
+	L.Push(AreAllChunksValid);
+	return 2;
+}
+
+
+
+
+
 static int tolua_cWorld_GetSignLines(lua_State * tolua_S)
 {
 	// Exported manually, because tolua would generate useless additional parameters (a_Line1 .. a_Line4)
@@ -1485,6 +1540,177 @@ static int tolua_cWorld_SetBlock(lua_State * tolua_S)
 
 
 
+static int tolua_cWorld_SetBlocks(lua_State * tolua_S)
+{
+	/* Function signature:
+	World:SetBlocks(Edits) -> NumBlocksSet
+	Edits == { X1, Y1, Z1, BlockState1, X2, Y2, Z2, BlockState2, ... }
+	Exported manually to avoid creating a Lua table per block; the whole batch is applied under a single chunkmap lock.
+	*/
+
+	cLuaState L(tolua_S);
+	if (
+		!L.CheckParamSelf("cWorld") ||
+		!L.CheckParamTable(2) ||
+		!L.CheckParamEnd(3)
+	)
+	{
+		return 0;
+	}
+
+	cWorld * World;
+	if (!L.GetStackValues(1, World))
+	{
+		return 0;
+	}
+	if (World == nullptr)
+	{
+		return cManualBindings::lua_do_error(tolua_S, "Error in function call '#funcname#': Invalid 'self'");
+	}
+
+	const auto NumValues = static_cast<int>(lua_objlen(tolua_S, 2));
+	if ((NumValues % 4) != 0)
+	{
+		return L.ApiParamError("Invalid parameter #2, expected a flat array of {X, Y, Z, BlockState} quadruplets");
+	}
+
+	sSetBlockVector Blocks;
+	Blocks.reserve(static_cast<size_t>(NumValues / 4));
+	for (int Index = 1; Index <= NumValues; Index += 4)
+	{
+		lua_rawgeti(tolua_S, 2, Index);
+		lua_rawgeti(tolua_S, 2, Index + 1);
+		lua_rawgeti(tolua_S, 2, Index + 2);
+		lua_rawgeti(tolua_S, 2, Index + 3);
+		if (!lua_isnumber(tolua_S, -4) || !lua_isnumber(tolua_S, -3) || !lua_isnumber(tolua_S, -2) || !lua_isnumber(tolua_S, -1))
+		{
+			lua_pop(tolua_S, 4);
+			return L.ApiParamError(fmt::format(FMT_STRING("Invalid parameter #2, element {} is not a number"), Index));
+		}
+		const Vector3i Position(
+			static_cast<int>(lua_tonumber(tolua_S, -4)),
+			static_cast<int>(lua_tonumber(tolua_S, -3)),
+			static_cast<int>(lua_tonumber(tolua_S, -2))
+		);
+		const BlockState Block(static_cast<BlockState::DataType>(lua_tonumber(tolua_S, -1)));
+		lua_pop(tolua_S, 4);
+
+		if (cChunkDef::IsValidHeight(Position))
+		{
+			Blocks.emplace_back(Position, Block);
+		}
+	}
+
+	L.Push(static_cast<UInt32>(World->SetBlocks(Blocks)));
+	return 1;
+}
+
+
+
+
+
+static int tolua_cWorld_SetBlocksInCuboid(lua_State * tolua_S)
+{
+	/* Function signature:
+	World:SetBlocksInCuboid(Cuboid, BlockState) -> NumBlocksSet
+	--or--
+	World:SetBlocksInCuboid(Cuboid, Blocks) -> NumBlocksSet
+	Blocks == { BlockState1, BlockState2, ... }, a flat array in the same order as returned by GetBlocksInCuboid()
+	*/
+
+	cLuaState L(tolua_S);
+	if (
+		!L.CheckParamSelf("cWorld") ||
+		!L.CheckParamUserType(2, "cCuboid") ||
+		!L.CheckParamEnd(4)
+	)
+	{
+		return 0;
+	}
+
+	cWorld * World;
+	cCuboid * Cuboid;
+	if (!L.GetStackValues(1, World, Cuboid))
+	{
+		return 0;
+	}
+	if (World == nullptr)
+	{
+		return cManualBindings::lua_do_error(tolua_S, "Error in function call '#funcname#': Invalid 'self'");
+	}
+	if (Cuboid == nullptr)
+	{
+		return L.ApiParamError("Invalid parameter #2, expected a cCuboid");
+	}
+
+	cCuboid Area(*Cuboid);
+	Area.Sort();
+	const int SizeX = Area.DifX() + 1;
+	const int SizeZ = Area.DifZ() + 1;
+
+	// Read the blocks, either a single one to fill the whole cuboid with, or one per position:
+	BlockState FillBlock;
+	const bool IsFill = L.IsParamNumber(3);
+	if (IsFill)
+	{
+		L.GetStackValue(3, FillBlock);
+	}
+	else if (!lua_istable(tolua_S, 3) || (static_cast<int>(lua_objlen(tolua_S, 3)) != Area.GetVolume()))
+	{
+		return L.ApiParamError("Invalid parameter #3, expected a BlockState or a flat array of BlockStates, one for each block in the cuboid");
+	}
+
+	// Queue the blocks chunk by chunk, so that SetBlocks() looks each chunk up only once:
+	const int MinY = std::max(Area.p1.y, 0);
+	const int MaxY = std::min(Area.p2.y, cChunkDef::Height - 1);
+	const auto MinChunk = cChunkDef::BlockToChunk(Area.p1);
+	const auto MaxChunk = cChunkDef::BlockToChunk(Area.p2);
+	sSetBlockVector Blocks;
+	Blocks.reserve(static_cast<size_t>(std::max(MaxY - MinY + 1, 0) * SizeX * SizeZ));
+	for (int ChunkZ = MinChunk.m_ChunkZ; ChunkZ <= MaxChunk.m_ChunkZ; ChunkZ++)
+	{
+		for (int ChunkX = MinChunk.m_ChunkX; ChunkX <= MaxChunk.m_ChunkX; ChunkX++)
+		{
+			const int BaseX = ChunkX * cChunkDef::Width;
+			const int BaseZ = ChunkZ * cChunkDef::Width;
+			const int MinX = std::max(Area.p1.x, BaseX);
+			const int MaxX = std::min(Area.p2.x, BaseX + cChunkDef::Width - 1);
+			const int MinZ = std::max(Area.p1.z, BaseZ);
+			const int MaxZ = std::min(Area.p2.z, BaseZ + cChunkDef::Width - 1);
+			for (int y = MinY; y <= MaxY; y++)
+			{
+				for (int z = MinZ; z <= MaxZ; z++)
+				{
+					for (int x = MinX; x <= MaxX; x++)
+					{
+						BlockState Block = FillBlock;
+						if (!IsFill)
+						{
+							const int Index = 1 + (x - Area.p1.x) + (z - Area.p1.z) * SizeX + (y - Area.p1.y) * SizeX * SizeZ;
+							lua_rawgeti(tolua_S, 3, Index);
+							if (!lua_isnumber(tolua_S, -1))
+							{
+								lua_pop(tolua_S, 1);
+								return L.ApiParamError(fmt::format(FMT_STRING("Invalid parameter #3, element {} is not a number"), Index));
+							}
+							Block = static_cast<BlockState::DataType>(lua_tonumber(tolua_S, -1));
+							lua_pop(tolua_S, 1);
+						}
+						Blocks.emplace_back(ChunkX, ChunkZ, x - BaseX, y, z - BaseZ, Block);
+					}
+				}
+			}
+		}  // for ChunkX
+	}  // for ChunkZ
+
+	L.Push(static_cast<UInt32>(World->SetBlocks(Blocks)));
+	return 1;
+}
+
+
+
+
+
 static int tolua_cWorld_SetSignLines(lua_State * tolua_S)
 {
 	// Exported manually, because tolua would generate useless additional return values (a_Line1 .. a_Line4)
@@ -1761,6 +1987,7 @@ void cManualBindings::BindWorld(lua_State * tolua_S)
 			tolua_function(tolua_S, "GetBlockMeta",                 tolua_cWorld_GetBlockMeta);
 			tolua_function(tolua_S, "GetBlockSkyLight",             tolua_cWorld_GetBlockSkyLight);
 			tolua_function(tolua_S, "GetBlockTypeMeta",             tolua_cWorld_GetBlockTypeMeta);
+			tolua_function(tolua_S, "GetBlocksInCuboid",            tolua_cWorld_GetBlocksInCuboid);
 			tolua_function(tolua_S, "GetHeight",                    tolua_cWorld_GetHeight);
 			tolua_function(tolua_S, "GetSignLines",                 tolua_cWorld_GetSignLines);
 			tolua_function(tolua_S, "GetTimeOfDay",                 tolua_cWorld_GetTimeOfDay);
@@ -1769,6 +1996,8 @@ void cManualBindings::BindWorld(lua_State * tolua_S)
 			tolua_function(tolua_S, "QueueTask",                    tolua_cWorld_QueueTask);
 			tolua_function(tolua_S, "ScheduleTask",                 tolua_cWorld_ScheduleTask);
 			tolua_function(tolua_S, "SetBlock",                     tolua_cWorld_SetBlock);
+			tolua_function(tolua_S, "SetBlocks",                    tolua_cWorld_SetBlocks);
+			tolua_function(tolua_S, "SetBlocksInCuboid",            tolua_cWorld_SetBlocksInCuboid);
 			tolua_function(tolua_S, "SetSignLines",                 tolua_cWorld_SetSignLines);
 			tolua_function(tolua_S, "SetTimeOfDay",                 tolua_cWorld_SetTimeOfDay);
 			tolua_function(tolua_S, "SpawnSplitExperienceOrbs",     tolua_cWorld_SpawnSplitExperienceOrbs);
@@ -10,6 +10,7 @@
 #include "../CommandOutput.h"
 
 #include "../IniFile.h"
+#include "../TickTrace.h"
 #include "../Entities/Player.h"
 #include "Commands/CommandArguments.h"
 #include "Commands/CommandManager.h"
@@ -246,6 +247,7 @@ bool cPluginManager::GenericCallHook(PluginHook a_HookName, HookFunction a_HookF
 		return false;
 	}
 
+	cTickTrace::cScope Trace("Hook", cPluginLua::GetHookFnName(a_HookName));
 	return std::any_of(Plugins->second.begin(), Plugins->second.end(), a_HookFunction);
 }
 
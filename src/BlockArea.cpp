@@ -35,7 +35,8 @@
 typedef void (CombinatorFunc)(BlockState & a_DstBlock, BlockState a_SrcBlock);
 
 /** Merges two blocktypes and blockmetas of the specified sizes and offsets using the specified combinator function
-This wild construct allows us to pass a function argument and still have it inlined by the compiler. */
+This wild construct allows us to pass a function argument and still have it inlined by the compiler.
+The innermost loop walks plain row pointers so that the branch-free combinators get auto-vectorized. */
 template <CombinatorFunc Combinator>
 void InternalMergeBlocks(
 	BlockState * a_DstBlocks, const BlockState * a_SrcBlocks,
@@ -56,13 +57,11 @@ void InternalMergeBlocks(
 		{
 			int SrcBaseZ = SrcBaseY + (z + a_SrcOffZ) * a_SrcSizeX;
 			int DstBaseZ = DstBaseY + (z + a_DstOffZ) * a_DstSizeX;
-			int SrcIdx = SrcBaseZ + a_SrcOffX;
-			int DstIdx = DstBaseZ + a_DstOffX;
+			BlockState * DstRow = a_DstBlocks + DstBaseZ + a_DstOffX;
+			const BlockState * SrcRow = a_SrcBlocks + SrcBaseZ + a_SrcOffX;
 			for (int x = 0; x < a_SizeX; x++)
 			{
-				Combinator(a_DstBlocks[DstIdx], a_SrcBlocks[SrcIdx]);
-				++DstIdx;
-				++SrcIdx;
+				Combinator(DstRow[x], SrcRow[x]);
 			}  // for x
 		}  // for z
 	}  // for y
@@ -72,10 +71,72 @@ void InternalMergeBlocks(
 
 
 
-/** Combinator used for cBlockArea::msOverwrite merging */
-static inline void MergeCombinatorOverwrite(BlockState & a_DstBlock, BlockState a_SrcBlock)
+/** Copies the blocks of the specified sizes and offsets, used for cBlockArea::msOverwrite merging.
+Copies whole rows at once, or whole layers if the rows are contiguous in both the areas. */
+static void InternalCopyBlocks(
+	BlockState * a_DstBlocks, const BlockState * a_SrcBlocks,
+	int a_SizeX, int a_SizeY, int a_SizeZ,
+	int a_SrcOffX, int a_SrcOffY, int a_SrcOffZ,
+	int a_DstOffX, int a_DstOffY, int a_DstOffZ,
+	int a_SrcSizeX, int a_SrcSizeZ,
+	int a_DstSizeX, int a_DstSizeZ
+)
+{
+	if ((a_SizeX <= 0) || (a_SizeZ <= 0))
+	{
+		return;
+	}
+
+	// If full-width rows are copied between areas of the same width, the rows of each layer form one contiguous run:
+	bool IsLayerContiguous = ((a_SizeX == a_SrcSizeX) && (a_SizeX == a_DstSizeX));
+	for (int y = 0; y < a_SizeY; y++)
+	{
+		int SrcBaseY = (y + a_SrcOffY) * a_SrcSizeX * a_SrcSizeZ;
+		int DstBaseY = (y + a_DstOffY) * a_DstSizeX * a_DstSizeZ;
+		if (IsLayerContiguous)
+		{
+			std::copy_n(
+				a_SrcBlocks + SrcBaseY + a_SrcOffZ * a_SrcSizeX,
+				static_cast<size_t>(a_SizeX * a_SizeZ),
+				a_DstBlocks + DstBaseY + a_DstOffZ * a_DstSizeX
+			);
+			continue;
+		}
+		for (int z = 0; z < a_SizeZ; z++)
+		{
+			std::copy_n(
+				a_SrcBlocks + SrcBaseY + (z + a_SrcOffZ) * a_SrcSizeX + a_SrcOffX,
+				static_cast<size_t>(a_SizeX),
+				a_DstBlocks + DstBaseY + (z + a_DstOffZ) * a_DstSizeX + a_DstOffX
+			);
+		}  // for z
+	}  // for y
+}
+
+
+
+
+
+/** Returns true if the block is any of the air blocks.
+Each of the air types has a single state, so this is a plain ID compare, without the BlockState -> BlockType lookup. */
+static inline bool IsAirState(BlockState a_Block)
+{
+	return (
+		(a_Block.ID == Block::Air::Air().ID) |
+		(a_Block.ID == Block::CaveAir::CaveAir().ID) |
+		(a_Block.ID == Block::VoidAir::VoidAir().ID)
+	);
+}
+
+
+
+
+
+/** Returns true if the two blocks are of the same BlockType.
+Only queries the types if the states differ, because same states always share the type. */
+static inline bool IsSameType(BlockState a_Block1, BlockState a_Block2)
 {
-	a_DstBlock = a_SrcBlock;
+	return (a_Block1 == a_Block2) || (a_Block1.Type() == a_Block2.Type());
 }
 
 
@@ -85,11 +146,8 @@ static inline void MergeCombinatorOverwrite(BlockState & a_DstBlock, BlockState
 /** Combinator used for cBlockArea::msFillAir merging */
 static inline void MergeCombinatorFillAir(BlockState & a_DstBlock, BlockState a_SrcBlock)
 {
-	if (cBlockAirHandler::IsBlockAir(a_DstBlock))
-	{
-		a_DstBlock = a_SrcBlock;
-	}
 	// "else" is the default, already in place
+	a_DstBlock = IsAirState(a_DstBlock) ? a_SrcBlock : a_DstBlock;
 }
 
 
@@ -99,11 +157,8 @@ static inline void MergeCombinatorFillAir(BlockState & a_DstBlock, BlockState a_
 /** Combinator used for cBlockArea::msImprint merging */
 static inline void MergeCombinatorImprint(BlockState & a_DstBlock, BlockState a_SrcBlock)
 {
-	if (!cBlockAirHandler::IsBlockAir(a_SrcBlock))
-	{
-		a_DstBlock = a_SrcBlock;
-	}
 	// "else" is the default, already in place
+	a_DstBlock = IsAirState(a_SrcBlock) ? a_DstBlock : a_SrcBlock;
 }
 
 
@@ -114,13 +169,13 @@ static inline void MergeCombinatorImprint(BlockState & a_DstBlock, BlockState a_
 static inline void MergeCombinatorLake(BlockState & a_DstBlock, BlockState a_SrcBlock)
 {
 	// Sponge is the NOP block
-	if (a_SrcBlock.Type() == BlockType::Sponge)
+	if (a_SrcBlock == Block::Sponge::Sponge())
 	{
 		return;
 	}
 
 	// Air is always hollowed out
-	if (cBlockAirHandler::IsBlockAir(a_SrcBlock))
+	if (IsAirState(a_SrcBlock))
 	{
 		a_DstBlock = Block::Air::Air();
 		return;
@@ -149,7 +204,7 @@ static inline void MergeCombinatorLake(BlockState & a_DstBlock, BlockState a_Src
 		default: break;
 	}
 
-	if (a_SrcBlock.Type() == BlockType::Stone)
+	if (a_SrcBlock == Block::Stone::Stone())
 	{
 		switch (a_DstBlock.Type())
 		{
@@ -157,7 +212,7 @@ static inline void MergeCombinatorLake(BlockState & a_DstBlock, BlockState a_Src
 			case BlockType::ShortGrass:
 			case BlockType::Mycelium:
 			{
-				a_DstBlock = BlockType::Stone;
+				a_DstBlock = Block::Stone::Stone();
 				return;
 			}
 			default: break;
@@ -174,10 +229,7 @@ static inline void MergeCombinatorLake(BlockState & a_DstBlock, BlockState a_Src
 static inline void MergeCombinatorSpongePrint(BlockState & a_DstBlock, BlockState a_SrcBlock)
 {
 	// Sponge overwrites nothing, everything else overwrites anything
-	if (a_SrcBlock != BlockType::Sponge)
-	{
-		a_DstBlock = a_SrcBlock;
-	}
+	a_DstBlock = (a_SrcBlock == Block::Sponge::Sponge()) ? a_DstBlock : a_SrcBlock;
 }
 
 
@@ -187,9 +239,9 @@ static inline void MergeCombinatorSpongePrint(BlockState & a_DstBlock, BlockStat
 /** Combinator used for cBlockArea::msDifference merging */
 static inline void MergeCombinatorDifference(BlockState & a_DstBlock, BlockState a_SrcBlock)
 {
-	if (a_DstBlock.Type() == a_SrcBlock.Type())
+	if (IsSameType(a_DstBlock, a_SrcBlock))
 	{
-		a_DstBlock = BlockType::Air;
+		a_DstBlock = Block::Air::Air();
 	}
 	else
 	{
@@ -204,16 +256,8 @@ static inline void MergeCombinatorDifference(BlockState & a_DstBlock, BlockState
 /** Combinator used for cBlockArea::msSimpleCompare merging */
 static inline void MergeCombinatorSimpleCompare(BlockState & a_DstBlock, BlockState a_SrcBlock)
 {
-	if (a_DstBlock == a_SrcBlock)
-	{
-		// The blocktypes are the same, and the blockmetas are not present or are the same
-		a_DstBlock = Block::Air::Air();
-	}
-	else
-	{
-		// The blocktypes or blockmetas differ
-		a_DstBlock = Block::Stone::Stone();
-	}
+	// Same blocks turn into air, differing blocks into stone
+	a_DstBlock = (a_DstBlock == a_SrcBlock) ? Block::Air::Air() : Block::Stone::Stone();
 }
 
 
@@ -224,12 +268,45 @@ static inline void MergeCombinatorSimpleCompare(BlockState & a_DstBlock, BlockSt
 static inline void MergeCombinatorMask(BlockState & a_DstBlock, BlockState a_SrcBlock)
 {
 	// If the blocks are the same, keep the dest; otherwise replace with air
-	if (a_SrcBlock.Type() != a_DstBlock.Type())
+	if (!IsSameType(a_SrcBlock, a_DstBlock))
 	{
-		a_DstBlock = BlockType::Air;
+		a_DstBlock = Block::Air::Air();
 	}
 }
 
+
+
+
+
+/** Rotates the blocks around the Y axis, a_Src is of a_Size, a_Dst receives the rotated blocks of size {a_Size.z, a_Size.y, a_Size.x}.
+The source is walked in its memory order and the destination index is advanced by a constant stride,
+instead of recomputing both indices for each block. */
+template <bool Clockwise>
+static void InternalRotateBlocks(const BlockState * a_Src, BlockState * a_Dst, Vector3i a_Size)
+{
+	// Destination index of the rotated {x, y, z} is NewX + NewZ * SizeZ + y * SizeX * SizeZ, where
+	//   CW:  NewX = SizeZ - z - 1, NewZ = x
+	//   CCW: NewX = z,             NewZ = SizeX - x - 1
+	const ptrdiff_t LayerSize = static_cast<ptrdiff_t>(a_Size.x) * a_Size.z;
+	const ptrdiff_t StepX = Clockwise ? a_Size.z : -a_Size.z;
+	const ptrdiff_t StepZ = Clockwise ? -1 : 1;
+	const ptrdiff_t Start = Clockwise ? (a_Size.z - 1) : (a_Size.x - 1) * static_cast<ptrdiff_t>(a_Size.z);
+	for (int y = 0; y < a_Size.y; y++)
+	{
+		BlockState * DstLayer = a_Dst + y * LayerSize + Start;
+		for (int z = 0; z < a_Size.z; z++)
+		{
+			BlockState * Dst = DstLayer + z * StepZ;
+			for (int x = 0; x < a_Size.x; x++)
+			{
+				*Dst = *a_Src;
+				++a_Src;
+				Dst += StepX;
+			}  // for x
+		}  // for z
+	}  // for y
+}
+
 // Re-enable previously disabled MSVC warnings
 #ifdef _MSC_VER
 	#pragma warning(pop)
@@ -669,24 +746,15 @@ void cBlockArea::Fill(int a_DataTypes, BlockState a_Block, LIGHTTYPE a_BlockLigh
 	size_t BlockCount = GetBlockCount();
 	if ((a_DataTypes & baBlocks) != 0)
 	{
-		for (size_t i = 0; i < BlockCount; i++)
-		{
-			m_Blocks[i] = a_Block;
-		}
+		std::fill_n(m_Blocks.get(), BlockCount, a_Block);
 	}
 	if ((a_DataTypes & baLight) != 0)
 	{
-		for (size_t i = 0; i < BlockCount; i++)
-		{
-			m_BlockLight[i] = a_BlockLight;
-		}
+		std::fill_n(m_BlockLight.get(), BlockCount, a_BlockLight);
 	}
 	if ((a_DataTypes & baSkyLight) != 0)
 	{
-		for (size_t i = 0; i < BlockCount; i++)
-		{
-			m_BlockSkyLight[i] = a_BlockSkyLight;
-		}
+		std::fill_n(m_BlockSkyLight.get(), BlockCount, a_BlockSkyLight);
 	}
 
 	// If the area contains block entities, remove those not matching and replace with whatever block entity block was filled
@@ -720,26 +788,26 @@ void cBlockArea::FillRelCuboid(int a_MinRelX, int a_MaxRelX, int a_MinRelY, int
 		a_DataTypes = a_DataTypes & GetDataTypes();
 	}
 
-	if ((a_DataTypes & baBlocks) != 0)
-	{
-		for (int y = a_MinRelY; y <= a_MaxRelY; y++) for (int z = a_MinRelZ; z <= a_MaxRelZ; z++) for (int x = a_MinRelX; x <= a_MaxRelX; x++)
-		{
-			m_Blocks[MakeIndex(x, y, z)] = a_Block;
-		}  // for x, z, y
-	}
-	if ((a_DataTypes & baLight) != 0)
+	// Fill one X row at a time, the rows are contiguous in memory:
+	if (a_MaxRelX >= a_MinRelX)
 	{
-		for (int y = a_MinRelY; y <= a_MaxRelY; y++) for (int z = a_MinRelZ; z <= a_MaxRelZ; z++) for (int x = a_MinRelX; x <= a_MaxRelX; x++)
+		auto RowLength = static_cast<size_t>(a_MaxRelX - a_MinRelX + 1);
+		for (int y = a_MinRelY; y <= a_MaxRelY; y++) for (int z = a_MinRelZ; z <= a_MaxRelZ; z++)
 		{
-			m_BlockLight[MakeIndex(x, y, z)] = a_BlockLight;
-		}  // for x, z, y
-	}
-	if ((a_DataTypes & baSkyLight) != 0)
-	{
-		for (int y = a_MinRelY; y <= a_MaxRelY; y++) for (int z = a_MinRelZ; z <= a_MaxRelZ; z++) for (int x = a_MinRelX; x <= a_MaxRelX; x++)
-		{
-			m_BlockSkyLight[MakeIndex(x, y, z)] = a_BlockSkyLight;
-		}  // for x, z, y
+			auto RowStart = MakeIndex(a_MinRelX, y, z);
+			if ((a_DataTypes & baBlocks) != 0)
+			{
+				std::fill_n(m_Blocks.get() + RowStart, RowLength, a_Block);
+			}
+			if ((a_DataTypes & baLight) != 0)
+			{
+				std::fill_n(m_BlockLight.get() + RowStart, RowLength, a_BlockLight);
+			}
+			if ((a_DataTypes & baSkyLight) != 0)
+			{
+				std::fill_n(m_BlockSkyLight.get() + RowStart, RowLength, a_BlockSkyLight);
+			}
+		}  // for z, y
 	}
 
 	// If the area contains block entities, remove those in the affected cuboid and replace with whatever block entity block was filled:
@@ -920,20 +988,7 @@ void cBlockArea::RotateCCW(void)
 
 	// We are guaranteed that both blocktypes and blockmetas exist; rotate both at the same time:
 	BLOCKARRAY NewBlocks{ new BlockState[GetBlockCount()] };
-	for (int x = 0; x < m_Size.x; x++)
-	{
-		int NewZ = m_Size.x - x - 1;
-		for (int z = 0; z < m_Size.z; z++)
-		{
-			int NewX = z;
-			for (int y = 0; y < m_Size.y; y++)
-			{
-				auto NewIdx = MakeIndexForSize({ NewX, y, NewZ }, { m_Size.z, m_Size.y, m_Size.x });
-				auto OldIdx = MakeIndex(x, y, z);
-				NewBlocks[NewIdx] = m_Blocks[OldIdx];
-			}  // for y
-		}  // for z
-	}  // for x
+	InternalRotateBlocks<false>(m_Blocks.get(), NewBlocks.get(), m_Size);
 	m_Blocks = std::move(NewBlocks);
 
 	// Rotate the BlockEntities:
@@ -970,20 +1025,7 @@ void cBlockArea::RotateCW(void)
 
 	// We are guaranteed that both blocktypes and blockmetas exist; rotate both at the same time:
 	BLOCKARRAY NewBlocks{ new BlockState[GetBlockCount()] };
-	for (int x = 0; x < m_Size.x; x++)
-	{
-		int NewZ = x;
-		for (int z = 0; z < m_Size.z; z++)
-		{
-			int NewX = m_Size.z - z - 1;
-			for (int y = 0; y < m_Size.y; y++)
-			{
-				auto NewIdx = MakeIndexForSize({ NewX, y, NewZ }, { m_Size.z, m_Size.y, m_Size.x });
-				auto OldIdx = MakeIndex(x, y, z);
-				NewBlocks[NewIdx] = m_Blocks[OldIdx];
-			}  // for y
-		}  // for z
-	}  // for x
+	InternalRotateBlocks<true>(m_Blocks.get(), NewBlocks.get(), m_Size);
 	m_Blocks = std::move(NewBlocks);
 
 	// Rotate the BlockEntities:
@@ -1025,14 +1067,14 @@ void cBlockArea::MirrorXY(void)
 	{
 		for (int z = 0; z < HalfZ; z++)
 		{
+			auto Row1 = m_Blocks.get() + MakeIndex(0, y, z);
+			auto Row2 = m_Blocks.get() + MakeIndex(0, y, MaxZ - z);
 			for (int x = 0; x < m_Size.x; x++)
 			{
-				auto Idx1 = MakeIndex(x, y, z);
-				auto Idx2 = MakeIndex(x, y, MaxZ - z);
-				auto Block2 = cBlockHandler::For(m_Blocks[Idx2].Type()).MirrorXY(m_Blocks[Idx2]);
-				auto Block1 = cBlockHandler::For(m_Blocks[Idx1].Type()).MirrorXY(m_Blocks[Idx1]);
-				m_Blocks[Idx1] = Block2;
-				m_Blocks[Idx2] = Block1;
+				auto Block2 = cBlockHandler::For(Row2[x].Type()).MirrorXY(Row2[x]);
+				auto Block1 = cBlockHandler::For(Row1[x].Type()).MirrorXY(Row1[x]);
+				Row1[x] = Block2;
+				Row2[x] = Block1;
 			}  // for x
 		}  // for z
 	}  // for y
@@ -1074,14 +1116,14 @@ void cBlockArea::MirrorXZ(void)
 	{
 		for (int z = 0; z < m_Size.z; z++)
 		{
+			auto Row1 = m_Blocks.get() + MakeIndex(0, y, z);
+			auto Row2 = m_Blocks.get() + MakeIndex(0, MaxY - y, z);
 			for (int x = 0; x < m_Size.x; x++)
 			{
-				auto Idx1 = MakeIndex(x, y, z);
-				auto Idx2 = MakeIndex(x, MaxY - y, z);
-				auto Block2 = cBlockHandler::For(m_Blocks[Idx2].Type()).MirrorXZ(m_Blocks[Idx2]);
-				auto Block1 = cBlockHandler::For(m_Blocks[Idx1].Type()).MirrorXZ(m_Blocks[Idx1]);
-				m_Blocks[Idx1] = Block2;
-				m_Blocks[Idx2] = Block1;
+				auto Block2 = cBlockHandler::For(Row2[x].Type()).MirrorXZ(Row2[x]);
+				auto Block1 = cBlockHandler::For(Row1[x].Type()).MirrorXZ(Row1[x]);
+				Row1[x] = Block2;
+				Row2[x] = Block1;
 			}  // for x
 		}  // for z
 	}  // for y
@@ -1123,14 +1165,13 @@ void cBlockArea::MirrorYZ(void)
 	{
 		for (int z = 0; z < m_Size.z; z++)
 		{
+			auto Row = m_Blocks.get() + MakeIndex(0, y, z);
 			for (int x = 0; x < HalfX; x++)
 			{
-				auto Idx1 = MakeIndex(x, y, z);
-				auto Idx2 = MakeIndex(MaxX - x, y, z);
-				auto Block2 = cBlockHandler::For(m_Blocks[Idx2].Type()).MirrorXZ(m_Blocks[Idx2]);
-				auto Block1 = cBlockHandler::For(m_Blocks[Idx1].Type()).MirrorXZ(m_Blocks[Idx1]);
-				m_Blocks[Idx1] = Block2;
-				m_Blocks[Idx2] = Block1;
+				auto Block2 = cBlockHandler::For(Row[MaxX - x].Type()).MirrorXZ(Row[MaxX - x]);
+				auto Block1 = cBlockHandler::For(Row[x].Type()).MirrorXZ(Row[x]);
+				Row[x] = Block2;
+				Row[MaxX - x] = Block1;
 			}  // for x
 		}  // for z
 	}  // for y
@@ -1806,13 +1847,13 @@ void cBlockArea::MergeByStrategy(const cBlockArea & a_Src, Vector3i a_RelPos, eM
 		{
 			case cBlockArea::msOverwrite:
 			{
-				InternalMergeBlocks<MergeCombinatorOverwrite>(
+				InternalCopyBlocks(
 					GetBlocks(), a_Src.GetBlocks(),
 					SizeX, SizeY, SizeZ,
 					SrcOffX, SrcOffY, SrcOffZ,
 					DstOffX, DstOffY, DstOffZ,
-					a_Src.GetSizeX(), a_Src.GetSizeY(), a_Src.GetSizeZ(),
-					m_Size.x, m_Size.y, m_Size.z
+					a_Src.GetSizeX(), a_Src.GetSizeZ(),
+					m_Size.x, m_Size.z
 				);
 				return;
 			}  // case msOverwrite
@@ -1939,8 +1980,16 @@ void cBlockArea::MergeBlockEntities(Vector3i a_RelPos, const cBlockArea & a_Src)
 	// Remove block entities that no longer match the block at their coords:
 	RemoveNonMatchingBlockEntities();
 
+	// Only the blocks covered by a_Src may have changed, the rest already has its BEs:
+	const Vector3i Min(std::max(0, a_RelPos.x), std::max(0, a_RelPos.y), std::max(0, a_RelPos.z));
+	const Vector3i Max(
+		std::min(m_Size.x, a_RelPos.x + a_Src.m_Size.x),
+		std::min(m_Size.y, a_RelPos.y + a_Src.m_Size.y),
+		std::min(m_Size.z, a_RelPos.z + a_Src.m_Size.z)
+	);
+
 	// Clone BEs from a_Src wherever a BE is missing:
-	for (int y = 0; y < m_Size.y; ++y) for (int z = 0; z < m_Size.z; ++z) for (int x = 0; x < m_Size.x; ++x)
+	for (int y = Min.y; y < Max.y; ++y) for (int z = Min.z; z < Max.z; ++z) for (int x = Min.x; x < Max.x; ++x)
 	{
 		auto idx = MakeIndex(x, y, z);
 		auto Block = m_Blocks[idx];
@@ -1958,18 +2007,12 @@ void cBlockArea::MergeBlockEntities(Vector3i a_RelPos, const cBlockArea & a_Src)
 		}
 
 		// Copy a BE from a_Src, if it exists there:
-		auto srcX = x + a_RelPos.x;
-		auto srcY = y + a_RelPos.y;
-		auto srcZ = z + a_RelPos.z;
-		if (a_Src.IsValidRelCoords({srcX, srcY, srcZ}))
+		auto srcIdx = a_Src.MakeIndex(x - a_RelPos.x, y - a_RelPos.y, z - a_RelPos.z);
+		auto itrSrc = a_Src.m_BlockEntities->find(srcIdx);
+		if (itrSrc != a_Src.m_BlockEntities->end())
 		{
-			auto srcIdx = a_Src.MakeIndex(srcX, srcY, srcZ);
-			auto itrSrc = a_Src.m_BlockEntities->find(srcIdx);
-			if (itrSrc != a_Src.m_BlockEntities->end())
-			{
-				m_BlockEntities->emplace(idx, itrSrc->second->Clone({x, y, z}));
-				continue;
-			}
+			m_BlockEntities->emplace(idx, itrSrc->second->Clone({x, y, z}));
+			continue;
 		}
 		// No BE found in a_Src, insert a new empty one:
 		m_BlockEntities->emplace(idx, cBlockEntity::CreateByBlockType(Block, {x, y, z}));
@@ -2122,23 +2165,27 @@ void cBlockArea::cChunkReader::ChunkData(const ChunkBlockData & a_BlockData, con
 		SizeZ -= (m_CurrentChunkZ + 1) * cChunkDef::Width - (m_Origin.z + m_Area.m_Size.z);
 	}
 
-	// Copy the blocktypes:
-	if (m_Area.m_Blocks != nullptr)
+	// Copy the blocktypes, a whole X row at a time straight from the section storage:
+	if ((m_Area.m_Blocks != nullptr) && (SizeX > 0))
 	{
 		for (int y = 0; y < SizeY; y++)
 		{
 			int InChunkY = MinY + y;
 			int AreaY = y;
+			const auto Section = a_BlockData.GetSection(static_cast<size_t>(InChunkY / cChunkDef::SectionHeight));
 			for (int z = 0; z < SizeZ; z++)
 			{
 				int InChunkZ = BaseZ + z;
 				int AreaZ = OffZ + z;
-				for (int x = 0; x < SizeX; x++)
+				auto AreaRow = m_Area.m_Blocks.get() + m_Area.MakeIndex(OffX, AreaY, AreaZ);
+				if (Section == nullptr)
 				{
-					int InChunkX = BaseX + x;
-					int AreaX = OffX + x;
-					m_Area.m_Blocks[m_Area.MakeIndex(AreaX, AreaY, AreaZ)] = a_BlockData.GetBlock({ InChunkX, InChunkY, InChunkZ });
-				}  // for x
+					// Unallocated sections are all air:
+					std::fill_n(AreaRow, SizeX, ChunkBlockData::DefaultValue);
+					continue;
+				}
+				auto SectionRow = Section->data() + cChunkDef::MakeIndex(BaseX, InChunkY % cChunkDef::SectionHeight, InChunkZ);
+				std::copy_n(SectionRow, SizeX, AreaRow);
 			}  // for z
 		}  // for y
 	}
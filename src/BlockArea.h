@@ -479,7 +479,8 @@ protected:
 	void MergeByStrategy(const cBlockArea & a_Src, Vector3i a_RelPos, eMergeStrategy a_Strategy);
 
 	/** Updates m_BlockEntities to remove BEs that no longer match the blocktype at their coords, and clones from a_Src the BEs that are missing.
-	a_RelX, a_RelY and a_RelZ are relative coords that should be added to all BEs from a_Src before checking them.
+	a_RelPos is the relative coords that should be added to all BEs from a_Src before checking them.
+	Only the blocks covered by a_Src are checked for missing BEs, the rest of the area is expected to be consistent already.
 	If a block should have a BE but one cannot be found in either this or a_Src, a new one is created. */
 	void MergeBlockEntities(Vector3i a_RelPos, const cBlockArea & a_Src);
 
@@ -29,10 +29,10 @@ public:
 	cBannerEntity(BlockState a_Block, Vector3i a_Pos, cWorld * a_World, unsigned char a_BaseColor);
 
 	unsigned char GetBaseColor() const { return m_BaseColor; }
-	void SetBaseColor(unsigned char a_Color) { m_BaseColor = a_Color; }
+	void SetBaseColor(unsigned char a_Color) { m_BaseColor = a_Color; MarkChunkDirty(); }
 
 	const AString & GetCustomName() const { return m_CustomName; }
-	void SetCustomName(const AString & a_CustomName) { m_CustomName = a_CustomName; }
+	void SetCustomName(const AString & a_CustomName) { m_CustomName = a_CustomName; MarkChunkDirty(); }
 
 private:
 
@@ -98,10 +98,12 @@ bool cBeaconEntity::SetPrimaryEffect(cEntityEffect::eType a_Effect)
 	if (!IsValidEffect(a_Effect, m_BeaconLevel))
 	{
 		m_PrimaryEffect = cEntityEffect::effNoEffect;
+		MarkChunkDirty();
 		return false;
 	}
 
 	m_PrimaryEffect = a_Effect;
+	MarkChunkDirty();
 
 	// Send window update:
 	if (GetWindow() != nullptr)
@@ -120,10 +122,12 @@ bool cBeaconEntity::SetSecondaryEffect(cEntityEffect::eType a_Effect)
 	if (!IsValidEffect(a_Effect, m_BeaconLevel))
 	{
 		m_SecondaryEffect = cEntityEffect::effNoEffect;
+		MarkChunkDirty();
 		return false;
 	}
 
 	m_SecondaryEffect = a_Effect;
+	MarkChunkDirty();
 
 	// Send window update:
 	if (GetWindow() != nullptr)
@@ -186,6 +190,11 @@ void cBeaconEntity::UpdateBeacon(void)
 		m_IsActive = (m_BeaconLevel > 0);
 	}
 
+	if (m_BeaconLevel != OldBeaconLevel)
+	{
+		MarkChunkDirty();
+	}
+
 	if ((m_BeaconLevel != OldBeaconLevel) && (m_BeaconLevel == 4))
 	{
 		// Send window update:
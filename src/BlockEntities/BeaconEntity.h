@@ -35,7 +35,7 @@ public:  // tolua_export
 	virtual bool UsedBy(cPlayer * a_Player) override;
 
 	/** Modify the beacon level. (It is needed to load the beacon corectly) */
-	void SetBeaconLevel(char a_Level) { m_BeaconLevel = a_Level; }
+	void SetBeaconLevel(char a_Level) { m_BeaconLevel = a_Level; MarkChunkDirty(); }
 
 	// tolua_begin
 
@@ -57,6 +57,7 @@ void cBedEntity::SendTo(cClientHandle & a_Client)
 void cBedEntity::SetColor(short a_Color)
 {
 	m_Color = a_Color;
+	MarkChunkDirty();
 }
 
 
@@ -24,6 +24,7 @@
 #include "JukeboxEntity.h"
 #include "NoteEntity.h"
 #include "SignEntity.h"
+#include "../World.h"
 
 
 
@@ -356,6 +357,18 @@ void cBlockEntity::SetWorld(cWorld * const a_World)
 
 
 
+void cBlockEntity::MarkChunkDirty(void)
+{
+	if (m_World != nullptr)
+	{
+		m_World->MarkChunkDirty(GetChunkX(), GetChunkZ());
+	}
+}
+
+
+
+
+
 bool cBlockEntity::Tick(const std::chrono::milliseconds a_Dt, cChunk & a_Chunk)
 {
 	UNUSED(a_Dt);
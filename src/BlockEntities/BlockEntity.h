@@ -77,6 +77,10 @@ public:
 
 	void SetWorld(cWorld * a_World);
 
+	/** Marks the chunk containing this block entity as changed, so that it gets saved and its cached packets are serialized anew.
+	To be called after any change of the data that is saved or sent to the clients. Does nothing if not in a world. */
+	void MarkChunkDirty(void);
+
 	/** Ticks the entity; returns true if the chunk should be marked as dirty as a result of this ticking. By default does nothing. */
 	virtual bool Tick(std::chrono::milliseconds a_Dt, cChunk & a_Chunk);
 
@@ -62,7 +62,7 @@ void cBlockEntityWithItems::OnSlotChanged(cItemGrid * a_Grid, int a_SlotNum)
 		GetWindow()->BroadcastWholeWindow();
 	}
 
-	m_World->MarkChunkDirty(GetChunkX(), GetChunkZ());
+	MarkChunkDirty();
 
 	// Notify comparators:
 	m_World->WakeUpSimulators(m_Pos);
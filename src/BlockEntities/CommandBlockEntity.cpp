@@ -43,6 +43,7 @@ bool cCommandBlockEntity::UsedBy(cPlayer * a_Player)
 void cCommandBlockEntity::SetCommand(const AString & a_Cmd)
 {
 	m_Command = a_Cmd;
+	MarkChunkDirty();
 }
 
 
@@ -52,6 +53,7 @@ void cCommandBlockEntity::SetCommand(const AString & a_Cmd)
 void cCommandBlockEntity::SetLastOutput(const AString & a_LastOut)
 {
 	m_LastOutput = a_LastOut;
+	MarkChunkDirty();
 }
 
 
@@ -61,6 +63,7 @@ void cCommandBlockEntity::SetLastOutput(const AString & a_LastOut)
 void cCommandBlockEntity::SetResult(const unsigned char a_Result)
 {
 	m_Result = a_Result;
+	MarkChunkDirty();
 }
 
 
@@ -201,7 +204,7 @@ void cCommandBlockEntity::Execute()
 	}
 
 	// TODO 2014-01-18 xdot: Update the signal strength.
-	m_Result = 0;
+	SetResult(0);
 }
 
 
@@ -17,7 +17,7 @@ public:
 	cEnchantingTableEntity(BlockState a_Block, Vector3i a_Pos, cWorld * a_World, AString a_CustomName = "");
 
 	const AString & GetCustomName() const { return m_CustomName; }
-	void SetCustomName(const AString & a_CustomName) { m_CustomName = a_CustomName; }
+	void SetCustomName(const AString & a_CustomName) { m_CustomName = a_CustomName; MarkChunkDirty(); }
 
 private:
 
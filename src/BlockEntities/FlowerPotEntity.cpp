@@ -56,7 +56,7 @@ bool cFlowerPotEntity::UsedBy(cPlayer * a_Player)
 	cItem SelectedItem = a_Player->GetInventory().GetEquippedItem();
 	if (IsFlower(SelectedItem.m_ItemType))
 	{
-		m_Item = SelectedItem.CopyOne();
+		SetItem(SelectedItem.CopyOne());
 		if (!a_Player->IsGameModeCreative())
 		{
 			a_Player->GetInventory().RemoveOneEquippedItem();
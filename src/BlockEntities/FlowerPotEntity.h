@@ -38,7 +38,7 @@ public:  // tolua_export
 	cItem GetItem(void) const { return m_Item; }
 
 	/** Set the item in the flower pot */
-	void SetItem(const cItem & a_Item) { m_Item = a_Item; }
+	void SetItem(const cItem & a_Item) { m_Item = a_Item; MarkChunkDirty(); }
 
 	// tolua_end
 
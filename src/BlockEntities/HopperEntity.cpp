@@ -40,6 +40,7 @@ cHopperEntity::cHopperEntity(BlockState a_Block, Vector3i a_Pos, cWorld * a_Worl
 void cHopperEntity::SetLocked(bool a_Value)
 {
 	m_Locked = a_Value;
+	MarkChunkDirty();
 }
 
 
@@ -98,6 +98,7 @@ bool cJukeboxEntity::PlayRecord(Item a_Record)
 	}
 
 	m_Record = a_Record;
+	MarkChunkDirty();
 	int record_id = 0;
 	switch (a_Record)
 	{
@@ -144,6 +145,7 @@ bool cJukeboxEntity::EjectRecord(void)
 	m_World->BroadcastSoundParticleEffect(EffectID::SFX_RANDOM_PLAY_MUSIC_DISC, GetPos(), 0);
 
 	m_Record = Item::Air;
+	MarkChunkDirty();
 	return true;
 }
 
@@ -172,4 +174,5 @@ Item cJukeboxEntity::GetRecord(void)
 void cJukeboxEntity::SetRecord(Item a_Record)
 {
 	m_Record = a_Record;
+	MarkChunkDirty();
 }
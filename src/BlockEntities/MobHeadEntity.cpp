@@ -34,6 +34,7 @@ void cMobHeadEntity::SetType(const Item & a_Type)
 		m_OwnerUUID = cUUID{};
 	}
 	m_Type = a_Type;
+	MarkChunkDirty();
 }
 
 
@@ -43,6 +44,7 @@ void cMobHeadEntity::SetType(const Item & a_Type)
 void cMobHeadEntity::SetRotation(eMobHeadRotation a_Rotation)
 {
 	m_Rotation = a_Rotation;
+	MarkChunkDirty();
 }
 
 
@@ -69,6 +71,7 @@ void cMobHeadEntity::SetOwner(const cPlayer & a_Owner)
 			break;
 		}
 	}
+	MarkChunkDirty();
 }
 
 
@@ -86,6 +89,7 @@ void cMobHeadEntity::SetOwner(const cUUID & a_OwnerUUID, const AString & a_Owner
 	m_OwnerName = a_OwnerName;
 	m_OwnerTexture = a_OwnerTexture;
 	m_OwnerTextureSignature = a_OwnerTextureSignature;
+	MarkChunkDirty();
 }
 
 
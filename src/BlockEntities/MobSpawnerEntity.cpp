@@ -95,6 +95,7 @@ bool cMobSpawnerEntity::UsedBy(cPlayer * a_Player)
 
 			m_Entity = MonsterType;
 			ResetTimer();
+			MarkChunkDirty();
 			if (!a_Player->IsGameModeCreative())
 			{
 				a_Player->GetInventory().RemoveOneEquippedItem();
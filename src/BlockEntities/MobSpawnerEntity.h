@@ -58,14 +58,14 @@ public:  // tolua_export
 	short GetRequiredPlayerRange(void) const { return m_RequiredPlayerRange; }
 
 	// Setters
-	void SetEntity(eEntityType a_EntityType)                { m_Entity = a_EntityType; }
-	void SetSpawnDelay(short a_Delay)                        { m_SpawnDelay = a_Delay; }
-	void SetSpawnCount(short a_SpawnCount)                   { m_SpawnCount = a_SpawnCount; }
-	void SetSpawnRange(short a_SpawnRange)                   { m_SpawnRange = a_SpawnRange; }
-	void SetMinSpawnDelay(short a_Min)                       { m_MinSpawnDelay = a_Min; }
-	void SetMaxSpawnDelay(short a_Max)                       { m_MaxSpawnDelay = a_Max; }
-	void SetMaxNearbyEntities(short a_MaxNearbyEntities)     { m_MaxNearbyEntities = a_MaxNearbyEntities; }
-	void SetRequiredPlayerRange(short a_RequiredPlayerRange) { m_RequiredPlayerRange = a_RequiredPlayerRange; }
+	void SetEntity(eEntityType a_EntityType)                { m_Entity = a_EntityType; MarkChunkDirty(); }
+	void SetSpawnDelay(short a_Delay)                        { m_SpawnDelay = a_Delay; MarkChunkDirty(); }
+	void SetSpawnCount(short a_SpawnCount)                   { m_SpawnCount = a_SpawnCount; MarkChunkDirty(); }
+	void SetSpawnRange(short a_SpawnRange)                   { m_SpawnRange = a_SpawnRange; MarkChunkDirty(); }
+	void SetMinSpawnDelay(short a_Min)                       { m_MinSpawnDelay = a_Min; MarkChunkDirty(); }
+	void SetMaxSpawnDelay(short a_Max)                       { m_MaxSpawnDelay = a_Max; MarkChunkDirty(); }
+	void SetMaxNearbyEntities(short a_MaxNearbyEntities)     { m_MaxNearbyEntities = a_MaxNearbyEntities; MarkChunkDirty(); }
+	void SetRequiredPlayerRange(short a_RequiredPlayerRange) { m_RequiredPlayerRange = a_RequiredPlayerRange; MarkChunkDirty(); }
 
 	// tolua_end
 
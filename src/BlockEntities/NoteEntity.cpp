@@ -373,6 +373,7 @@ unsigned char cNoteEntity::GetNote(void)
 void cNoteEntity::SetNote(unsigned char a_Note)
 {
 	m_Note = a_Note % 25;
+	MarkChunkDirty();
 }
 
 
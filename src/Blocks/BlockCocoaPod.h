@@ -39,6 +39,8 @@ private:
 
 
 
+	virtual bool IsRandomTickable(void) const override { return true; }
+
 	virtual void OnUpdate(
 		cChunkInterface & a_ChunkInterface,
 		cWorldInterface & a_WorldInterface,
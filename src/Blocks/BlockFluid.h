@@ -84,6 +84,8 @@ public:
 
 private:
 
+	virtual bool IsRandomTickable(void) const override { return true; }
+
 	virtual void OnUpdate(
 		cChunkInterface & a_ChunkInterface,
 		cWorldInterface & a_WorldInterface,
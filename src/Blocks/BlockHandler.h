@@ -41,6 +41,11 @@ public:
 		const Vector3i a_RelPos
 	) const;
 
+	/** Returns true if OnUpdate() does anything for this block type, i.e. the random ticks need to reach it.
+	Chunk sections without any random-tickable blocks skip the random ticks altogether,
+	so handlers overriding OnUpdate() need to override this as well. */
+	virtual bool IsRandomTickable(void) const { return false; }
+
 	/** Returns the relative bounding box that must be entity-free in
 	order for the block to be placed. a_XM, a_XP, etc. stand for the
 	blocktype of the minus-X neighbor, the positive-X neighbor, etc. */
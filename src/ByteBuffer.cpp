@@ -514,14 +514,46 @@ bool cByteBuffer::ReadVarUTF8String(AString & a_Value)
 	{
 		LOGWARNING("%s: String too large: %u (%u KiB)", __FUNCTION__, Size, Size / 1024);
 	}
-	ContiguousByteBuffer Buffer;
-	if (!ReadSome(Buffer, static_cast<size_t>(Size)))
+	if (!CanReadBytes(Size))
 	{
 		return false;
 	}
-	// "Convert" a UTF-8 encoded string into system-native char.
+	// "Convert" a UTF-8 encoded string into system-native char, by reading it directly into the string.
 	// This isn't great, better would be to use codecvt:
-	a_Value = { reinterpret_cast<const char *>(Buffer.data()), Buffer.size() };
+	a_Value.resize(Size);
+	return ReadBuf(a_Value.data(), Size);
+}
+
+
+
+
+
+bool cByteBuffer::ReadVarUTF8String(std::string_view & a_Value)
+{
+	CHECK_THREAD
+	CheckValid();
+	UInt32 Size = 0;
+	if (!ReadVarInt(Size))
+	{
+		return false;
+	}
+	if (Size > MAX_STRING_SIZE)
+	{
+		LOGWARNING("%s: String too large: %u (%u KiB)", __FUNCTION__, Size, Size / 1024);
+	}
+	if (!CanReadBytes(Size))
+	{
+		return false;
+	}
+	ASSERT(m_BufferSize >= m_ReadPos);
+	if (m_BufferSize - m_ReadPos < Size)
+	{
+		// The string continues at the ringbuffer start, there's no contiguous memory to view:
+		ASSERT(!"Viewing a string across the ringbuffer end");
+		return false;
+	}
+	a_Value = { reinterpret_cast<const char *>(m_Buffer.get() + m_ReadPos), Size };
+	AdvanceReadPos(Size);
 	return true;
 }
 
@@ -1066,6 +1098,19 @@ void cByteBuffer::CommitRead(void)
 
 
 
+void cByteBuffer::Clear(void)
+{
+	CHECK_THREAD
+	CheckValid();
+	m_DataStart = 0;
+	m_WritePos = 0;
+	m_ReadPos = 0;
+}
+
+
+
+
+
 void cByteBuffer::ResetRead(void)
 {
 	CHECK_THREAD
@@ -83,6 +83,7 @@ public:
 	bool ReadVarInt32       (UInt32 & a_Value);
 	bool ReadVarInt64       (UInt64 & a_Value);
 	bool ReadVarUTF8String  (AString & a_Value);  // string length as VarInt, then string as UTF-8
+	bool ReadVarUTF8String  (std::string_view & a_Value);  // as above, without a copy; the view is valid until the next write, the data must not wrap around the ringbuffer end (see Clear())
 	bool ReadLEInt          (int & a_Value);
 	bool ReadXYZPosition64  (int & a_BlockX, int & a_BlockY, int & a_BlockZ);
 	bool ReadXYZPosition64  (Vector3i & a_Position);
@@ -145,6 +146,9 @@ public:
 	/** Removes the bytes that have been read from the ringbuffer */
 	void CommitRead(void);
 
+	/** Discards all the data, including the unread data, and rewinds the ringbuffer, so that the data written next is contiguous. */
+	void Clear(void);
+
 	/** Restarts next reading operation at the start of the ringbuffer */
 	void ResetRead(void);
 
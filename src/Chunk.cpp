@@ -27,6 +27,7 @@
 #include "BlockInServerPluginInterface.h"
 #include "SetChunkData.h"
 #include "BoundingBox.h"
+#include "TickTrace.h"
 #include "Blocks/ChunkInterface.h"
 #include "Blocks/BlockSnow.h"
 #include "Blocks/BlockLeaves.h"
@@ -40,6 +41,13 @@
 
 
 
+/** The source of chunk modification revisions, shared by all chunks in all worlds. */
+static std::atomic<UInt64> g_ChunkRevisionCounter(0);
+
+
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 // cChunk:
 
@@ -51,6 +59,9 @@ cChunk::cChunk(
 	m_IsLightValid(false),
 	m_IsDirty(false),
 	m_IsSaving(false),
+	m_Revision(++g_ChunkRevisionCounter),
+	m_NumMobsPerFamily(),
+	m_NumRandomTickable(),
 	m_StayCount(0),
 	m_PosX(a_ChunkX),
 	m_PosZ(a_ChunkZ),
@@ -209,6 +220,51 @@ bool cChunk::HasPlayerEntities() const
 
 
 
+void cChunk::UpdateMobCount(const cEntity & a_Entity, int a_Delta)
+{
+	static_assert(std::tuple_size_v<decltype(m_NumMobsPerFamily)> == cMonster::mfNoSpawn + 1, "The mob counters must cover all the mob families");
+
+	if (!a_Entity.IsMob())
+	{
+		return;
+	}
+	auto & Count = m_NumMobsPerFamily[static_cast<size_t>(static_cast<const cMonster &>(a_Entity).GetMobFamily())];
+	Count += a_Delta;
+	ASSERT(Count >= 0);
+}
+
+
+
+
+
+void cChunk::CountRandomTickableBlocks(void)
+{
+	for (size_t Y = 0; Y < cChunkDef::NumSections; ++Y)
+	{
+		UInt16 Count = 0;
+		if (const auto Section = m_BlockData.GetSection(Y); Section != nullptr)
+		{
+			// Sections are mostly long runs of the same block, only look up the handler when the state changes:
+			BlockState LastBlock = *Section->begin();
+			bool LastTickable = cBlockHandler::For(LastBlock.Type()).IsRandomTickable();
+			for (const auto Block : *Section)
+			{
+				if (Block != LastBlock)
+				{
+					LastBlock = Block;
+					LastTickable = cBlockHandler::For(Block.Type()).IsRandomTickable();
+				}
+				Count += LastTickable ? 1 : 0;
+			}
+		}
+		m_NumRandomTickable[Y] = Count;
+	}
+}
+
+
+
+
+
 bool cChunk::CanUnload(void) const
 {
 	return
@@ -314,6 +370,7 @@ void cChunk::GetAllData(cChunkDataCallback & a_Callback) const
 	ASSERT(m_Presence == cpPresent);
 
 	a_Callback.LightIsValid(m_IsLightValid);
+	a_Callback.Revision(m_Revision);
 	a_Callback.ChunkData(m_BlockData, m_LightData);
 	a_Callback.HeightMap(m_HeightMap);
 	a_Callback.BiomeMap(m_BiomeMap);
@@ -339,8 +396,10 @@ void cChunk::SetAllData(SetChunkData && a_SetChunkData)
 	std::copy_n(a_SetChunkData.BiomeMap.data(), a_SetChunkData.BiomeMap.size(), m_BiomeMap.data());
 
 	m_BlockData = std::move(a_SetChunkData.BlockData);
+	CountRandomTickableBlocks();
 	m_LightData = std::move(a_SetChunkData.LightData);
 	m_IsLightValid = a_SetChunkData.IsLightValid;
+	BumpRevision();
 
 	m_PendingSendBlocks.clear();
 	m_PendingSendBlockEntities.clear();
@@ -357,11 +416,13 @@ void cChunk::SetAllData(SetChunkData && a_SetChunkData)
 	m_Entities = std::move(a_SetChunkData.Entities);
 
 	// Set all the entity variables again:
+	m_NumMobsPerFamily.fill(0);
 	for (const auto & Entity : m_Entities)
 	{
 		Entity->SetWorld(m_World);
 		Entity->SetParentChunk(this);
 		Entity->SetIsTicking(true);
+		UpdateMobCount(*Entity, 1);
 	}
 
 	// Remove the block entities present - either the loader / saver has better, or we'll create empty ones:
@@ -466,12 +527,23 @@ void cChunk::WriteBlockArea(cBlockArea & a_Area, int a_MinBlockX, int a_MinBlock
 		{
 			int ChunkZ = OffZ + z;
 			int AreaZ = BaseZ + z;
+			auto AreaRow = Blocks + a_Area.MakeIndex(BaseX, AreaY, AreaZ);
+
+			// Fetched for each row, FastSetBlock() replaces a shared section with a private copy (copy-on-write):
+			const auto Section = m_BlockData.GetSection(static_cast<size_t>(ChunkY / cChunkDef::SectionHeight));
+
+			// Skip rows that are already identical, FastSetBlock() would do nothing for them:
+			if (
+				(Section != nullptr) &&
+				std::equal(AreaRow, AreaRow + SizeX, Section->data() + cChunkDef::MakeIndex(OffX, ChunkY % cChunkDef::SectionHeight, ChunkZ))
+			)
+			{
+				continue;
+			}
+
 			for (int x = 0; x < SizeX; x++)
 			{
-				int ChunkX = OffX + x;
-				int AreaX = BaseX + x;
-				auto idx = a_Area.MakeIndex(AreaX, AreaY, AreaZ);
-				FastSetBlock(ChunkX, ChunkY, ChunkZ, Blocks[idx]);
+				FastSetBlock(OffX + x, ChunkY, ChunkZ, AreaRow[x]);
 			}  // for x
 		}  // for z
 	}  // for y
@@ -558,28 +630,10 @@ void cChunk::Stay(bool a_Stay)
 void cChunk::CollectMobCensus(cMobCensus & toFill)
 {
 	toFill.CollectSpawnableChunk(*this);
-	std::vector<Vector3d> PlayerPositions;
-	PlayerPositions.reserve(m_LoadedByClient.size());
-	for (auto ClientHandle : m_LoadedByClient)
+	for (size_t Family = 0; Family < m_NumMobsPerFamily.size(); Family++)
 	{
-		const cPlayer * currentPlayer = ClientHandle->GetPlayer();
-		PlayerPositions.push_back(currentPlayer->GetPosition());
+		toFill.CollectMobs(static_cast<cMonster::eFamily>(Family), m_NumMobsPerFamily[Family]);
 	}
-
-	Vector3d currentPosition;
-	for (auto & entity : m_Entities)
-	{
-		// LOGD("Counting entity #%i (%s)", (*itr)->GetUniqueID(), (*itr)->GetClass());
-		if (entity->IsMob())
-		{
-			auto & Monster = static_cast<cMonster &>(*entity);
-			currentPosition = Monster.GetPosition();
-			for (const auto & PlayerPos : PlayerPositions)
-			{
-				toFill.CollectMob(Monster, *this, (currentPosition - PlayerPos).SqrLength());
-			}
-		}
-	}  // for itr - m_Entitites[]
 }
 
 
@@ -631,6 +685,19 @@ void cChunk::SpawnMobs(cMobSpawner & a_MobSpawner)
 		return;
 	}
 
+	// The players that may be close enough to prevent spawning must have this chunk loaded, no need to look further:
+	static const double MinPlayerDistance = 24;
+	std::vector<Vector3d> PlayerPositions;
+	PlayerPositions.reserve(m_LoadedByClient.size());
+	for (auto ClientHandle : m_LoadedByClient)
+	{
+		const cPlayer * Player = ClientHandle->GetPlayer();
+		if (Player != nullptr)
+		{
+			PlayerPositions.push_back(Player->GetPosition());
+		}
+	}
+
 	a_MobSpawner.NewPack();
 	int NumberOfTries = 0;
 	int NumberOfSuccess = 0;
@@ -656,7 +723,7 @@ void cChunk::SpawnMobs(cMobSpawner & a_MobSpawner)
 
 		// MG TODO :
 		// Moon cycle (for slime)
-		// check player and playerspawn presence < 24 blocks
+		// check playerspawn presence < 24 blocks
 		// check mobs presence on the block
 
 		// MG TODO : check that "Level" really means Y
@@ -669,6 +736,17 @@ void cChunk::SpawnMobs(cMobSpawner & a_MobSpawner)
 
 		NumberOfTries++;
 
+		// Don't spawn too close to a player:
+		const Vector3d SpawnPos(WorldX + 0.5, WorldY, WorldZ + 0.5);
+		if (std::any_of(PlayerPositions.begin(), PlayerPositions.end(), [&SpawnPos](const Vector3d & a_PlayerPos)
+			{
+				return ((a_PlayerPos - SpawnPos).SqrLength() < MinPlayerDistance * MinPlayerDistance);
+			}
+		))
+		{
+			continue;
+		}
+
 		Vector3i Try(TryX, TryY, TryZ);
 		const auto Chunk = GetRelNeighborChunkAdjustCoords(Try);
 
@@ -696,12 +774,19 @@ void cChunk::SpawnMobs(cMobSpawner & a_MobSpawner)
 
 void cChunk::Tick(std::chrono::milliseconds a_Dt)
 {
+	cTickTrace::cScope Trace("Chunk", m_PosX, m_PosZ);
+
 	TickBlocks();
 
 	// Tick all block entities in this Chunk:
 	for (auto & KeyPair : m_BlockEntities)
 	{
-		m_IsDirty = KeyPair.second->Tick(a_Dt, *this) | m_IsDirty;
+		cTickTrace::cScope BlockEntityTrace("BlockEntity", NamespaceSerializer::From(KeyPair.second->GetBlockType()));
+		if (KeyPair.second->Tick(a_Dt, *this))
+		{
+			// The block entity data is part of the cached chunk packets, so the revision needs bumping, too:
+			MarkDirty();
+		}
 	}
 
 	for (auto itr = m_Entities.begin(); itr != m_Entities.end();)
@@ -717,6 +802,7 @@ void cChunk::Tick(std::chrono::milliseconds a_Dt)
 		{
 			// Tick all entities in this Chunk (except mobs):
 			ASSERT((*itr)->GetParentChunk() == this);
+			cTickTrace::cScope EntityTrace("Entity", (*itr)->GetClass());
 			(*itr)->Tick(a_Dt, *this);
 			ASSERT((*itr)->GetParentChunk() == this);
 		}
@@ -742,6 +828,8 @@ void cChunk::Tick(std::chrono::milliseconds a_Dt)
 
 			// This block is very similar to RemoveEntity, except it uses an iterator to avoid scanning the whole m_Entities
 			// The entity moved out of the Chunk, move it to the neighbor
+			UpdateMobCount(**itr, -1);
+			(*itr)->WakeUp();
 			(*itr)->SetParentChunk(nullptr);
 			MoveEntityToNewChunk(std::move(*itr));
 
@@ -858,20 +946,23 @@ void cChunk::TickBlocks(void)
 
 	// Choose a number of blocks for each section to randomly tick.
 	// http://minecraft.wiki/w/Tick#Random_tick
+	const auto RandomTickSpeed = m_World->GetRandomTickSpeed();
 	for (size_t Y = 0; Y < cChunkDef::NumSections; ++Y)
 	{
-		const auto Section = m_BlockData.GetSection(Y);
-		if (Section == nullptr)
+		// Ticking a block that isn't random-tickable does nothing, so skip the sections that have none of them.
+		// The positions within the ticked sections are still uniformly random, so the tick rates stay as in vanilla:
+		if (m_NumRandomTickable[Y] == 0)
 		{
 			continue;
 		}
 
-		for (int Tick = 0; Tick != 3; Tick++)  // TODO: configurability via gamerule randomTickSpeed
+		// Don't keep the section across the ticks, any OnUpdate() may replace it with a private copy (copy-on-write):
+		for (int Tick = 0; Tick < RandomTickSpeed; Tick++)
 		{
 			const auto Index = Random.RandInt<size_t>(ChunkBlockData::SectionBlockCount - 1);
 			const auto Position = cChunkDef::IndexToCoordinate(Y * ChunkBlockData::SectionBlockCount + Index);
 
-			cBlockHandler::For((*Section)[Index].Type()).OnUpdate(ChunkInterface, *m_World, PluginInterface, *this, Position);
+			cBlockHandler::For(m_BlockData.GetBlock(Position).Type()).OnUpdate(ChunkInterface, *m_World, PluginInterface, *this, Position);
 		}
 	}
 }
@@ -1209,16 +1300,16 @@ void cChunk::WakeUpSimulators(void)
 
 	for (size_t SectionIdx = 0; SectionIdx != cChunkDef::NumSections; ++SectionIdx)
 	{
-		const auto & Section = m_BlockData.GetSection(SectionIdx);
-		if (Section == nullptr)
+		if (m_BlockData.GetSection(SectionIdx) == nullptr)
 		{
 			continue;
 		}
 
+		// Don't keep the section across the loop, a simulator may set the block (vaporizing water) and the section gets replaced by a private copy:
 		for (size_t BlockIdx = 0; BlockIdx != ChunkBlockData::SectionBlockCount; ++BlockIdx)
 		{
-			const auto Block = (*Section)[BlockIdx];
 			const auto Position = cChunkDef::IndexToCoordinate(BlockIdx + SectionIdx * ChunkBlockData::SectionBlockCount);
+			const auto Block = m_BlockData.GetBlock(Position);
 
 			RedstoneSimulator->AddBlock(*this, Position, Block);
 			WaterSimulator->AddBlock(*this, Position, Block);
@@ -1238,6 +1329,9 @@ void cChunk::SetBlock(Vector3i a_RelPos, BlockState a_Block)
 	// Queue a check of this block's neighbors:
 	m_BlocksToCheck.push(a_RelPos);
 
+	// Pickups lying on or next to the block may need to fall or be pushed out:
+	WakeUpRestingEntities(a_RelPos);
+
 	// Wake up the simulators for this block:
 	GetWorld()->GetSimulatorManager()->WakeUp(*this, a_RelPos);
 
@@ -1264,6 +1358,43 @@ void cChunk::SetBlock(Vector3i a_RelPos, BlockState a_Block)
 
 
 
+void cChunk::WakeUpRestingEntities(Vector3i a_RelPos)
+{
+	// The entity physics look at the block an entity is in, the one below it and the ones around it,
+	// so wake up the entities resting anywhere in the 3x3x3 blocks around the changed one:
+	const auto BlockPos = RelativeToAbsolute(a_RelPos);
+	std::vector<cEntity *> ToWake;
+	for (int x = -1; x <= 1; x++)
+	{
+		for (int z = -1; z <= 1; z++)
+		{
+			const auto Chunk = GetRelNeighborChunk(a_RelPos.x + x, a_RelPos.z + z);
+			if ((Chunk == nullptr) || Chunk->m_RestingEntities.empty())
+			{
+				continue;
+			}
+			for (int y = -1; y <= 1; y++)
+			{
+				const auto Range = Chunk->m_RestingEntities.equal_range(BlockPos + Vector3i(x, y, z));
+				for (auto itr = Range.first; itr != Range.second; ++itr)
+				{
+					ToWake.push_back(itr->second);
+				}
+			}
+		}
+	}
+
+	// Waking up removes the entities from the index, so it cannot be done while iterating it:
+	for (const auto Entity : ToWake)
+	{
+		Entity->WakeUp();
+	}
+}
+
+
+
+
+
 void cChunk::FastSetBlock(int a_RelX, int a_RelY, int a_RelZ, BlockState a_Block)
 {
 	ASSERT(cChunkDef::IsValidRelPos({ a_RelX, a_RelY, a_RelZ }));
@@ -1284,9 +1415,23 @@ void cChunk::FastSetBlock(int a_RelX, int a_RelY, int a_RelZ, BlockState a_Block
 	{
 		MarkDirty();
 	}
+	else
+	{
+		// Not worth saving, but the serialized chunk data is different now:
+		BumpRevision();
+	}
 
 	m_BlockData.SetBlock({ a_RelX, a_RelY, a_RelZ }, a_Block);
 
+	// Keep the random tick index up to date:
+	const bool WasTickable = cBlockHandler::For(OldBlock.Type()).IsRandomTickable();
+	const bool IsTickable = cBlockHandler::For(a_Block.Type()).IsRandomTickable();
+	if (WasTickable != IsTickable)
+	{
+		auto & Count = m_NumRandomTickable[static_cast<size_t>(a_RelY / cChunkDef::SectionHeight)];
+		Count = static_cast<UInt16>(IsTickable ? (Count + 1) : (Count - 1));
+	}
+
 	// Queue block to be sent only if ...
 	if (
 		!(cBlockLeavesHandler::IsBlockLeaves(OldBlock) && cBlockLeavesHandler::IsBlockLeaves(a_Block)) &&  // ... the old and new blocktypes AREN'T leaves (because the client doesn't need meta updates)
@@ -1361,6 +1506,15 @@ void cChunk::SendBlockTo(int a_RelX, int a_RelY, int a_RelZ, cClientHandle * a_C
 
 
 
+void cChunk::BumpRevision(void)
+{
+	m_Revision = ++g_ChunkRevisionCounter;
+}
+
+
+
+
+
 void cChunk::AddBlockEntity(OwnedBlockEntity a_BlockEntity)
 {
 	const auto BlockEntityPtr = a_BlockEntity.get();
@@ -1551,6 +1705,7 @@ void cChunk::AddEntity(OwnedEntity a_Entity)
 	auto EntityPtr = a_Entity.get();
 
 	ASSERT(std::find(m_Entities.begin(), m_Entities.end(), a_Entity) == m_Entities.end());  // Not there already
+	UpdateMobCount(*a_Entity, 1);
 	m_Entities.emplace_back(std::move(a_Entity));
 
 	ASSERT(EntityPtr->GetParentChunk() == nullptr);
@@ -1565,6 +1720,7 @@ OwnedEntity cChunk::RemoveEntity(cEntity & a_Entity)
 {
 	ASSERT(a_Entity.GetParentChunk() == this);
 	ASSERT(!a_Entity.IsTicking());
+	a_Entity.WakeUp();  // Leave the resting entities' index
 	a_Entity.SetParentChunk(nullptr);
 
 	// Mark as dirty if it was a server-generated entity:
@@ -1593,6 +1749,10 @@ OwnedEntity cChunk::RemoveEntity(cEntity & a_Entity)
 		m_Entities.end()
 	);
 
+	if (Removed != nullptr)
+	{
+		UpdateMobCount(*Removed, -1);
+	}
 	return Removed;
 }
 
@@ -1600,6 +1760,34 @@ OwnedEntity cChunk::RemoveEntity(cEntity & a_Entity)
 
 
 
+void cChunk::AddRestingEntity(Vector3i a_BlockPos, cEntity & a_Entity)
+{
+	ASSERT(a_Entity.GetParentChunk() == this);
+	m_RestingEntities.emplace(a_BlockPos, &a_Entity);
+}
+
+
+
+
+
+void cChunk::RemoveRestingEntity(Vector3i a_BlockPos, cEntity & a_Entity)
+{
+	const auto Range = m_RestingEntities.equal_range(a_BlockPos);
+	for (auto itr = Range.first; itr != Range.second; ++itr)
+	{
+		if (itr->second == &a_Entity)
+		{
+			m_RestingEntities.erase(itr);
+			return;
+		}
+	}
+	ASSERT(!"Resting entity not found in its chunk");
+}
+
+
+
+
+
 bool cChunk::HasEntity(UInt32 a_EntityID) const
 {
 	for (const auto & Entity : m_Entities)
@@ -117,10 +117,10 @@ public:
 	before the chunk is unloadable again. */
 	void Stay(bool a_Stay = true);
 
-	/** Recence all mobs proximities to players in order to know what to do with them */
+	/** Adds the chunk and its mob counts to the census. The counts are kept up to date as the entities come and go. */
 	void CollectMobCensus(cMobCensus & toFill);
 
-	/** Try to Spawn Monsters inside chunk */
+	/** Try to Spawn Monsters inside chunk, away from the players that have the chunk loaded */
 	void SpawnMobs(cMobSpawner & a_MobSpawner);
 
 	void Tick(std::chrono::milliseconds a_Dt);
@@ -231,6 +231,13 @@ public:
 	Returns an owning reference to the found entity. */
 	OwnedEntity RemoveEntity(cEntity & a_Entity);
 
+	/** Adds the entity, which has just come to rest (see cEntity::IsAtRest()) in the specified absolute block, to the index of resting entities.
+	The entity must be in this chunk; it is removed from the index by cEntity::WakeUp(). */
+	void AddRestingEntity(Vector3i a_BlockPos, cEntity & a_Entity);
+
+	/** Removes the entity from the index of resting entities, a_BlockPos is the block it was added with. */
+	void RemoveRestingEntity(Vector3i a_BlockPos, cEntity & a_Entity);
+
 	bool HasEntity(UInt32 a_EntityID) const;
 
 	/** Calls the callback for each entity; returns true if all entities processed, false if the callback aborted by returning true */
@@ -267,8 +274,13 @@ public:
 	{
 		m_IsDirty = true;
 		m_IsSaving = false;
+		BumpRevision();
 	}
 
+	/** Returns the chunk's modification revision.
+	It changes whenever the block, light, biome or block entity data changes; used for caching the serialized chunk data. */
+	UInt64 GetRevision(void) const { return m_Revision; }
+
 	/** Causes the specified block to be ticked on the next Tick() call.
 	Plugins can use this via the cWorld:SetNextBlockToTick() API.
 	Only one block coord per chunk may be set, a second call overwrites the first call */
@@ -440,6 +452,10 @@ private:
 	bool m_IsDirty;        // True if the chunk has changed since it was last saved
 	bool m_IsSaving;       // True if the chunk is being saved
 
+	/** The modification revision of the chunk data, see GetRevision().
+	Assigned from a global counter so that a reloaded chunk never reuses a revision. */
+	UInt64 m_Revision;
+
 	/** Blocks that have changed and need to be sent to all clients.
 	The protocol has a provision for coalescing block changes, and this is the buffer.
 	It will collect the block changes that occur in a tick, before being flushed in BroadcastPendingSendBlocks. */
@@ -459,6 +475,18 @@ private:
 	std::vector<OwnedEntity> m_Entities;
 	cBlockEntities m_BlockEntities;
 
+	/** The entities from m_Entities that are at rest, keyed by the absolute block they rest in.
+	Lets a block change find the entities next to it without visiting all the entities. */
+	std::unordered_multimap<Vector3i, cEntity *, VectorHasher<int>> m_RestingEntities;
+
+	/** Number of mobs in m_Entities for each family, indexed by cMonster::eFamily.
+	Updated whenever an entity is added to or removed from m_Entities, so that the mob census doesn't need to visit the mobs. */
+	std::array<int, 5> m_NumMobsPerFamily;
+
+	/** Number of random-tickable blocks (see cBlockHandler::IsRandomTickable()) in each section.
+	Sections with no such blocks are skipped by TickBlocks(), since random ticks would be no-ops there. */
+	std::array<UInt16, cChunkDef::NumSections> m_NumRandomTickable;
+
 	/** Number of times the chunk has been requested to stay (by various cChunkStay objects); if zero, the chunk can be unloaded */
 	unsigned m_StayCount;
 
@@ -497,12 +525,19 @@ private:
 	void GetRandomBlockCoords(int & a_X, int & a_Y, int & a_Z);
 	void GetThreeRandomNumbers(int & a_X, int & a_Y, int & a_Z, int a_MaxX, int a_MaxY, int a_MaxZ);
 
+	/** Assigns a new, globally unique modification revision to the chunk. */
+	void BumpRevision(void);
+
 	/** Takes ownership of a block entity, which MUST actually reside in this chunk. */
 	void AddBlockEntity(OwnedBlockEntity a_BlockEntity);
 
 	/** Wakes up each simulator for its specific blocks; through all the blocks in the chunk */
 	void WakeUpSimulators(void);
 
+	/** Wakes up the entities at rest (see cEntity::IsAtRest()) that stand next to the specified block, in this chunk and its neighbors.
+	Called when the block changes, since it may have been supporting or blocking the entities. */
+	void WakeUpRestingEntities(Vector3i a_RelPos);
+
 	/** Checks the block scheduled for checking in m_ToTickBlocks[] */
 	void CheckBlocks();
 
@@ -526,4 +561,10 @@ private:
 
 	/** Check m_Entities for cPlayer objects. */
 	bool HasPlayerEntities() const;
+
+	/** Adds a_Delta to the m_NumMobsPerFamily counter for the entity's family, if the entity is a mob. */
+	void UpdateMobCount(const cEntity & a_Entity, int a_Delta);
+
+	/** Recounts m_NumRandomTickable from the whole block data, used when the block data is replaced. */
+	void CountRandomTickableBlocks(void);
 };
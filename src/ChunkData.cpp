@@ -35,6 +35,9 @@ namespace
 		return ElementCount != ChunkBlockData::SectionBlockCount;
 	}
 
+	template <size_t ElementCount, typename ValueType>
+	constexpr bool IsLightStore = (ElementCount == ChunkLightData::SectionLightCount) && std::is_same_v<ValueType, LIGHTTYPE>;
+
 	template <size_t ElementCount, typename ValueType>
 	ValueType UnpackDefaultValue(const ValueType DefaultValue)
 	{
@@ -45,6 +48,383 @@ namespace
 
 		return DefaultValue;
 	}
+
+
+
+
+
+	/** Returns the read-only light sections with all the nibbles set to the same value, indexed by the light level.
+	Uniformly lit sections (open sky, or dark underground) all reference these instead of having their own copy,
+	so that they take no section memory and can be recognized without scanning the data. */
+	template <class Type>
+	const std::array<std::shared_ptr<Type>, 16> & GetUniformLightSections()
+	{
+		static const auto Sections = []
+		{
+			std::array<std::shared_ptr<Type>, 16> Result;
+			for (size_t LightLevel = 0; LightLevel < Result.size(); LightLevel++)
+			{
+				Result[LightLevel] = std::make_shared<Type>();
+				Result[LightLevel]->fill(static_cast<LIGHTTYPE>(LightLevel * 0x11));
+			}
+			return Result;
+		}();
+		return Sections;
+	}
+
+
+
+
+
+	/** Type-erased interface of cSlabPool, for listing the statistics of all the pools. */
+	class cSlabPoolBase
+	{
+	public:
+
+		virtual ~cSlabPoolBase() = default;
+
+		virtual sChunkSectionPoolStats GetStats() const = 0;
+
+		/** Returns all the slab pools created so far. */
+		static std::vector<const cSlabPoolBase *> GetAll()
+		{
+			std::scoped_lock Lock(GetRegistryCS());
+			return GetRegistry();
+		}
+
+	protected:
+
+		/** Adds the pool to the list of all pools. Pools are never destroyed, so they're never removed. */
+		static void Register(const cSlabPoolBase & a_Pool)
+		{
+			std::scoped_lock Lock(GetRegistryCS());
+			GetRegistry().push_back(&a_Pool);
+		}
+
+	private:
+
+		static std::mutex & GetRegistryCS()
+		{
+			static std::mutex CS;
+			return CS;
+		}
+
+		static std::vector<const cSlabPoolBase *> & GetRegistry()
+		{
+			static std::vector<const cSlabPoolBase *> Registry;
+			return Registry;
+		}
+	};
+
+
+
+
+
+	/** Allocates fixed-size items carved out of large slabs, for the chunk sections and their refcount blocks.
+	Freed items are kept for reuse and the slabs are never returned to the heap, so the sections that chunks churn
+	through while loading and unloading don't fragment the general heap; the memory stays flat once the working set stabilizes.
+	Each thread keeps a small cache of free items, so that the storage, generator and lighting threads don't contend for the lock. */
+	template <size_t ItemSize, size_t ItemAlign>
+	class cSlabPool :
+		public cSlabPoolBase
+	{
+	public:
+
+		/** Returns the singleton instance.
+		Deliberately leaked, sections in static objects may be freed during the static destruction. */
+		static cSlabPool & Get()
+		{
+			static cSlabPool & Pool = *new cSlabPool;
+			return Pool;
+		}
+
+		void * Allocate()
+		{
+			if (t_IsCacheDestroyed)
+			{
+				// The thread is exiting, bypass the cache:
+				std::scoped_lock Lock(m_CS);
+				return PopLocked();
+			}
+			auto & Cache = t_Cache;
+			if (Cache.m_Count == 0)
+			{
+				// Refill half of the cache from the shared free list:
+				std::scoped_lock Lock(m_CS);
+				while (Cache.m_Count < CacheSize / 2)
+				{
+					Cache.m_Items[Cache.m_Count++] = PopLocked();
+				}
+			}
+			return Cache.m_Items[--Cache.m_Count];
+		}
+
+		void Free(void * a_Item)
+		{
+			if (t_IsCacheDestroyed)
+			{
+				std::scoped_lock Lock(m_CS);
+				PushLocked(a_Item);
+				return;
+			}
+			auto & Cache = t_Cache;
+			if (Cache.m_Count == CacheSize)
+			{
+				// Return half of the cache to the shared free list:
+				std::scoped_lock Lock(m_CS);
+				while (Cache.m_Count > CacheSize / 2)
+				{
+					PushLocked(Cache.m_Items[--Cache.m_Count]);
+				}
+			}
+			Cache.m_Items[Cache.m_Count++] = a_Item;
+		}
+
+		virtual sChunkSectionPoolStats GetStats() const override
+		{
+			std::scoped_lock Lock(m_CS);
+			return { BlockSize, m_NumSlabs, m_NumSlabs * ItemsPerSlab, m_NumAllocated };
+		}
+
+	private:
+
+		/** The size of each item, padded so that all items in a slab are aligned. */
+		static constexpr size_t Alignment = std::max(ItemAlign, alignof(void *));
+		static constexpr size_t BlockSize = (std::max(ItemSize, sizeof(void *)) + Alignment - 1) / Alignment * Alignment;
+
+		/** Number of items in a single slab, slabs are around 256 KiB. */
+		static constexpr size_t ItemsPerSlab = std::max<size_t>(16, (256 * 1024) / BlockSize);
+
+		/** Number of free items each thread may keep for itself. */
+		static constexpr size_t CacheSize = 32;
+
+		/** The free items kept by a single thread. */
+		struct sThreadCache
+		{
+			std::array<void *, CacheSize> m_Items;
+			size_t m_Count = 0;
+
+			~sThreadCache()
+			{
+				t_IsCacheDestroyed = true;
+				auto & Pool = Get();
+				std::scoped_lock Lock(Pool.m_CS);
+				while (m_Count > 0)
+				{
+					Pool.PushLocked(m_Items[--m_Count]);
+				}
+			}
+		};
+
+		static thread_local sThreadCache t_Cache;
+
+		/** Set once the thread's cache has been destroyed while the thread exits. Trivially destructible, so that it stays valid. */
+		static thread_local bool t_IsCacheDestroyed;
+
+		/** Protects the members below. */
+		mutable std::mutex m_CS;
+
+		/** Free items, linked through their first bytes. */
+		void * m_FreeList = nullptr;
+
+		/** Number of slabs allocated so far. */
+		size_t m_NumSlabs = 0;
+
+		/** Number of items handed out of the shared free list, including those in the thread caches. */
+		size_t m_NumAllocated = 0;
+
+		cSlabPool()
+		{
+			Register(*this);
+		}
+
+		void * PopLocked()
+		{
+			if (m_FreeList == nullptr)
+			{
+				// Carve a new slab into free items:
+				auto Slab = static_cast<std::byte *>(::operator new(BlockSize * ItemsPerSlab, std::align_val_t(Alignment)));
+				for (size_t i = ItemsPerSlab; i > 0; i--)
+				{
+					auto Item = Slab + (i - 1) * BlockSize;
+					*reinterpret_cast<void **>(Item) = m_FreeList;
+					m_FreeList = Item;
+				}
+				m_NumSlabs += 1;
+			}
+			auto Item = m_FreeList;
+			m_FreeList = *static_cast<void **>(Item);
+			m_NumAllocated += 1;
+			return Item;
+		}
+
+		void PushLocked(void * a_Item)
+		{
+			*static_cast<void **>(a_Item) = m_FreeList;
+			m_FreeList = a_Item;
+			m_NumAllocated -= 1;
+		}
+	};
+
+	template <size_t ItemSize, size_t ItemAlign>
+	thread_local typename cSlabPool<ItemSize, ItemAlign>::sThreadCache cSlabPool<ItemSize, ItemAlign>::t_Cache;
+
+	template <size_t ItemSize, size_t ItemAlign>
+	thread_local bool cSlabPool<ItemSize, ItemAlign>::t_IsCacheDestroyed = false;
+
+
+
+
+
+	/** Standard allocator on top of cSlabPool, used for allocating the sections together with their shared_ptr control blocks.
+	Only supports allocating single objects, which is what std::allocate_shared does. */
+	template <class T>
+	struct cSlabAllocator
+	{
+		using value_type = T;
+
+		cSlabAllocator() = default;
+
+		template <class U>
+		cSlabAllocator(const cSlabAllocator<U> &) {}
+
+		T * allocate(size_t a_Count)
+		{
+			ASSERT(a_Count == 1);
+			UNUSED(a_Count);
+			return static_cast<T *>(cSlabPool<sizeof(T), alignof(T)>::Get().Allocate());
+		}
+
+		void deallocate(T * a_Ptr, size_t a_Count)
+		{
+			ASSERT(a_Count == 1);
+			UNUSED(a_Count);
+			cSlabPool<sizeof(T), alignof(T)>::Get().Free(a_Ptr);
+		}
+
+		template <class U>
+		bool operator == (const cSlabAllocator<U> &) const { return true; }
+	};
+
+
+
+
+
+	/** Keeps a single copy of each distinct section content, shared by all the stores that contain it.
+	Flat and void worlds consist mostly of identical sections, those take up the memory only once.
+	The sections are refcounted, the last owner removes the section from the pool. */
+	template <class Type>
+	class cSectionPool
+	{
+	public:
+
+		/** Returns the singleton instance.
+		Deliberately leaked, like cSlabPool, sections in static objects may be released during the static destruction. */
+		static cSectionPool & Get()
+		{
+			static cSectionPool & Pool = *new cSectionPool;
+			return Pool;
+		}
+
+		/** Returns the shared section with the same contents as a_Section, creating it if there's none yet. */
+		std::shared_ptr<Type> Intern(const Type & a_Section)
+		{
+			const auto Hash = std::hash<std::string_view>()({reinterpret_cast<const char *>(a_Section.data()), sizeof(Type)});
+
+			// Sections with colliding hashes are kept alive until after the lock is released,
+			// if one of them got its last reference here, its deleter locks the pool again:
+			std::vector<std::shared_ptr<Type>> Collisions;
+			std::scoped_lock Lock(m_CS);
+			auto [Begin, End] = m_Sections.equal_range(Hash);
+			for (auto itr = Begin; itr != End; ++itr)
+			{
+				// The section may be already waiting for its deleter, only use it if it's still alive:
+				if (auto Shared = itr->second.m_Shared.lock(); Shared != nullptr)
+				{
+					if (*Shared == a_Section)
+					{
+						return Shared;
+					}
+					Collisions.push_back(std::move(Shared));
+				}
+			}
+
+			auto Section = new (cSlabPool<sizeof(Type), alignof(Type)>::Get().Allocate()) Type(a_Section);
+			std::shared_ptr<Type> Shared(Section, sDeleter{Hash, true}, cSlabAllocator<Type>());
+			m_Sections.emplace(Hash, sEntry{Shared.get(), Shared});
+			return Shared;
+		}
+
+		/** Removes the section from the pool if a_Section is its only owner, so that the owner may modify it in place.
+		Returns false if the section is still referenced elsewhere, or isn't from the pool; it needs to be copied before modifying then. */
+		bool TryDetach(const std::shared_ptr<Type> & a_Section)
+		{
+			const auto Deleter = std::get_deleter<sDeleter>(a_Section);
+			if (Deleter == nullptr)
+			{
+				return false;
+			}
+
+			// New references are only handed out by Intern(), under the lock, so a single owner stays the single owner:
+			std::scoped_lock Lock(m_CS);
+			if (a_Section.use_count() != 1)
+			{
+				return false;
+			}
+			EraseLocked(Deleter->m_Hash, a_Section.get());
+			Deleter->m_IsInPool = false;
+			return true;
+		}
+
+	private:
+
+		/** Frees the section when its last owner releases it, removing it from the pool unless it's been detached. */
+		struct sDeleter
+		{
+			size_t m_Hash;
+			bool m_IsInPool;
+
+			void operator () (Type * a_Section) const
+			{
+				if (m_IsInPool)
+				{
+					auto & Pool = Get();
+					std::scoped_lock Lock(Pool.m_CS);
+					Pool.EraseLocked(m_Hash, a_Section);
+				}
+				a_Section->~Type();
+				cSlabPool<sizeof(Type), alignof(Type)>::Get().Free(a_Section);
+			}
+		};
+
+		/** Plain mutex rather than cCriticalSection, so that the chunk data doesn't depend on the OSSupport library. */
+		std::mutex m_CS;
+
+		struct sEntry
+		{
+			/** Identifies the entry for removal, once m_Shared has expired. */
+			const Type * m_Section;
+
+			std::weak_ptr<Type> m_Shared;
+		};
+
+		/** The interned sections, keyed by the hash of their contents. */
+		std::unordered_multimap<size_t, sEntry> m_Sections;
+
+		/** Removes the entry for the specified section. Expects m_CS to be held. */
+		void EraseLocked(const size_t a_Hash, const Type * a_Section)
+		{
+			auto [Begin, End] = m_Sections.equal_range(a_Hash);
+			for (auto itr = Begin; itr != End; ++itr)
+			{
+				if (itr->second.m_Section == a_Section)
+				{
+					m_Sections.erase(itr);
+					return;
+				}
+			}
+		}
+	};
 }  // namespace (anonymous)
 
 
@@ -58,11 +438,13 @@ void ChunkDataStore<ElementType, ElementCount>::Assign(const ChunkDataStore<Elem
 	{
 		Store[Y].reset();
 
+		// Shared sections are never modified, they're only referenced:
 		if (const auto & Other = a_Other.Store[Y]; Other != nullptr)
 		{
-			Store[Y] = std::make_unique<Type>(*Other);
+			Store[Y] = a_Other.IsShared[Y] ? Other : std::allocate_shared<Type>(cSlabAllocator<Type>(), *Other);
 		}
 	}
+	IsShared = a_Other.IsShared;
 }
 
 
@@ -95,7 +477,7 @@ ElementType ChunkDataStore<ElementType, ElementCount>::Get(const Vector3i a_Posi
 
 
 template<class ElementType, size_t ElementCount>
-typename ChunkDataStore<ElementType, ElementCount>::Type * ChunkDataStore<ElementType, ElementCount>::GetSection(const size_t a_Y) const
+const typename ChunkDataStore<ElementType, ElementCount>::Type * ChunkDataStore<ElementType, ElementCount>::GetSection(const size_t a_Y) const
 {
 	return Store[a_Y].get();
 }
@@ -104,6 +486,35 @@ typename ChunkDataStore<ElementType, ElementCount>::Type * ChunkDataStore<Elemen
 
 
 
+template<class ElementType, size_t ElementCount>
+std::optional<ElementType> ChunkDataStore<ElementType, ElementCount>::GetUniformValue(const size_t a_Y) const
+{
+	if constexpr (IsLightStore<ElementCount, ElementType>)
+	{
+		const auto Section = Store[a_Y].get();
+		if ((Section != nullptr) && IsShared[a_Y])
+		{
+			const auto & Uniform = GetUniformLightSections<Type>();
+			for (size_t LightLevel = 0; LightLevel < Uniform.size(); LightLevel++)
+			{
+				if (Uniform[LightLevel].get() == Section)
+				{
+					return static_cast<ElementType>(LightLevel * 0x11);
+				}
+			}
+		}
+	}
+	else
+	{
+		UNUSED(a_Y);
+	}
+	return {};
+}
+
+
+
+
+
 template<class ElementType, size_t ElementCount>
 void ChunkDataStore<ElementType, ElementCount>::Set(const Vector3i a_Position, const ElementType a_Value)
 {
@@ -117,9 +528,18 @@ void ChunkDataStore<ElementType, ElementCount>::Set(const Vector3i a_Position, c
 			return;
 		}
 
-		Section = std::make_unique_for_overwrite<Type>();
+		Section = std::allocate_shared_for_overwrite<Type>(cSlabAllocator<Type>());
 		std::fill(Section->begin(), Section->end(), DefaultValue);
 	}
+	else if (IsShared[Indices.Section])
+	{
+		// Copy on write, other stores keep the original; a freshly loaded section that no other store shares is taken over without copying:
+		if (!cSectionPool<Type>::Get().TryDetach(Section))
+		{
+			Section = std::allocate_shared<Type>(cSlabAllocator<Type>(), *Section);
+		}
+		IsShared.reset(Indices.Section);
+	}
 
 	if (IsCompressed(ElementCount))
 	{
@@ -141,15 +561,34 @@ void ChunkDataStore<ElementType, ElementCount>::SetSection(const ElementType (&
 	auto & Section = Store[a_Y];
 	const auto SourceEnd = std::end(a_Source);
 
-	if (Section != nullptr)
+	if constexpr (IsLightStore<ElementCount, ElementType>)
 	{
-		std::copy(a_Source, SourceEnd, Section->begin());
+		// Both nibbles of every byte the same as in the first byte means the whole section has a single light level:
+		const auto First = a_Source[0];
+		if (
+			((First >> 4) == (First & 0x0f)) &&
+			std::all_of(a_Source, SourceEnd, [First](const auto Value) { return Value == First; })
+		)
+		{
+			if ((Section != nullptr) || (First != DefaultValue))
+			{
+				Section = GetUniformLightSections<Type>()[First & 0x0f];
+				IsShared.set(a_Y);
+			}
+			return;
+		}
 	}
-	else if (std::any_of(a_Source, SourceEnd, [&](const auto Value) { return Value != DefaultValue; }))
+
+	if (std::all_of(a_Source, SourceEnd, [&](const auto Value) { return Value == DefaultValue; }))
 	{
-		Section = std::make_unique_for_overwrite<Type>();
-		std::copy(a_Source, SourceEnd, Section->begin());
+		// Nothing to store, the unallocated section reads as the default value:
+		Section.reset();
+		IsShared.reset(a_Y);
+		return;
 	}
+
+	Section = cSectionPool<Type>::Get().Intern(reinterpret_cast<const Type &>(a_Source));
+	IsShared.set(a_Y);
 }
 
 
@@ -206,6 +645,34 @@ void ChunkLightData::Assign(const ChunkLightData & a_Other)
 
 
 
+std::optional<LIGHTTYPE> ChunkLightData::GetUniformBlockLight(const size_t a_Y) const
+{
+	const auto Value = m_BlockLights.GetUniformValue(a_Y);
+	if (!Value.has_value())
+	{
+		return {};
+	}
+	return static_cast<LIGHTTYPE>(*Value & 0x0f);
+}
+
+
+
+
+
+std::optional<LIGHTTYPE> ChunkLightData::GetUniformSkyLight(const size_t a_Y) const
+{
+	const auto Value = m_SkyLights.GetUniformValue(a_Y);
+	if (!Value.has_value())
+	{
+		return {};
+	}
+	return static_cast<LIGHTTYPE>(*Value & 0x0f);
+}
+
+
+
+
+
 void ChunkLightData::SetAll(const cChunkDef::LightNibbles & a_BlockLightSource, const cChunkDef::LightNibbles & a_SkyLightSource)
 {
 	m_BlockLights.SetAll(a_BlockLightSource);
@@ -226,6 +693,20 @@ void ChunkLightData::SetSection(const SectionType & a_BlockLightSource, const Se
 
 
 
+std::vector<sChunkSectionPoolStats> GetChunkSectionPoolStats()
+{
+	std::vector<sChunkSectionPoolStats> Stats;
+	for (const auto Pool : cSlabPoolBase::GetAll())
+	{
+		Stats.push_back(Pool->GetStats());
+	}
+	return Stats;
+}
+
+
+
+
+
 template struct ChunkDataStore<BlockState, ChunkBlockData::SectionBlockCount>;
 template struct ChunkDataStore<LIGHTTYPE, ChunkLightData::SectionLightCount>;
 
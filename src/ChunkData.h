@@ -11,6 +11,7 @@
 
 #include "FunctionRef.h"
 #include "BlockType.h"
+#include <optional>
 
 
 
@@ -31,15 +32,22 @@ struct ChunkDataStore
 	ElementType Get(Vector3i a_Position) const;
 
 	/** Returns a raw pointer to the internal representation of the specified section.
-	Will be nullptr if the section is not allocated. */
-	Type * GetSection(size_t a_Y) const;
+	Will be nullptr if the section is not allocated.
+	The pointer is invalidated by any modification of this store, since a shared section is replaced by a private copy on write. */
+	const Type * GetSection(size_t a_Y) const;
 
 	/** Sets one value at the given position.
-	Allocates a section if needed for the operation. */
+	Allocates a section if needed for the operation, a shared section is copied before being modified unless no other store references it. */
 	void Set(Vector3i a_Position, ElementType a_Value);
 
-	/** Copies the data from the specified flat section array into the internal representation.
-	Allocates a section if needed for the operation. */
+	/** Returns the value of all the elements in the specified section, if the section is stored as a uniform section.
+	Returns an empty optional for sections with differing values and for sections that are not allocated.
+	Only light sections are stored as uniform, block sections always return an empty optional. */
+	std::optional<ElementType> GetUniformValue(size_t a_Y) const;
+
+	/** Replaces the specified section with the interned copy of the data from the specified flat section array.
+	Stores that set identical data share a single section; data with all the values at DefaultValue frees the section instead.
+	Light sections with all the nibbles set to the same value share a single read-only section per light level instead. */
 	void SetSection(const ElementType (& a_Source)[ElementCount], size_t a_Y);
 
 	/** Copies the data from the specified flat array into the internal representation.
@@ -47,7 +55,11 @@ struct ChunkDataStore
 	void SetAll(const ElementType (& a_Source)[cChunkDef::NumSections * ElementCount]);
 
 	/** Contains all the sections this ChunkDataStore manages. */
-	std::unique_ptr<Type> Store[cChunkDef::NumSections];
+	std::shared_ptr<Type> Store[cChunkDef::NumSections];
+
+	/** Marks the sections in Store that are interned, shared with other stores and thus read-only. */
+	std::bitset<cChunkDef::NumSections> IsShared;
+
 	ElementType DefaultValue;
 };
 
@@ -79,7 +91,7 @@ public:
 
 	BlockState GetBlock(Vector3i a_Position) const { return m_Blocks.Get(a_Position); }
 
-	BlockArray * GetSection(size_t a_Y) const { return m_Blocks.GetSection(a_Y); }
+	const BlockArray * GetSection(size_t a_Y) const { return m_Blocks.GetSection(a_Y); }
 
 	void SetBlock(Vector3i a_Position, BlockState a_Block) { m_Blocks.Set(a_Position, a_Block); }
 
@@ -118,8 +130,13 @@ public:
 	LIGHTTYPE GetBlockLight(Vector3i a_Position) const { return m_BlockLights.Get(a_Position); }
 	LIGHTTYPE GetSkyLight(Vector3i a_Position) const { return m_SkyLights.Get(a_Position); }
 
-	LightArray * GetBlockLightSection(size_t a_Y) const { return m_BlockLights.GetSection(a_Y); }
-	LightArray * GetSkyLightSection(size_t a_Y) const { return m_SkyLights.GetSection(a_Y); }
+	const LightArray * GetBlockLightSection(size_t a_Y) const { return m_BlockLights.GetSection(a_Y); }
+	const LightArray * GetSkyLightSection(size_t a_Y) const { return m_SkyLights.GetSection(a_Y); }
+
+	/** Returns the light level of all the blocks in the specified section, if the section is uniformly lit.
+	Returns an empty optional for sections with varying light and for sections that are not allocated. */
+	std::optional<LIGHTTYPE> GetUniformBlockLight(size_t a_Y) const;
+	std::optional<LIGHTTYPE> GetUniformSkyLight(size_t a_Y) const;
 
 	void SetAll(const cChunkDef::LightNibbles & a_BlockLightSource, const cChunkDef::LightNibbles & a_SkyLightSource);
 	void SetSection(const SectionType & a_BlockLightSource, const SectionType & a_SkyLightSource, size_t a_Y);
@@ -129,6 +146,29 @@ public:
 
 
 
+/** Memory statistics of a single pool that the chunk sections are allocated from. */
+struct sChunkSectionPoolStats
+{
+	/** The size of a single item in the pool, in bytes. */
+	size_t m_ItemSize;
+
+	/** Number of slabs allocated, they're never freed. */
+	size_t m_NumSlabs;
+
+	/** Number of items in all the slabs. */
+	size_t m_NumItems;
+
+	/** Number of items in use, or kept in the per-thread caches. */
+	size_t m_NumUsed;
+};
+
+/** Returns the statistics of all the pools that the chunk sections are allocated from. */
+std::vector<sChunkSectionPoolStats> GetChunkSectionPoolStats();
+
+
+
+
+
 /** Invokes the callback functor for every chunk section containing at least one present block or light section data.
 This is used to collect all data for all sections.
 In macro form to work around a Visual Studio 2017 ICE bug. */
@@ -32,6 +32,10 @@ public:
 	/** Called once to let know if the chunk lighting is valid. Return value is ignored */
 	virtual void LightIsValid(bool a_IsLightValid) { UNUSED(a_IsLightValid); }
 
+	/** Called once to provide the chunk's modification revision.
+	The revision changes whenever the chunk data changes, and is never reused, even across chunk reloads. */
+	virtual void Revision(UInt64 a_Revision) { UNUSED(a_Revision); }
+
 	/** Called once to export block data. */
 	virtual void ChunkData(const ChunkBlockData & a_BlockData, const ChunkLightData & a_LightData) { UNUSED(a_BlockData); UNUSED(a_LightData); }
 
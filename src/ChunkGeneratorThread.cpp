@@ -245,7 +245,16 @@ void cChunkGeneratorThread::DoGenerate(cChunkCoords a_Coords)
 	ASSERT(m_PluginInterface != nullptr);
 	ASSERT(m_ChunkSink != nullptr);
 
-	cChunkDesc ChunkDesc(a_Coords);
+	if (m_ChunkDesc == nullptr)
+	{
+		m_ChunkDesc = std::make_unique<cChunkDesc>(a_Coords);
+	}
+	else
+	{
+		m_ChunkDesc->Reset(a_Coords);
+	}
+	auto & ChunkDesc = *m_ChunkDesc;
+
 	m_PluginInterface->CallHookChunkGenerating(ChunkDesc);
 	m_Generator->Generate(ChunkDesc);
 	m_PluginInterface->CallHookChunkGenerated(ChunkDesc);
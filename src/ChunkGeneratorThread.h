@@ -146,6 +146,10 @@ private:
 	/** The destination where the generated chunks are sent */
 	cChunkSink * m_ChunkSink;
 
+	/** The chunk description reused for generating all the chunks, so that its storage isn't reallocated for each chunk.
+	Created on first use, accessed only from the generator thread. */
+	std::unique_ptr<cChunkDesc> m_ChunkDesc;
+
 
 	// cIsThread override:
 	virtual void Execute(void) override;
@@ -729,6 +729,96 @@ bool cChunkMap::GetBlocks(sSetBlockVector & a_Blocks, bool a_ContinueOnFailure)
 
 
 
+size_t cChunkMap::SetBlocks(const sSetBlockVector & a_Blocks)
+{
+	size_t NumSet = 0;
+	cChunk * Chunk = nullptr;
+	cChunkCoords ChunkCoords(std::numeric_limits<int>::max(), std::numeric_limits<int>::max());
+
+	cCSLock Lock(m_CSChunks);
+	for (const auto & Block : a_Blocks)
+	{
+		if (!cChunkDef::IsValidHeight(Block.GetRelativePos()))
+		{
+			continue;
+		}
+
+		// Only look the chunk up when the batch moves to another one:
+		if ((Block.m_ChunkX != ChunkCoords.m_ChunkX) || (Block.m_ChunkZ != ChunkCoords.m_ChunkZ))
+		{
+			ChunkCoords = { Block.m_ChunkX, Block.m_ChunkZ };
+			Chunk = FindChunk(Block.m_ChunkX, Block.m_ChunkZ);
+		}
+		if ((Chunk == nullptr) || !Chunk->IsValid())
+		{
+			continue;
+		}
+
+		Chunk->SetBlock(Block.GetRelativePos(), Block.m_Block);
+		NumSet++;
+	}
+	return NumSet;
+}
+
+
+
+
+
+bool cChunkMap::GetBlocksInCuboid(const cCuboid & a_Cuboid, std::vector<BlockState> & a_Blocks) const
+{
+	ASSERT(a_Cuboid.IsSorted());
+
+	const int SizeX = a_Cuboid.DifX() + 1;
+	const int SizeZ = a_Cuboid.DifZ() + 1;
+	a_Blocks.assign(static_cast<size_t>(a_Cuboid.GetVolume()), Block::Air::Air());
+
+	// Only the part of the cuboid within the valid height is read, the rest stays air:
+	const int MinY = std::max(a_Cuboid.p1.y, 0);
+	const int MaxY = std::min(a_Cuboid.p2.y, cChunkDef::Height - 1);
+	const auto MinChunk = cChunkDef::BlockToChunk(a_Cuboid.p1);
+	const auto MaxChunk = cChunkDef::BlockToChunk(a_Cuboid.p2);
+
+	bool Result = true;
+	cCSLock Lock(m_CSChunks);
+	for (int ChunkZ = MinChunk.m_ChunkZ; ChunkZ <= MaxChunk.m_ChunkZ; ChunkZ++)
+	{
+		for (int ChunkX = MinChunk.m_ChunkX; ChunkX <= MaxChunk.m_ChunkX; ChunkX++)
+		{
+			const auto Chunk = FindChunk(ChunkX, ChunkZ);
+			if ((Chunk == nullptr) || !Chunk->IsValid())
+			{
+				Result = false;
+				continue;
+			}
+
+			// The part of the cuboid inside this chunk, in absolute coords:
+			const int BaseX = ChunkX * cChunkDef::Width;
+			const int BaseZ = ChunkZ * cChunkDef::Width;
+			const int MinX = std::max(a_Cuboid.p1.x, BaseX);
+			const int MaxX = std::min(a_Cuboid.p2.x, BaseX + cChunkDef::Width - 1);
+			const int MinZ = std::max(a_Cuboid.p1.z, BaseZ);
+			const int MaxZ = std::min(a_Cuboid.p2.z, BaseZ + cChunkDef::Width - 1);
+
+			for (int y = MinY; y <= MaxY; y++)
+			{
+				for (int z = MinZ; z <= MaxZ; z++)
+				{
+					auto Index = static_cast<size_t>((MinX - a_Cuboid.p1.x) + (z - a_Cuboid.p1.z) * SizeX + (y - a_Cuboid.p1.y) * SizeX * SizeZ);
+					for (int x = MinX; x <= MaxX; x++, Index++)
+					{
+						a_Blocks[Index] = Chunk->GetBlock(x - BaseX, y, z - BaseZ);
+					}
+				}
+			}
+		}  // for ChunkX
+	}  // for ChunkZ
+	return Result;
+}
+
+
+
+
+
 bool cChunkMap::DigBlock(Vector3i a_BlockPos)
 {
 	auto ChunkCoords = cChunkDef::BlockToChunk(a_BlockPos);
@@ -24,6 +24,7 @@ class cBlockArea;
 class cMobCensus;
 class cMobSpawner;
 class cBoundingBox;
+class cCuboid;
 class cDeadlockDetect;
 
 struct SetChunkData;
@@ -140,6 +141,19 @@ public:
 	Returns true if all blocks were read, false if any one failed. */
 	bool GetBlocks(sSetBlockVector & a_Blocks, bool a_ContinueOnFailure);
 
+	/** Sets all the specified blocks, same as SetBlock() for each of them, but with the chunkmap locked only once.
+	Consecutive blocks in the same chunk share a single chunk lookup, so callers should group the blocks by chunk.
+	The changes are broadcast once per chunk section with the other pending changes, and light is recalculated once per chunk.
+	Blocks in chunks that are not valid, or outside the valid height, are skipped.
+	Returns the number of blocks that were set. */
+	size_t SetBlocks(const sSetBlockVector & a_Blocks);
+
+	/** Reads all the blocks in the cuboid (sorted, both coords inclusive) into a flat array,
+	in the same index order as cBlockArea (X varies fastest, then Z, then Y).
+	Blocks in chunks that are not valid, or outside the valid height, are reported as air.
+	Returns true if all the chunks were valid. */
+	bool GetBlocksInCuboid(const cCuboid & a_Cuboid, std::vector<BlockState> & a_Blocks) const;
+
 	/** Removes the block at the specified coords and wakes up simulators.
 	Returns false if the chunk is not loaded (and the block is not dug).
 	Returns true if successful. */
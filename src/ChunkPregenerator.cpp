@@ -0,0 +1,567 @@
+
+// ChunkPregenerator.cpp
+
+// Implements the cChunkPregenerator class that generates, lights and saves an area of a world in the background
+
+#include "Globals.h"
+#include "ChunkPregenerator.h"
+#include "Bindings/PluginManager.h"
+#include "Generating/ChunkDesc.h"
+#include "Generating/ChunkGenerator.h"
+#include "WorldStorage/WorldStorage.h"
+#include "ChunkDataCallback.h"
+#include "IniFile.h"
+#include "LightingThread.h"
+#include "SetChunkData.h"
+#include "World.h"
+
+
+
+
+
+namespace
+{
+	/** Number of generated chunks kept for lighting their neighbors.
+	The area is processed in rows of a region, so the previous, current and next rows (including the neighbors
+	on both sides) need to fit in, so that each chunk is generated only once within a region. */
+	constexpr size_t MaxCachedChunks = 3 * (cChunkPregeneratorJob::RegionWidth + 2) + 16;
+
+	/** Time between two progress reports in the log. */
+	constexpr auto ReportInterval = std::chrono::seconds(10);
+
+	/** Time to wait before checking again whether the world's generator is still busy. */
+	constexpr unsigned YieldIntervalMSec = 100;
+}  // namespace (anonymous)
+
+
+
+
+
+cChunkPregenerator::cChunkPregenerator(cWorld & a_World):
+	Super("Chunk Pregenerator"),
+	m_World(a_World),
+	m_IsRunning(false),
+	m_IsCancelled(false),
+	m_NumChunksDone(0),
+	m_NumChunksGenerated(0),
+	m_NumChunksSkipped(0),
+	m_NumChunksFailed(0),
+	m_NumBytesWritten(0),
+	m_NumChunksDoneAtStart(0),
+	m_MaxChunksPerSec(0),
+	m_MaxWriteKiBPerSec(0),
+	m_ShouldYieldToWorld(true),
+	m_UseCounter(0)
+{
+}
+
+
+
+
+
+cChunkPregenerator::~cChunkPregenerator()
+{
+	Stop();
+}
+
+
+
+
+
+void cChunkPregenerator::Initialize(cIniFile & a_IniFile)
+{
+	m_MaxChunksPerSec    = std::max(a_IniFile.GetValueSetI("Pregenerator", "MaxChunksPerSec",   50), 0);
+	m_MaxWriteKiBPerSec  = std::max(a_IniFile.GetValueSetI("Pregenerator", "MaxWriteKiBPerSec", 4096), 0);
+	m_ShouldYieldToWorld = a_IniFile.GetValueSetB("Pregenerator", "YieldToWorldGenerator", true);
+}
+
+
+
+
+
+bool cChunkPregenerator::StartSquare(int a_Chunk1X, int a_Chunk1Z, int a_Chunk2X, int a_Chunk2Z)
+{
+	return StartJob({eShape::Square, a_Chunk1X, a_Chunk1Z, a_Chunk2X, a_Chunk2Z});
+}
+
+
+
+
+
+bool cChunkPregenerator::StartSpiral(int a_CenterChunkX, int a_CenterChunkZ, int a_Radius)
+{
+	a_Radius = std::abs(a_Radius);
+	return StartJob({
+		eShape::Spiral,
+		a_CenterChunkX - a_Radius, a_CenterChunkZ - a_Radius,
+		a_CenterChunkX + a_Radius, a_CenterChunkZ + a_Radius
+	});
+}
+
+
+
+
+
+void cChunkPregenerator::ResumeIfInterrupted(void)
+{
+	const auto FileName = GetStateFileName();
+	if (!cFile::IsFile(FileName))
+	{
+		return;
+	}
+	cIniFile State;
+	cChunkPregeneratorJob Job;
+	if (!State.ReadFile(FileName, false) || !Job.Load(State))
+	{
+		LOGWARNING("Cannot read the pregeneration state from %s, the pregeneration will not be resumed.", FileName);
+		return;
+	}
+
+	if (StartJob(Job))
+	{
+		LOG("Resuming the pregeneration of world %s.", m_World.GetName());
+	}
+}
+
+
+
+
+
+bool cChunkPregenerator::Cancel(void)
+{
+	if (!m_IsRunning)
+	{
+		cFile::DeleteFile(GetStateFileName());
+		return false;
+	}
+
+	// The thread deletes the state file once it terminates, so that it doesn't race with a SaveState() in progress:
+	m_IsCancelled = true;
+	m_ShouldTerminate = true;
+	m_evtWakeUp.Set();
+	return true;
+}
+
+
+
+
+
+void cChunkPregenerator::Stop(void)
+{
+	m_ShouldTerminate = true;
+	m_evtWakeUp.Set();
+	Super::Stop();
+	m_IsRunning = false;
+}
+
+
+
+
+
+size_t cChunkPregenerator::GetNumChunksTotal(void) const
+{
+	cCSLock Lock(m_CS);
+	return m_Job.GetNumChunks();
+}
+
+
+
+
+
+AString cChunkPregenerator::GetStatus(void) const
+{
+	if (!m_IsRunning)
+	{
+		return fmt::format(FMT_STRING("No pregeneration is running in world {}."), m_World.GetName());
+	}
+
+	const auto NumDone = m_NumChunksDone.load();
+	const auto NumTotal = std::max<size_t>(GetNumChunksTotal(), 1);
+	cCSLock Lock(m_CS);
+	const auto Elapsed = std::chrono::duration<double>(cClock::now() - m_StartTime).count();
+	const auto Speed = (Elapsed > 0) ? static_cast<double>(NumDone - std::min(NumDone, m_NumChunksDoneAtStart)) / Elapsed : 0.0;
+	return fmt::format(
+		FMT_STRING("Pregenerating world {}, {} area [{}, {}] - [{}, {}]: {} of {} chunks ({:.1f} %), {:.1f} chunks/s; {} generated, {} skipped, {} failed, {} KiB written."),
+		m_World.GetName(), m_Job.GetShapeName(),
+		m_Job.m_MinChunkX, m_Job.m_MinChunkZ, m_Job.m_MaxChunkX, m_Job.m_MaxChunkZ,
+		NumDone, NumTotal, 100.0 * static_cast<double>(NumDone) / static_cast<double>(NumTotal), Speed,
+		m_NumChunksGenerated.load(), m_NumChunksSkipped.load(), m_NumChunksFailed.load(), m_NumBytesWritten.load() / 1024
+	);
+}
+
+
+
+
+
+void cChunkPregenerator::Execute(void)
+{
+	// The generator is a separate instance from the world's, so that the two threads don't share the generator caches:
+	cIniFile IniFile;
+	IniFile.ReadFile(m_World.GetIniFileName());
+	m_Generator = cChunkGenerator::CreateFromIniFile(IniFile);
+	if (m_Generator == nullptr)
+	{
+		LOGWARNING("Cannot create the generator for pregenerating world %s.", m_World.GetName());
+		m_IsRunning = false;
+		return;
+	}
+	m_Lighting = std::make_unique<cLightingThread>(m_World);
+	m_LastReport = cClock::now();
+	m_NextGenerateTime = m_LastReport;
+	m_NextWriteTime = m_LastReport;
+
+	for (;;)
+	{
+		cChunkCoords Region(0, 0);
+		{
+			cCSLock Lock(m_CS);
+			if (m_Job.IsFinished())
+			{
+				break;
+			}
+			Region = m_Job.m_Regions[m_Job.m_NextRegion];
+		}
+
+		ProcessRegion(Region);
+		if (m_ShouldTerminate)
+		{
+			// The region is processed anew when resumed, its chunks stored so far will be skipped then
+			break;
+		}
+
+		{
+			cCSLock Lock(m_CS);
+			m_Job.FinishRegion(m_NumChunksDone);
+		}
+		SaveState();
+	}
+
+	if (m_IsCancelled)
+	{
+		cFile::DeleteFile(GetStateFileName());
+		LOG("Pregeneration of world %s cancelled.", m_World.GetName());
+	}
+	else if (!m_ShouldTerminate)
+	{
+		cFile::DeleteFile(GetStateFileName());
+		LOG("%s", GetStatus());
+		LOG("Pregeneration of world %s finished.", m_World.GetName());
+	}
+
+	// Free the memory, it's not needed until the next job:
+	m_Cache.clear();
+	m_Lighting.reset();
+	m_ChunkDesc.reset();
+	m_Generator.reset();
+	m_IsRunning = false;
+}
+
+
+
+
+
+bool cChunkPregenerator::StartJob(const cChunkPregeneratorJob & a_Job)
+{
+	bool WasRunning = false;
+	if (!m_IsRunning.compare_exchange_strong(WasRunning, true))
+	{
+		return false;
+	}
+
+	// Join the thread of the previous job, if any, so that it can be started anew; it has finished already, since it was not running:
+	Super::Stop();
+
+	cCSLock Lock(m_CS);
+	m_Job = a_Job;
+	m_IsCancelled = false;
+	m_NumChunksDone = a_Job.m_NumChunksDoneBeforeRegion;
+	m_NumChunksGenerated = 0;
+	m_NumChunksSkipped = 0;
+	m_NumChunksFailed = 0;
+	m_NumBytesWritten = 0;
+	m_StartTime = cClock::now();
+	m_NumChunksDoneAtStart = a_Job.m_NumChunksDoneBeforeRegion;
+	Start();
+	return true;
+}
+
+
+
+
+
+void cChunkPregenerator::ProcessRegion(cChunkCoords a_Region)
+{
+	int MinX, MinZ, MaxX, MaxZ;
+	{
+		cCSLock Lock(m_CS);
+		m_Job.GetRegionArea(a_Region, MinX, MinZ, MaxX, MaxZ);
+	}
+
+	for (int z = MinZ; z <= MaxZ; z++)
+	{
+		for (int x = MinX; x <= MaxX; x++)
+		{
+			if (m_ShouldTerminate)
+			{
+				return;
+			}
+			ProcessChunk({x, z});
+			m_NumChunksDone += 1;
+			ReportProgress();
+		}
+	}
+
+	// The neighbors in the next region are mostly not adjacent to this region's chunks, start afresh:
+	m_Cache.clear();
+}
+
+
+
+
+
+void cChunkPregenerator::ProcessChunk(cChunkCoords a_Coords)
+{
+	// Skip chunks that have been generated before, or that the world takes care of:
+	auto & Storage = m_World.GetStorage();
+	if (
+		m_World.IsChunkValid(a_Coords.m_ChunkX, a_Coords.m_ChunkZ) ||
+		m_World.IsChunkQueued(a_Coords.m_ChunkX, a_Coords.m_ChunkZ) ||
+		Storage.IsChunkStored(a_Coords)
+	)
+	{
+		m_NumChunksSkipped += 1;
+		return;
+	}
+
+	// Generate the 3x3 neighborhood and light the middle chunk:
+	std::array<SetChunkData *, 9> Neighborhood;
+	for (int z = 0; z < 3; z++)
+	{
+		for (int x = 0; x < 3; x++)
+		{
+			Neighborhood[static_cast<size_t>(x + 3 * z)] = &GetGeneratedChunk({a_Coords.m_ChunkX + x - 1, a_Coords.m_ChunkZ + z - 1});
+			if (m_ShouldTerminate)
+			{
+				return;
+			}
+		}
+	}
+	cChunkDef::LightNibbles BlockLight, SkyLight;
+	m_Lighting->CalcChunkLight(
+		[&Neighborhood](int a_OffsetX, int a_OffsetZ, cChunkDataCallback & a_Callback)
+		{
+			FeedChunkData(*Neighborhood[static_cast<size_t>(a_OffsetX + 1 + 3 * (a_OffsetZ + 1))], a_Callback);
+		},
+		BlockLight, SkyLight
+	);
+	auto & Chunk = *Neighborhood[4];
+	Chunk.LightData.SetAll(BlockLight, SkyLight);
+	Chunk.IsLightValid = true;
+
+	// Throttle the writing:
+	SleepUntil(m_NextWriteTime);
+	if (m_ShouldTerminate)
+	{
+		return;
+	}
+
+	// The world may have started loading the chunk in the meantime; if so, it will generate and save it by itself:
+	if (m_World.IsChunkValid(a_Coords.m_ChunkX, a_Coords.m_ChunkZ) || m_World.IsChunkQueued(a_Coords.m_ChunkX, a_Coords.m_ChunkZ))
+	{
+		m_NumChunksSkipped += 1;
+		return;
+	}
+
+	const auto NumBytes = Storage.SaveUnloadedChunk(a_Coords, [&Chunk](cChunkDataCallback & a_Callback)
+		{
+			FeedChunkData(Chunk, a_Callback);
+		}
+	);
+	if (NumBytes == 0)
+	{
+		m_NumChunksFailed += 1;
+		return;
+	}
+	m_NumBytesWritten += NumBytes;
+
+	const auto MaxWriteKiBPerSec = m_MaxWriteKiBPerSec.load();
+	if (MaxWriteKiBPerSec > 0)
+	{
+		const auto WriteTime = std::chrono::duration_cast<cClock::duration>(
+			std::chrono::duration<double>(static_cast<double>(NumBytes) / (MaxWriteKiBPerSec * 1024.0))
+		);
+		m_NextWriteTime = std::max(m_NextWriteTime, cClock::now()) + WriteTime;
+	}
+}
+
+
+
+
+
+SetChunkData & cChunkPregenerator::GetGeneratedChunk(cChunkCoords a_Coords)
+{
+	m_UseCounter += 1;
+	auto itr = m_Cache.find(a_Coords);
+	if (itr != m_Cache.end())
+	{
+		itr->second.m_LastUsed = m_UseCounter;
+		return *itr->second.m_Data;
+	}
+
+	// Evict the least recently used chunk, if the cache is full. The chunks of the current neighborhood are the most recently used, they stay:
+	if (m_Cache.size() >= MaxCachedChunks)
+	{
+		auto Oldest = std::min_element(m_Cache.begin(), m_Cache.end(), [](const auto & a_First, const auto & a_Second)
+			{
+				return (a_First.second.m_LastUsed < a_Second.second.m_LastUsed);
+			}
+		);
+		m_Cache.erase(Oldest);
+	}
+
+	auto & Cached = m_Cache[a_Coords];
+	Cached.m_Data = GenerateChunk(a_Coords);
+	Cached.m_LastUsed = m_UseCounter;
+	return *Cached.m_Data;
+}
+
+
+
+
+
+std::unique_ptr<SetChunkData> cChunkPregenerator::GenerateChunk(cChunkCoords a_Coords)
+{
+	// Give way to the world's own generator, players are waiting for its chunks:
+	while (m_ShouldYieldToWorld && !m_ShouldTerminate && (m_World.GetGeneratorQueueLength() > 0))
+	{
+		m_evtWakeUp.Wait(YieldIntervalMSec);
+	}
+
+	// Throttle the generating:
+	SleepUntil(m_NextGenerateTime);
+	const auto MaxChunksPerSec = m_MaxChunksPerSec.load();
+	if (MaxChunksPerSec > 0)
+	{
+		m_NextGenerateTime = std::max(m_NextGenerateTime, cClock::now()) + std::chrono::microseconds(1000000 / MaxChunksPerSec);
+	}
+
+	if (m_ChunkDesc == nullptr)
+	{
+		m_ChunkDesc = std::make_unique<cChunkDesc>(a_Coords);
+	}
+	else
+	{
+		m_ChunkDesc->Reset(a_Coords);
+	}
+	auto & ChunkDesc = *m_ChunkDesc;
+
+	cPluginManager::Get()->CallHookChunkGenerating(m_World, a_Coords.m_ChunkX, a_Coords.m_ChunkZ, &ChunkDesc);
+	m_Generator->Generate(ChunkDesc);
+	cPluginManager::Get()->CallHookChunkGenerated(m_World, a_Coords.m_ChunkX, a_Coords.m_ChunkZ, &ChunkDesc);
+
+	#ifndef NDEBUG
+		// Verify that the generator has produced valid data:
+		ChunkDesc.VerifyHeightmap();
+	#endif
+
+	// Same conversion as the world does for the chunks from its generator:
+	auto Data = std::make_unique<SetChunkData>(a_Coords);
+	Data->BlockData.SetAll(ChunkDesc.GetBlocks());
+	std::copy(ChunkDesc.GetBiomeMap().begin(),  ChunkDesc.GetBiomeMap().end(),  Data->BiomeMap.data());
+	std::copy(ChunkDesc.GetHeightMap().begin(), ChunkDesc.GetHeightMap().end(), Data->HeightMap.data());
+	Data->Entities = std::move(ChunkDesc.GetEntities());
+	Data->BlockEntities = std::move(ChunkDesc.GetBlockEntities());
+	Data->IsLightValid = false;
+
+	m_NumChunksGenerated += 1;
+	return Data;
+}
+
+
+
+
+
+void cChunkPregenerator::SleepUntil(cClock::time_point a_Time)
+{
+	for (;;)
+	{
+		const auto Now = cClock::now();
+		if ((Now >= a_Time) || m_ShouldTerminate)
+		{
+			return;
+		}
+		const auto MSec = std::chrono::duration_cast<std::chrono::milliseconds>(a_Time - Now).count();
+		m_evtWakeUp.Wait(static_cast<unsigned>(std::clamp<Int64>(MSec, 1, 1000)));
+	}
+}
+
+
+
+
+
+void cChunkPregenerator::ReportProgress(void)
+{
+	const auto Now = cClock::now();
+	if (Now - m_LastReport < ReportInterval)
+	{
+		return;
+	}
+	m_LastReport = Now;
+	LOG("%s", GetStatus());
+}
+
+
+
+
+
+AString cChunkPregenerator::GetStateFileName(void) const
+{
+	return fmt::format(FMT_STRING("{}{}pregen.ini"), m_World.GetDataPath(), cFile::PathSeparator());
+}
+
+
+
+
+
+void cChunkPregenerator::SaveState(void)
+{
+	cIniFile State;
+	State.AddHeaderComment(" The pregeneration in progress in this world, it is resumed from here when the server starts.");
+	State.AddHeaderComment(" Delete this file to cancel the pregeneration.");
+	{
+		cCSLock Lock(m_CS);
+		m_Job.Save(State);
+	}
+	if (!State.WriteFile(GetStateFileName()))
+	{
+		LOGWARNING("Cannot write the pregeneration state into %s, the pregeneration will not resume after a restart.", GetStateFileName());
+	}
+}
+
+
+
+
+
+void cChunkPregenerator::FeedChunkData(const SetChunkData & a_Data, cChunkDataCallback & a_Callback)
+{
+	if (!a_Callback.Coords(a_Data.Chunk.m_ChunkX, a_Data.Chunk.m_ChunkZ))
+	{
+		return;
+	}
+	a_Callback.LightIsValid(a_Data.IsLightValid);
+	a_Callback.ChunkData(a_Data.BlockData, a_Data.LightData);
+	a_Callback.HeightMap(a_Data.HeightMap);
+	a_Callback.BiomeMap(a_Data.BiomeMap);
+	for (const auto & Entity : a_Data.Entities)
+	{
+		a_Callback.Entity(Entity.get());
+	}
+	for (const auto & KeyPair : a_Data.BlockEntities)
+	{
+		a_Callback.BlockEntity(KeyPair.second.get());
+	}
+}
+
+
+
+
@@ -0,0 +1,199 @@
+
+// ChunkPregenerator.h
+
+// Declares the cChunkPregenerator class that generates, lights and saves an area of a world in the background
+
+/*
+The pregenerator streams the chunks of an area through generate -> light -> serialize -> store in its own thread,
+without ever putting them into the world's cChunkMap; the world's generator, lighting and storage threads aren't involved,
+so a live server can pregenerate with only the configured CPU and IO cost. The chunk map lock is only taken briefly,
+twice per chunk, to check whether the world has loaded the chunk or is loading it.
+
+The area is processed one region (32 x 32 chunks, a single MCA file) at a time, row by row within the region.
+Lighting a chunk needs its 3x3 neighborhood, so the last few rows of generated chunks are kept in a small cache;
+neighbors outside the area are generated for the lighting only and are never saved.
+Chunks that are already stored, or that the world has loaded or is loading, are skipped.
+
+The job is written into pregen.ini in the world folder after each region, so that it is resumed after a server restart.
+Progress is logged periodically and can be queried from the console and plugins.
+*/
+
+
+
+
+
+#pragma once
+
+#include "OSSupport/IsThread.h"
+#include "ChunkDef.h"
+#include "ChunkPregeneratorJob.h"
+
+
+
+
+
+// fwd:
+class cChunkDataCallback;
+class cChunkDesc;
+class cChunkGenerator;
+class cIniFile;
+class cLightingThread;
+class cWorld;
+struct SetChunkData;
+
+
+
+
+
+class cChunkPregenerator:
+	public cIsThread
+{
+	using Super = cIsThread;
+
+public:
+
+	cChunkPregenerator(cWorld & a_World);
+	virtual ~cChunkPregenerator() override;
+
+	/** Reads the throttling settings from the world's ini file, writing the defaults if not present. */
+	void Initialize(cIniFile & a_IniFile);
+
+	/** Starts pregenerating the rectangle between the two chunks (inclusive), region by region in rows.
+	Returns false if a pregeneration is already running. */
+	bool StartSquare(int a_Chunk1X, int a_Chunk1Z, int a_Chunk2X, int a_Chunk2Z);
+
+	/** Starts pregenerating the square of chunks within a_Radius of the center chunk, regions in an outward spiral.
+	Returns false if a pregeneration is already running. */
+	bool StartSpiral(int a_CenterChunkX, int a_CenterChunkZ, int a_Radius);
+
+	/** Resumes the pregeneration that was interrupted by the server stopping, if there was any. */
+	void ResumeIfInterrupted(void);
+
+	/** Signals the pregeneration to stop and forgets it, so that it isn't resumed on the next start.
+	Doesn't wait for the thread to finish, the thread may be waiting for the caller (in a plugin hook, for example).
+	Returns false if there was no pregeneration running. */
+	bool Cancel(void);
+
+	/** Stops the thread, keeping the saved job so that it is resumed on the next start. */
+	void Stop(void);  // Hide the cIsThread's Stop() method, we need to wake up the throttling
+
+	bool IsRunning(void) const { return m_IsRunning; }
+
+	/** Returns the number of chunks of the area that have been processed (either generated or skipped). */
+	size_t GetNumChunksDone(void) const { return m_NumChunksDone; }
+
+	/** Returns the number of chunks in the area of the current (or last) pregeneration, 0 if there was none. */
+	size_t GetNumChunksTotal(void) const;
+
+	/** Returns a single-line human readable description of the pregeneration progress. */
+	AString GetStatus(void) const;
+
+protected:
+
+	using eShape = cChunkPregeneratorJob::eShape;
+
+	/** A generated chunk kept for lighting its neighbors. */
+	struct sCachedChunk
+	{
+		std::unique_ptr<SetChunkData> m_Data;
+
+		/** Value of m_UseCounter when the chunk was last used, for evicting the least recently used chunk. */
+		UInt64 m_LastUsed;
+	};
+
+	using cClock = std::chrono::steady_clock;
+
+
+	cWorld & m_World;
+
+	/** Protects m_Job against the console and plugins reading it. */
+	mutable cCriticalSection m_CS;
+
+	/** Set from the job start until the thread finishes the job or is stopped. */
+	std::atomic<bool> m_IsRunning;
+
+	/** Set by Cancel(), the thread deletes the saved job when it terminates. */
+	std::atomic<bool> m_IsCancelled;
+
+	/** The area being pregenerated and the progress through its regions, saved after each region for resuming. */
+	cChunkPregeneratorJob m_Job;
+
+	std::atomic<size_t> m_NumChunksDone;
+	std::atomic<size_t> m_NumChunksGenerated;
+	std::atomic<size_t> m_NumChunksSkipped;
+	std::atomic<size_t> m_NumChunksFailed;
+	std::atomic<UInt64> m_NumBytesWritten;
+
+	/** When the current job was started (or resumed), with the chunk count at that time, for the speed in reports. Protected by m_CS. */
+	cClock::time_point m_StartTime;
+	size_t m_NumChunksDoneAtStart;
+
+	cClock::time_point m_LastReport;
+
+	/** Set to wake the thread up from the throttling sleeps when it should terminate. */
+	cEvent m_evtWakeUp;
+
+	// Throttling settings, read from the world's ini file:
+	/** Maximum number of chunks generated per second (including the neighbors generated only for lighting), 0 for unlimited. */
+	std::atomic<int> m_MaxChunksPerSec;
+
+	/** Maximum amount of (compressed) chunk data written per second, 0 for unlimited. */
+	std::atomic<int> m_MaxWriteKiBPerSec;
+
+	/** If true, the pregenerator pauses while the world's own generator has chunks queued, so that players don't wait for it. */
+	std::atomic<bool> m_ShouldYieldToWorld;
+
+	/** Earliest time when the next chunk may be generated, or written, according to the throttling. */
+	cClock::time_point m_NextGenerateTime;
+	cClock::time_point m_NextWriteTime;
+
+	// The following are used only by the thread, and exist only while a job is being processed:
+	std::unique_ptr<cChunkGenerator> m_Generator;
+	std::unique_ptr<cChunkDesc> m_ChunkDesc;
+
+	/** Never started, used only for its light calculation and buffers (which are too large to be allocated on the stack). */
+	std::unique_ptr<cLightingThread> m_Lighting;
+
+	std::unordered_map<cChunkCoords, sCachedChunk, cChunkCoordsHash> m_Cache;
+	UInt64 m_UseCounter;
+
+
+	// cIsThread override:
+	virtual void Execute(void) override;
+
+	/** Starts the thread processing the specified job, unless there's a job running already.
+	A resumed job continues from its m_NextRegion. */
+	bool StartJob(const cChunkPregeneratorJob & a_Job);
+
+	/** Generates and saves the chunks of the area within the specified region. */
+	void ProcessRegion(cChunkCoords a_Region);
+
+	/** Generates, lights and saves the specified chunk, unless it has already been stored or loaded. */
+	void ProcessChunk(cChunkCoords a_Coords);
+
+	/** Returns the generated chunk from the cache, generating it if not present.
+	The references to the 9 most recently returned chunks stay valid until the next call. */
+	SetChunkData & GetGeneratedChunk(cChunkCoords a_Coords);
+
+	/** Generates the specified chunk, including the plugin hooks, the same way the world's generator does. */
+	std::unique_ptr<SetChunkData> GenerateChunk(cChunkCoords a_Coords);
+
+	/** Sleeps until a_Time or until the thread should terminate. */
+	void SleepUntil(cClock::time_point a_Time);
+
+	/** Logs the progress if enough time has passed since the last report. */
+	void ReportProgress(void);
+
+	/** Returns the name of the file where the job is saved for resuming. */
+	AString GetStateFileName(void) const;
+
+	/** Saves the job and its progress into the state file. */
+	void SaveState(void);
+
+	/** Feeds the chunk data into the callback, in the same order as cChunk::GetAllData() does. */
+	static void FeedChunkData(const SetChunkData & a_Data, cChunkDataCallback & a_Callback);
+};
+
+
+
+
@@ -0,0 +1,171 @@
+
+// ChunkPregeneratorJob.cpp
+
+// Implements the cChunkPregeneratorJob class describing the area of a pregeneration and the progress through it
+
+#include "Globals.h"
+#include "ChunkPregeneratorJob.h"
+#include "IniFile.h"
+
+
+
+
+
+cChunkPregeneratorJob::cChunkPregeneratorJob(void):
+	m_Shape(eShape::Square),
+	m_MinChunkX(0),
+	m_MinChunkZ(0),
+	m_MaxChunkX(0),
+	m_MaxChunkZ(0),
+	m_NextRegion(0),
+	m_NumChunksDoneBeforeRegion(0)
+{
+}
+
+
+
+
+
+cChunkPregeneratorJob::cChunkPregeneratorJob(eShape a_Shape, int a_MinChunkX, int a_MinChunkZ, int a_MaxChunkX, int a_MaxChunkZ):
+	m_Shape(a_Shape),
+	m_MinChunkX(std::min(a_MinChunkX, a_MaxChunkX)),
+	m_MinChunkZ(std::min(a_MinChunkZ, a_MaxChunkZ)),
+	m_MaxChunkX(std::max(a_MinChunkX, a_MaxChunkX)),
+	m_MaxChunkZ(std::max(a_MinChunkZ, a_MaxChunkZ)),
+	m_NextRegion(0),
+	m_NumChunksDoneBeforeRegion(0)
+{
+	CalcRegions();
+}
+
+
+
+
+
+bool cChunkPregeneratorJob::Load(const cIniFile & a_State)
+{
+	if (a_State.FindKey("Pregenerator") == cIniFile::noID)
+	{
+		return false;
+	}
+
+	size_t NextRegion = 0, NumChunksDone = 0;
+	StringToInteger(a_State.GetValue("Pregenerator", "NextRegion"), NextRegion);
+	StringToInteger(a_State.GetValue("Pregenerator", "NumChunksDone"), NumChunksDone);
+	*this = cChunkPregeneratorJob(
+		(NoCaseCompare(a_State.GetValue("Pregenerator", "Shape"), "spiral") == 0) ? eShape::Spiral : eShape::Square,
+		a_State.GetValueI("Pregenerator", "MinChunkX"), a_State.GetValueI("Pregenerator", "MinChunkZ"),
+		a_State.GetValueI("Pregenerator", "MaxChunkX"), a_State.GetValueI("Pregenerator", "MaxChunkZ")
+	);
+	m_NextRegion = std::min(NextRegion, m_Regions.size());
+	m_NumChunksDoneBeforeRegion = NumChunksDone;
+	return true;
+}
+
+
+
+
+
+void cChunkPregeneratorJob::Save(cIniFile & a_State) const
+{
+	a_State.SetValue ("Pregenerator", "Shape",         GetShapeName());
+	a_State.SetValueI("Pregenerator", "MinChunkX",     m_MinChunkX);
+	a_State.SetValueI("Pregenerator", "MinChunkZ",     m_MinChunkZ);
+	a_State.SetValueI("Pregenerator", "MaxChunkX",     m_MaxChunkX);
+	a_State.SetValueI("Pregenerator", "MaxChunkZ",     m_MaxChunkZ);
+	a_State.SetValue ("Pregenerator", "NextRegion",    std::to_string(m_NextRegion));
+	a_State.SetValue ("Pregenerator", "NumChunksDone", std::to_string(m_NumChunksDoneBeforeRegion));
+}
+
+
+
+
+
+void cChunkPregeneratorJob::FinishRegion(size_t a_NumChunksDone)
+{
+	ASSERT(!IsFinished());
+	m_NextRegion += 1;
+	m_NumChunksDoneBeforeRegion = a_NumChunksDone;
+}
+
+
+
+
+
+void cChunkPregeneratorJob::GetRegionArea(cChunkCoords a_Region, int & a_MinChunkX, int & a_MinChunkZ, int & a_MaxChunkX, int & a_MaxChunkZ) const
+{
+	a_MinChunkX = std::max(m_MinChunkX, a_Region.m_ChunkX * RegionWidth);
+	a_MinChunkZ = std::max(m_MinChunkZ, a_Region.m_ChunkZ * RegionWidth);
+	a_MaxChunkX = std::min(m_MaxChunkX, a_Region.m_ChunkX * RegionWidth + RegionWidth - 1);
+	a_MaxChunkZ = std::min(m_MaxChunkZ, a_Region.m_ChunkZ * RegionWidth + RegionWidth - 1);
+}
+
+
+
+
+
+size_t cChunkPregeneratorJob::GetNumChunks(void) const
+{
+	if (m_Regions.empty())
+	{
+		return 0;
+	}
+	return
+		static_cast<size_t>(static_cast<Int64>(m_MaxChunkX) - m_MinChunkX + 1) *
+		static_cast<size_t>(static_cast<Int64>(m_MaxChunkZ) - m_MinChunkZ + 1);
+}
+
+
+
+
+
+const char * cChunkPregeneratorJob::GetShapeName(void) const
+{
+	return (m_Shape == eShape::Spiral) ? "spiral" : "square";
+}
+
+
+
+
+
+void cChunkPregeneratorJob::CalcRegions(void)
+{
+	const int MinRegionX = FAST_FLOOR_DIV(m_MinChunkX, RegionWidth);
+	const int MinRegionZ = FAST_FLOOR_DIV(m_MinChunkZ, RegionWidth);
+	const int MaxRegionX = FAST_FLOOR_DIV(m_MaxChunkX, RegionWidth);
+	const int MaxRegionZ = FAST_FLOOR_DIV(m_MaxChunkZ, RegionWidth);
+	m_Regions.clear();
+	for (int z = MinRegionZ; z <= MaxRegionZ; z++)
+	{
+		for (int x = MinRegionX; x <= MaxRegionX; x++)
+		{
+			m_Regions.emplace_back(x, z);
+		}
+	}
+	if (m_Shape == eShape::Square)
+	{
+		return;
+	}
+
+	// Spiral: order the regions by the ring around the center region, then by the angle within the ring:
+	const int CenterX = FAST_FLOOR_DIV(m_MinChunkX + (m_MaxChunkX - m_MinChunkX) / 2, RegionWidth);
+	const int CenterZ = FAST_FLOOR_DIV(m_MinChunkZ + (m_MaxChunkZ - m_MinChunkZ) / 2, RegionWidth);
+	std::stable_sort(m_Regions.begin(), m_Regions.end(), [CenterX, CenterZ](const cChunkCoords & a_First, const cChunkCoords & a_Second)
+		{
+			const int FirstRing = std::max(std::abs(a_First.m_ChunkX - CenterX), std::abs(a_First.m_ChunkZ - CenterZ));
+			const int SecondRing = std::max(std::abs(a_Second.m_ChunkX - CenterX), std::abs(a_Second.m_ChunkZ - CenterZ));
+			if (FirstRing != SecondRing)
+			{
+				return (FirstRing < SecondRing);
+			}
+			return (
+				std::atan2(a_First.m_ChunkZ - CenterZ, a_First.m_ChunkX - CenterX) <
+				std::atan2(a_Second.m_ChunkZ - CenterZ, a_Second.m_ChunkX - CenterX)
+			);
+		}
+	);
+}
+
+
+
+
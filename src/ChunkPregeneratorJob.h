@@ -0,0 +1,93 @@
+// ChunkPregeneratorJob.h
+
+// Declares the cChunkPregeneratorJob class describing the area of a pregeneration and the progress through it
+
+
+
+
+
+#pragma once
+
+#include "ChunkDef.h"
+
+
+
+
+
+// fwd:
+class cIniFile;
+
+
+
+
+
+/** The area to pregenerate, the order in which its regions are processed, and the progress through them.
+This is what gets saved into the state file for resuming the pregeneration after a restart.
+Kept separate from cChunkPregenerator, which needs a live world, so that it can be tested on its own. */
+class cChunkPregeneratorJob
+{
+public:
+
+	enum class eShape
+	{
+		Square,
+		Spiral,
+	};
+
+	/** Width of a region (a single MCA file), in chunks. */
+	static constexpr int RegionWidth = 32;
+
+
+	/** Creates an empty job, with no regions to process. */
+	cChunkPregeneratorJob(void);
+
+	/** Creates a job for the area between the two chunks (inclusive), starting at its first region.
+	The Square shape processes the regions in rows, the Spiral shape in rings outward from the center region. */
+	cChunkPregeneratorJob(eShape a_Shape, int a_MinChunkX, int a_MinChunkZ, int a_MaxChunkX, int a_MaxChunkZ);
+
+	/** Reads the job saved by Save(); the region that was being processed when saving is processed anew.
+	Returns false if a_State doesn't contain a job, leaving this object unchanged. */
+	bool Load(const cIniFile & a_State);
+
+	/** Writes the job and its progress into a_State. */
+	void Save(cIniFile & a_State) const;
+
+	/** Marks the region at m_NextRegion as done, a_NumChunksDone is the total count of chunks done so far. */
+	void FinishRegion(size_t a_NumChunksDone);
+
+	/** Returns true if all the regions have been processed. */
+	bool IsFinished(void) const { return (m_NextRegion >= m_Regions.size()); }
+
+	/** Returns the chunks of the job's area that lie within the specified region, in chunk coords, inclusive. */
+	void GetRegionArea(cChunkCoords a_Region, int & a_MinChunkX, int & a_MinChunkZ, int & a_MaxChunkX, int & a_MaxChunkZ) const;
+
+	/** Returns the number of chunks in the job's area, 0 for an empty job. */
+	size_t GetNumChunks(void) const;
+
+	/** Returns the name of the job's shape, as used in the state file and status. */
+	const char * GetShapeName(void) const;
+
+
+	eShape m_Shape;
+
+	/** The area to pregenerate, in chunk coords, inclusive. */
+	int m_MinChunkX, m_MinChunkZ, m_MaxChunkX, m_MaxChunkZ;
+
+	/** Coords of the regions to process, in the processing order. */
+	std::vector<cChunkCoords> m_Regions;
+
+	/** Index into m_Regions of the region being processed. */
+	size_t m_NextRegion;
+
+	/** Number of chunks done when the region at m_NextRegion was started. */
+	size_t m_NumChunksDoneBeforeRegion;
+
+protected:
+
+	/** Fills m_Regions based on the shape and area. */
+	void CalcRegions(void);
+};
+
+
+
+
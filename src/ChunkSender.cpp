@@ -61,7 +61,8 @@ public:
 cChunkSender::cChunkSender(cWorld & a_World) :
 	Super("Chunk Sender"),
 	m_World(a_World),
-	m_Serializer(m_World.GetDimension())
+	m_Serializer(m_World.GetDimension()),
+	m_Revision(0)
 {
 }
 
@@ -238,7 +239,7 @@ void cChunkSender::SendChunk(int a_ChunkX, int a_ChunkZ, const WeakClients & a_C
 	}
 
 	// Send:
-	m_Serializer.SendToClients(a_ChunkX, a_ChunkZ, m_BlockData, m_LightData, m_BiomeMap, m_BlockEntities, m_HeightMap, Clients);
+	m_Serializer.SendToClients(a_ChunkX, a_ChunkZ, m_Revision, m_BlockData, m_LightData, m_BiomeMap, m_BlockEntities, m_HeightMap, Clients);
 
 	for (const auto & Client : Clients)
 	{
@@ -313,6 +314,15 @@ void cChunkSender::Entity(cEntity * a_Entity)
 
 
 
+void cChunkSender::Revision(UInt64 a_Revision)
+{
+	m_Revision = a_Revision;
+}
+
+
+
+
+
 void cChunkSender::BiomeMap(const cChunkDef::BiomeMap & a_BiomeMap)
 {
 	for (size_t i = 0; i < ARRAYCOUNT(m_BiomeMap); i++)
@@ -116,6 +116,7 @@ protected:
 
 	// Data about the chunk that is being sent:
 	// NOTE that m_BlockData[] is inherited from the cChunkDataCollector
+	UInt64 m_Revision;  // Modification revision, used by the serializer's packet cache
 	unsigned char m_BiomeMap[cChunkDef::Width * cChunkDef::Width];
 	std::vector<cBlockEntity *> m_BlockEntities;  // Coords of the block entities to send
 	std::vector<UInt32> m_EntityIDs;        // Entity-IDs of the entities to send
@@ -126,6 +127,7 @@ protected:
 
 	// cChunkDataCollector overrides:
 	// (Note that they are called while the ChunkMap's CS is locked - don't do heavy calculations here!)
+	virtual void Revision     (UInt64 a_Revision) override;
 	virtual void BiomeMap     (const cChunkDef::BiomeMap & a_BiomeMap) override;
 	virtual void Entity       (cEntity *      a_Entity) override;
 	virtual void BlockEntity  (cBlockEntity * a_Entity) override;
@@ -61,6 +61,25 @@ Compression::Result CircularBufferExtractor::Extract(size_t UncompressedSize)
 
 
 
+ContiguousByteBufferView CircularBufferExtractor::ExtractView(size_t UncompressedSize)
+{
+	// Don't keep holding a lot of memory after a single huge packet:
+	static const size_t MaxRetainedSize = 128 KiB;
+	if ((m_Extracted.capacity() > MaxRetainedSize) && (UncompressedSize <= MaxRetainedSize))
+	{
+		m_Extracted.clear();
+		m_Extracted.shrink_to_fit();
+	}
+
+	m_Extracted.resize(UncompressedSize);
+	m_Extractor.ExtractZLib(m_ContiguousIntermediate, m_Extracted.data(), UncompressedSize);
+	return m_Extracted;
+}
+
+
+
+
+
 void CircularBufferExtractor::ReadFrom(cByteBuffer & Buffer, size_t Size)
 {
 	Buffer.ReadSome(m_ContiguousIntermediate, Size);
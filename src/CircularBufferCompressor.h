@@ -42,8 +42,13 @@ public:
 	Compression::Result Extract(size_t UncompressedSize);
 	void ReadFrom(cByteBuffer & Buffer, size_t Size);
 
+	/** Extracts the data into a buffer that is reused by the next extraction.
+	The returned view is valid until the next call. */
+	ContiguousByteBufferView ExtractView(size_t UncompressedSize);
+
 private:
 
 	Compression::Extractor m_Extractor;
 	std::basic_string<std::byte> m_ContiguousIntermediate;
+	std::basic_string<std::byte> m_Extracted;
 };
@@ -248,7 +248,6 @@ void cClientHandle::ProxyInit(const AString & a_IPString, const cUUID & a_UUID,
 void cClientHandle::ProcessProtocolIn(void)
 {
 	// Process received network data:
-	decltype(m_IncomingData) IncomingData;
 	{
 		cCSLock Lock(m_CSIncomingData);
 
@@ -258,17 +257,19 @@ void cClientHandle::ProcessProtocolIn(void)
 			return;
 		}
 
-		std::swap(IncomingData, m_IncomingData);
+		// Swap with the buffer processed last time, so that both keep their capacity:
+		std::swap(m_IncomingDataProcessed, m_IncomingData);
 	}
 
 	try
 	{
-		m_Protocol.HandleIncomingData(*this, IncomingData);
+		m_Protocol.HandleIncomingData(*this, m_IncomingDataProcessed);
 	}
 	catch (const std::exception & Oops)
 	{
 		Kick(Oops.what());
 	}
+	m_IncomingDataProcessed.clear();
 }
 
 
@@ -1525,7 +1526,7 @@ void cClientHandle::HandleRightClick(Vector3i a_BlockPos, eBlockFace a_BlockFace
 
 
 
-void cClientHandle::HandleChat(const AString & a_Message)
+void cClientHandle::HandleChat(const std::string_view a_Message)
 {
 	if ((a_Message.size()) > MAX_CHAT_MSG_LENGTH)
 	{
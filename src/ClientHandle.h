@@ -336,7 +336,7 @@ public:  // tolua_export
 	void HandleBeaconSelection(unsigned a_PrimaryEffect, unsigned a_SecondaryEffect);
 
 	/** Called when the protocol detects a chat packet. */
-	void HandleChat(const AString & a_Message);
+	void HandleChat(std::string_view a_Message);
 
 	/** Called when the protocol receives a message, indicating that the player set a new
 	command in the command block UI, for a block-based commandblock. */
@@ -524,6 +524,10 @@ private:
 	Protected by m_CSIncomingData. */
 	ContiguousByteBuffer m_IncomingData;
 
+	/** The incoming data being processed in ProcessProtocolIn(), swapped with m_IncomingData.
+	Kept between the calls only for its capacity, so that receiving data doesn't allocate. */
+	ContiguousByteBuffer m_IncomingDataProcessed;
+
 	/** Protects m_OutgoingData against multithreaded access. */
 	cCriticalSection m_CSOutgoingData;
 
@@ -409,6 +409,7 @@ void cCraftingRecipes::LoadRecipes(void)
 		}
 		AddRecipeLine(LineNum, Recipe);
 	}  // for itr - Split[]
+	BuildRecipeIndex();
 	LOG("Loaded %zu crafting recipes", m_Recipes.size());
 }
 
@@ -438,6 +439,7 @@ void cCraftingRecipes::ClearRecipes(void)
 		delete *itr;
 	}
 	m_Recipes.clear();
+	m_RecipeIndex.clear();
 }
 
 
@@ -662,6 +664,84 @@ void cCraftingRecipes::NormalizeIngredients(cCraftingRecipes::cRecipe * a_Recipe
 
 
 
+cCraftingRecipes::cRecipeSignature cCraftingRecipes::GetRecipeSignature(const cRecipe & a_Recipe)
+{
+	// Each distinct regular cell is occupied by one item, each "anywhere" ingredient occupies a cell of its own.
+	// Regular ingredients sharing a cell are all matched against the same grid item, the first one is representative:
+	std::vector<Item> ItemTypes;
+	bool IsCellUsed[MAX_GRID_WIDTH][MAX_GRID_HEIGHT] = {};
+	for (const auto & Slot: a_Recipe.m_Ingredients)
+	{
+		if ((Slot.x >= 0) && (Slot.y >= 0))
+		{
+			if ((Slot.x >= MAX_GRID_WIDTH) || (Slot.y >= MAX_GRID_HEIGHT) || IsCellUsed[Slot.x][Slot.y])
+			{
+				continue;
+			}
+			IsCellUsed[Slot.x][Slot.y] = true;
+		}
+		ItemTypes.push_back(Slot.m_Item.m_ItemType);
+	}
+	return MakeSignature(ItemTypes.data(), ItemTypes.size());
+}
+
+
+
+
+
+cCraftingRecipes::cRecipeSignature cCraftingRecipes::GetGridSignature(const cItem * a_CraftingGrid, int a_GridWidth, int a_GridHeight, int a_GridStride)
+{
+	std::array<Item, MAX_GRID_WIDTH * MAX_GRID_HEIGHT> ItemTypes;
+	size_t NumItemTypes = 0;
+	for (int y = 0; y < a_GridHeight; y++) for (int x = 0; x < a_GridWidth; x++)
+	{
+		const auto & GridItem = a_CraftingGrid[x + a_GridStride * y];
+		if (!GridItem.IsEmpty())
+		{
+			ItemTypes[NumItemTypes++] = GridItem.m_ItemType;
+		}
+	}
+	return MakeSignature(ItemTypes.data(), NumItemTypes);
+}
+
+
+
+
+
+cCraftingRecipes::cRecipeSignature cCraftingRecipes::MakeSignature(Item * a_ItemTypes, size_t a_NumItemTypes)
+{
+	// FNV-1a over the sorted item types, prefixed with their count:
+	std::sort(a_ItemTypes, a_ItemTypes + a_NumItemTypes);
+	cRecipeSignature Signature = 14695981039346656037ULL;
+	auto Mix = [&Signature](UInt64 a_Value)
+	{
+		Signature = (Signature ^ a_Value) * 1099511628211ULL;
+	};
+	Mix(a_NumItemTypes);
+	for (size_t i = 0; i < a_NumItemTypes; i++)
+	{
+		Mix(static_cast<UInt64>(a_ItemTypes[i]));
+	}
+	return Signature;
+}
+
+
+
+
+
+void cCraftingRecipes::BuildRecipeIndex(void)
+{
+	m_RecipeIndex.clear();
+	for (const auto Recipe: m_Recipes)
+	{
+		m_RecipeIndex[GetRecipeSignature(*Recipe)].push_back(Recipe);
+	}
+}
+
+
+
+
+
 cCraftingRecipes::cRecipe * cCraftingRecipes::FindRecipe(const cItem * a_CraftingGrid, int a_GridWidth, int a_GridHeight)
 {
 	ASSERT(a_GridWidth <= MAX_GRID_WIDTH);
@@ -680,6 +760,11 @@ cCraftingRecipes::cRecipe * cCraftingRecipes::FindRecipe(const cItem * a_Craftin
 			GridTop    = std::min(y, GridTop);
 		}
 	}
+	if ((GridLeft > GridRight) || (GridTop > GridBottom))
+	{
+		// Empty grid
+		return nullptr;
+	}
 	int GridWidth = GridRight - GridLeft + 1;
 	int GridHeight = GridBottom - GridTop + 1;
 
@@ -707,7 +792,14 @@ cCraftingRecipes::cRecipe * cCraftingRecipes::FindRecipe(const cItem * a_Craftin
 
 cCraftingRecipes::cRecipe * cCraftingRecipes::FindRecipeCropped(const cItem * a_CraftingGrid, int a_GridWidth, int a_GridHeight, int a_GridStride)
 {
-	for (cRecipes::const_iterator itr = m_Recipes.begin(); itr != m_Recipes.end(); ++itr)
+	// Only the recipes occupying the same item types as the grid can match:
+	auto Candidates = m_RecipeIndex.find(GetGridSignature(a_CraftingGrid, a_GridWidth, a_GridHeight, a_GridStride));
+	if (Candidates == m_RecipeIndex.end())
+	{
+		return nullptr;
+	}
+
+	for (auto itr = Candidates->second.begin(); itr != Candidates->second.end(); ++itr)
 	{
 		// Both the crafting grid and the recipes are normalized. The only variable possible is the "anywhere" items.
 		// This still means that the "anywhere" item may be the one that is offsetting the grid contents to the right or downwards, so we need to check all possible positions.
@@ -725,7 +817,7 @@ cCraftingRecipes::cRecipe * cCraftingRecipes::FindRecipeCropped(const cItem * a_
 				return Recipe;
 			}
 		}  // for y, for x
-	}  // for itr - m_Recipes[]
+	}  // for itr - Candidates[]
 
 	// No matching recipe found
 	return nullptr;
@@ -769,7 +861,14 @@ cCraftingRecipes::cRecipe * cCraftingRecipes::MatchRecipe(const cItem * a_Crafti
 	// Process the "Anywhere" items now, and only in the cells that haven't matched yet
 	// The "anywhere" items are processed on a first-come-first-served basis.
 	// Do not use a recipe with one horizontal and one vertical "anywhere" ("*:1, 1:*") as it may not match properly!
-	cRecipeSlots MatchedSlots;  // Stores the slots of "anywhere" items that have matched, with the match coords
+	// Stores the "anywhere" items that have matched, with the match coords; the slots are only created once the whole recipe matches:
+	struct sAnywhereMatch
+	{
+		const cRecipeSlot * m_Slot;
+		int x, y;
+	};
+	std::array<sAnywhereMatch, MAX_GRID_WIDTH * MAX_GRID_HEIGHT> AnywhereMatches;
+	size_t NumAnywhereMatches = 0;
 	for (cRecipeSlots::const_iterator itrS = a_Recipe->m_Ingredients.begin(); itrS != a_Recipe->m_Ingredients.end(); ++itrS)
 	{
 		if ((itrS->x >= 0) && (itrS->y >= 0))
@@ -805,11 +904,10 @@ cCraftingRecipes::cRecipe * cCraftingRecipes::MatchRecipe(const cItem * a_Crafti
 					// TODO: compare comps
 				)
 				{
+					// Each match takes an unmatched cell, so there can't be more matches than cells:
 					HasMatched[x][y] = true;
 					Found = true;
-					MatchedSlots.push_back(*itrS);
-					MatchedSlots.back().x = x;
-					MatchedSlots.back().y = y;
+					AnywhereMatches[NumAnywhereMatches++] = { &*itrS, x, y };
 					break;
 				}
 			}  // for y
@@ -850,7 +948,12 @@ cCraftingRecipes::cRecipe * cCraftingRecipes::MatchRecipe(const cItem * a_Crafti
 		Recipe->m_Ingredients.back().x += a_OffsetX;
 		Recipe->m_Ingredients.back().y += a_OffsetY;
 	}
-	Recipe->m_Ingredients.insert(Recipe->m_Ingredients.end(), MatchedSlots.begin(), MatchedSlots.end());
+	for (size_t i = 0; i < NumAnywhereMatches; i++)
+	{
+		Recipe->m_Ingredients.push_back(*AnywhereMatches[i].m_Slot);
+		Recipe->m_Ingredients.back().x = AnywhereMatches[i].x;
+		Recipe->m_Ingredients.back().y = AnywhereMatches[i].y;
+	}
 
 	// Handle the fireworks-related effects:
 	// We use Recipe instead of a_Recipe because we want the wildcard ingredients' slot numbers as well, which was just added previously
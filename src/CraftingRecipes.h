@@ -159,8 +159,15 @@ protected:
 
 	typedef std::vector<cRecipe *> cRecipes;
 
+	/** Hash of the multiset of item types occupying the grid cells, see GetRecipeSignature() and GetGridSignature(). */
+	typedef UInt64 cRecipeSignature;
+
 	cRecipes m_Recipes;
 
+	/** All the recipes, grouped by their signature, in the m_Recipes order.
+	A grid can only match recipes with the same signature as the grid, so only those need to be verified. */
+	std::unordered_map<cRecipeSignature, std::vector<const cRecipe *>> m_RecipeIndex;
+
 	void LoadRecipes(void);
 	void ClearRecipes(void);
 
@@ -176,10 +183,24 @@ protected:
 	/** Moves the recipe to top-left corner, sets its MinWidth / MinHeight */
 	void NormalizeIngredients(cRecipe * a_Recipe);
 
+	/** Returns the signature of the grid cells that the recipe occupies when matched:
+	one item type per distinct regular ingredient cell, plus one per "anywhere" ingredient. */
+	static cRecipeSignature GetRecipeSignature(const cRecipe & a_Recipe);
+
+	/** Returns the signature of the non-empty cells in the grid. Doesn't allocate. */
+	static cRecipeSignature GetGridSignature(const cItem * a_CraftingGrid, int a_GridWidth, int a_GridHeight, int a_GridStride);
+
+	/** Returns the signature of the specified item types; the array is sorted in place. */
+	static cRecipeSignature MakeSignature(Item * a_ItemTypes, size_t a_NumItemTypes);
+
+	/** Rebuilds m_RecipeIndex from m_Recipes. */
+	void BuildRecipeIndex(void);
+
 	/** Finds a recipe matching the crafting grid. Returns a newly allocated recipe (with all its coords set) or nullptr if not found. Caller must delete return value! */
 	cRecipe * FindRecipe(const cItem * a_CraftingGrid, int a_GridWidth, int a_GridHeight);
 
-	/** Same as FindRecipe, but the grid is guaranteed to be of minimal dimensions needed */
+	/** Same as FindRecipe, but the grid is guaranteed to be of minimal dimensions needed.
+	Only verifies the recipes from m_RecipeIndex that have the same signature as the grid. */
 	cRecipe * FindRecipeCropped(const cItem * a_CraftingGrid, int a_GridWidth, int a_GridHeight, int a_GridStride);
 
 	/** Checks if the grid matches the specified recipe, offset by the specified offsets. Returns a matched cRecipe * if so, or nullptr if not matching. Caller must delete the return value! */
@@ -44,6 +44,8 @@ cEntity::cEntity(eEntityType a_EntityType, Vector3d a_Pos, float a_Width, float
 	m_bDirtyOrientation(false),
 	m_bHasSentNoSpeed(true),
 	m_bOnGround(false),
+	m_IsAtRest(false),
+	m_TicksUntilRestCheck(0),
 	m_Gravity(-9.81f),
 	m_AirDrag(0.02f),
 	m_LastSentPosition(a_Pos),
@@ -1027,6 +1029,16 @@ void cEntity::Tick(std::chrono::milliseconds a_Dt, cChunk & a_Chunk)
 
 void cEntity::HandlePhysics(std::chrono::milliseconds a_Dt, cChunk & a_Chunk)
 {
+	if (m_IsAtRest)
+	{
+		// Nothing around us has changed, so the physics would leave us where we are; re-check once in a while anyway:
+		if (--m_TicksUntilRestCheck > 0)
+		{
+			return;
+		}
+		WakeUp();
+	}
+
 	int BlockX = POSX_TOINT;
 	int BlockY = POSY_TOINT;
 	int BlockZ = POSZ_TOINT;
@@ -1243,8 +1255,43 @@ void cEntity::HandlePhysics(std::chrono::milliseconds a_Dt, cChunk & a_Chunk)
 		}
 	}
 
+	const bool HasMoved = (NextPos != GetPosition());
 	SetPosition(NextPos);
 	SetSpeed(NextSpeed);
+
+	// Pickups and orbs lying still on the ground stay that way until something wakes them up (cChunk::SetBlock(), SetSpeed(), SetPosition()):
+	if (
+		(IsPickup() || IsExpOrb()) &&
+		m_bOnGround &&
+		!HasMoved &&
+		(NextSpeed.SqrLength() == 0.0) &&
+		!cBlockInfo::IsSolid(BlockIn) &&
+		(m_ParentChunk != nullptr)
+	)
+	{
+		m_IsAtRest = true;
+		m_RestingBlockPos = GetPosition().Floor();
+		m_TicksUntilRestCheck = REST_RECHECK_TICKS;
+		m_ParentChunk->AddRestingEntity(m_RestingBlockPos, *this);
+	}
+}
+
+
+
+
+
+void cEntity::WakeUp(void)
+{
+	if (!m_IsAtRest)
+	{
+		return;
+	}
+	m_IsAtRest = false;
+
+	if (m_ParentChunk != nullptr)
+	{
+		m_ParentChunk->RemoveRestingEntity(m_RestingBlockPos, *this);
+	}
 }
 
 
@@ -2182,6 +2229,12 @@ void cEntity::SetSpeed(double a_SpeedX, double a_SpeedY, double a_SpeedZ)
 {
 	m_Speed.Set(a_SpeedX, a_SpeedY, a_SpeedZ);
 	WrapSpeed();
+
+	if (m_Speed.SqrLength() > 0.0)
+	{
+		// Pushed, the physics need to run again:
+		WakeUp();
+	}
 }
 
 
@@ -2314,6 +2367,12 @@ void cEntity::SetPosition(const Vector3d & a_Position)
 
 	m_LastPosition = m_Position;
 	m_Position = {ClampedPosX, ClampedPosY, ClampedPosZ};
+
+	if (m_Position != m_LastPosition)
+	{
+		// Moved (teleported, by a plugin, ...), the physics need to run again:
+		WakeUp();
+	}
 }
 
 
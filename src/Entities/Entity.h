@@ -98,6 +98,8 @@ public:
 	static const int VOID_BOUNDARY         = -64;  ///< Y position to begin applying void damage
 	static const int FALL_DAMAGE_HEIGHT    = 4;    ///< Y difference after which fall damage is applied
 
+	static const int REST_RECHECK_TICKS    = 20;   ///< Ticks after which an entity at rest re-runs its physics, in case a wake-up was missed
+
 	/** Special ID that is considered an "invalid value", signifying no entity. */
 	static const UInt32 INVALID_ID = 0;  // Exported to Lua in ManualBindings.cpp, ToLua doesn't parse initialized constants.
 
@@ -496,6 +498,13 @@ public:
 
 	// tolua_end
 
+	/** Returns true if the entity is lying still and its physics are skipped until something around it changes. */
+	bool IsAtRest(void) const { return m_IsAtRest; }
+
+	/** Makes an entity at rest run its physics again on the next tick, and removes it from its chunk's index of resting entities.
+	Called when a block near the entity changes, or when the entity is moved, pushed or leaves its chunk. */
+	void WakeUp(void);
+
 	/** Called when the specified player right-clicks this entity */
 	virtual void OnRightClicked(cPlayer & a_Player) {}
 
@@ -579,6 +588,17 @@ protected:
 	/** Stores if the entity is on the ground */
 	bool m_bOnGround;
 
+	/** Stores if the entity is lying still on the ground, HandlePhysics() does nothing in such a case.
+	Only pickups and experience orbs ever come to rest, see HandlePhysics(). */
+	bool m_IsAtRest;
+
+	/** The block the entity was resting in when it came to rest, its key in the parent chunk's index of resting entities.
+	Valid only while m_IsAtRest is true. */
+	Vector3i m_RestingBlockPos;
+
+	/** Number of ticks until an entity at rest re-checks its physics even without being woken up. */
+	int m_TicksUntilRestCheck;
+
 	/** Stores gravity that is applied to an entity every tick
 	For realistic effects, this should be negative. For spaaaaaaace, this can be zero or even positive */
 	float m_Gravity;
@@ -18,6 +18,7 @@
 #include "../FastRandom.h"
 #include "../ClientHandle.h"
 
+#include "../WorldStorage/PlayerDataWriter.h"
 #include "../WorldStorage/StatisticsSerializer.h"
 #include "../CompositeChat.h"
 
@@ -39,27 +40,6 @@
 
 
 
-namespace
-{
-
-/** Returns the folder for the player data based on the UUID given.
-This can be used both for online and offline UUIDs. */
-AString GetUUIDFolderName(const cUUID & a_Uuid)
-{
-	AString UUID = a_Uuid.ToShortString();
-
-	AString res("players/");
-	res.append(UUID, 0, 2);
-	res.push_back('/');
-	return res;
-}
-
-}  // namespace (anonymous)
-
-
-
-
-
 const int cPlayer::MAX_HEALTH = 20;
 
 const int cPlayer::MAX_FOOD_LEVEL = 20;
@@ -164,6 +144,11 @@ cPlayer::~cPlayer(void)
 
 	SaveToDisk();
 
+	// The files won't be written again until the player reconnects, don't keep their hashes around:
+	auto & Writer = cPlayerDataWriter::Get();
+	Writer.ForgetFile(GetUUIDFileName(GetUUID()));
+	Writer.ForgetFile(StatisticsSerializer::GetFileName(m_DefaultWorldPath, GetUUID().ToLongString()));
+
 	delete m_InventoryWindow;
 
 	LOGD("Player %p deleted", static_cast<void *>(this));
@@ -1620,28 +1605,8 @@ bool cPlayer::HasPermission(const AString & a_Permission) const
 		return true;
 	}
 
-	AStringVector Split = StringSplit(a_Permission, ".");
-
-	// Iterate over all restrictions; if any matches, then return failure:
-	for (auto & Restriction: m_SplitRestrictions)
-	{
-		if (PermissionMatches(Split, Restriction))
-		{
-			return false;
-		}
-	}  // for Restriction - m_SplitRestrictions[]
-
-	// Iterate over all granted permissions; if any matches, then return success:
-	for (auto & Permission: m_SplitPermissions)
-	{
-		if (PermissionMatches(Split, Permission))
-		{
-			return true;
-		}
-	}  // for Permission - m_SplitPermissions[]
-
-	// No granted permission matches
-	return false;
+	// If any restriction matches, then return failure; otherwise any granted permission that matches means success:
+	return !m_RestrictionTrie.Matches(a_Permission) && m_PermissionTrie.Matches(a_Permission);
 }
 
 
@@ -1650,27 +1615,7 @@ bool cPlayer::HasPermission(const AString & a_Permission) const
 
 bool cPlayer::PermissionMatches(const AStringVector & a_Permission, const AStringVector & a_Template)
 {
-	// Check the sub-items if they are the same or there's a wildcard:
-	size_t lenP = a_Permission.size();
-	size_t lenT = a_Template.size();
-	size_t minLen = std::min(lenP, lenT);
-	for (size_t i = 0; i < minLen; i++)
-	{
-		if (a_Template[i] == "*")
-		{
-			// Has matched so far and now there's a wildcard in the template, so the permission matches:
-			return true;
-		}
-		if (a_Permission[i] != a_Template[i])
-		{
-			// Found a mismatch
-			return false;
-		}
-	}
-
-	// So far all the sub-items have matched
-	// If the sub-item count is the same, then the permission matches
-	return (lenP == lenT);
+	return cPermissionTrie::TemplateMatches(a_Permission, a_Template);
 }
 
 
@@ -1837,6 +1782,11 @@ void cPlayer::LoadFromDisk()
 	const auto & UUID = GetUUID();
 	const auto & FileName = GetUUIDFileName(UUID);
 
+	// The player may have just disconnected, make sure their latest save has been written:
+	auto & Writer = cPlayerDataWriter::Get();
+	Writer.WaitForFile(FileName);
+	Writer.WaitForFile(StatisticsSerializer::GetFileName(m_DefaultWorldPath, UUID.ToLongString()));
+
 	try
 	{
 		// Load the data from the save file and parse:
@@ -1961,8 +1911,8 @@ void cPlayer::OpenHorseInventory()
 
 void cPlayer::SaveToDisk()
 {
+	// Only snapshot the player state here, the serialization and file writes are done in the background:
 	const auto & UUID = GetUUID();
-	cFile::CreateFolderRecursive(GetUUIDFolderName(UUID));
 
 	// create the JSON data
 	Json::Value JSON_PlayerPosition;
@@ -2023,36 +1973,19 @@ void cPlayer::SaveToDisk()
 	root["world"]               = m_CurrentWorldName;
 	root["gamemode"]            = static_cast<int>(m_GameMode);
 
-	auto JsonData = JsonUtils::WriteStyledString(root);
-	AString SourceFile = GetUUIDFileName(UUID);
-
-	cFile f;
-	if (!f.Open(SourceFile, cFile::fmWrite))
-	{
-		LOGWARNING("Error writing player \"%s\" to file \"%s\": cannot open file. Player will lose their progress",
-			GetName().c_str(), SourceFile.c_str()
-		);
-		return;
-	}
-	if (f.Write(JsonData.c_str(), JsonData.size()) != static_cast<int>(JsonData.size()))
+	auto & Writer = cPlayerDataWriter::Get();
+	Writer.QueueWrite(GetUUIDFileName(UUID), [Root = std::move(root)]()
 	{
-		LOGWARNING("Error writing player \"%s\" to file \"%s\": cannot save data. Player will lose their progress",
-			GetName().c_str(), SourceFile.c_str()
-		);
-		return;
-	}
+		return JsonUtils::WriteStyledString(Root);
+	});
 
-	try
-	{
-		// Save the player stats.
-		// We use the default world name (like bukkit) because stats are shared between dimensions / worlds.
-		// TODO: save together with player.dat, not in some other place.
-		StatisticsSerializer::Save(m_Stats, m_DefaultWorldPath, GetUUID().ToLongString());
-	}
-	catch (...)
+	// Save the player stats.
+	// We use the default world name (like bukkit) because stats are shared between dimensions / worlds.
+	// TODO: save together with player.dat, not in some other place.
+	Writer.QueueWrite(StatisticsSerializer::GetFileName(m_DefaultWorldPath, UUID.ToLongString()), [Stats = m_Stats]()
 	{
-		LOGWARNING("Error writing player \"%s\" statistics to file", GetName().c_str());
-	}
+		return StatisticsSerializer::Save(Stats);
+	});
 }
 
 
@@ -2850,21 +2783,9 @@ void cPlayer::RefreshRank()
 	m_Restrictions = RankMgr->GetPlayerRestrictions(UUID);
 	RankMgr->GetRankVisuals(m_Rank, m_MsgPrefix, m_MsgSuffix, m_MsgNameColorCode);
 
-	// Break up the individual permissions on each dot, into m_SplitPermissions:
-	m_SplitPermissions.clear();
-	m_SplitPermissions.reserve(m_Permissions.size());
-	for (auto & Permission : m_Permissions)
-	{
-		m_SplitPermissions.push_back(StringSplit(Permission, "."));
-	}
-
-	// Break up the individual restrictions on each dot, into m_SplitRestrictions:
-	m_SplitRestrictions.clear();
-	m_SplitRestrictions.reserve(m_Restrictions.size());
-	for (auto & Restriction : m_Restrictions)
-	{
-		m_SplitRestrictions.push_back(StringSplit(Restriction, "."));
-	}
+	// Compile the permissions and restrictions for the HasPermission() lookups:
+	m_PermissionTrie.Set(m_Permissions);
+	m_RestrictionTrie.Set(m_Restrictions);
 }
 
 
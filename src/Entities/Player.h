@@ -7,6 +7,7 @@
 #include "../World.h"
 #include "../Items/ItemHandler.h"
 
+#include "../PermissionTrie.h"
 #include "../StatisticsManager.h"
 
 #include "../UUID.h"
@@ -426,7 +427,8 @@ public:
 
 	void SetVisible( bool a_bVisible);  // tolua_export
 
-	/** Saves all player data, such as inventory, to JSON. */
+	/** Saves all player data, such as inventory, to JSON.
+	The data is snapshotted right away, but serialized and written to disk in the background by cPlayerDataWriter. */
 	void SaveToDisk(void);
 
 	/** Loads the player data from the save file.
@@ -613,8 +615,6 @@ public:
 
 private:
 
-	typedef std::vector<std::vector<AString> > AStringVectorVector;
-
 	/** The current body stance the player has adopted. */
 	std::variant<BodyStanceCrouching, BodyStanceSleeping, BodyStanceSprinting, BodyStanceStanding, BodyStanceGliding> m_BodyStance;
 
@@ -627,13 +627,13 @@ private:
 	/** All the restrictions that this player has, based on their rank. */
 	AStringVector m_Restrictions;
 
-	/** All the permissions that this player has, based on their rank, split into individual dot-delimited parts.
-	This is used mainly by the HasPermission() function to optimize the lookup. */
-	AStringVectorVector m_SplitPermissions;
+	/** All the permissions that this player has, based on their rank, compiled into a trie for the HasPermission() lookups.
+	Rebuilt in RefreshRank(), whenever the rank is (re)loaded. */
+	cPermissionTrie m_PermissionTrie;
 
-	/** All the restrictions that this player has, based on their rank, split into individual dot-delimited parts.
-	This is used mainly by the HasPermission() function to optimize the lookup. */
-	AStringVectorVector m_SplitRestrictions;
+	/** All the restrictions that this player has, based on their rank, compiled into a trie for the HasPermission() lookups.
+	Rebuilt in RefreshRank(), whenever the rank is (re)loaded. */
+	cPermissionTrie m_RestrictionTrie;
 
 	// Message visuals:
 	AString m_MsgPrefix, m_MsgSuffix;
@@ -16,19 +16,10 @@
 
 
 cChunkDesc::cChunkDesc(cChunkCoords a_Coords) :
-	m_Coords(a_Coords),
-	m_bUseDefaultBiomes(true),
-	m_bUseDefaultHeight(true),
-	m_bUseDefaultComposition(true),
-	m_bUseDefaultFinish(true)
+	m_Coords(a_Coords)
 {
 	m_BlockArea.Create(cChunkDef::Width, cChunkDef::Height, cChunkDef::Width);
-	/*
-	memset(m_BlockTypes, 0, sizeof(cChunkDef::BlockTypes));
-	memset(m_BlockMeta,  0, sizeof(cChunkDef::BlockNibbles));
-	*/
-	memset(m_BiomeMap.data(),   0, sizeof(cChunkDef::BiomeMap));
-	memset(m_HeightMap.data(),  0, sizeof(cChunkDef::HeightMap));
+	Reset(a_Coords);
 }
 
 
@@ -53,6 +44,25 @@ void cChunkDesc::SetChunkCoords(cChunkCoords a_Coords)
 
 
 
+void cChunkDesc::Reset(cChunkCoords a_Coords)
+{
+	m_Coords = a_Coords;
+	m_bUseDefaultBiomes = true;
+	m_bUseDefaultHeight = true;
+	m_bUseDefaultComposition = true;
+	m_bUseDefaultFinish = true;
+
+	// Filling with air also removes all the block entities:
+	m_BlockArea.Fill(cBlockArea::baBlocks, Block::Air::Air());
+	m_Entities.clear();
+	memset(m_BiomeMap.data(),   0, sizeof(cChunkDef::BiomeMap));
+	memset(m_HeightMap.data(),  0, sizeof(cChunkDef::HeightMap));
+}
+
+
+
+
+
 void cChunkDesc::FillBlocks(BlockState a_Block)
 {
 	m_BlockArea.Fill(cBlockArea::baBlocks, a_Block);
@@ -44,6 +44,10 @@ public:
 
 	void SetChunkCoords(cChunkCoords a_Coords);
 
+	/** Returns the object to the freshly constructed state for generating another chunk.
+	Keeps the block storage allocated, so that a single object can be reused for generating many chunks. */
+	void Reset(cChunkCoords a_Coords);
+
 	// tolua_begin
 
 	int GetChunkX() const { return m_Coords.m_ChunkX; }  // Prefer GetChunkCoords() instead
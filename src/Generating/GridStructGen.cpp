@@ -130,8 +130,10 @@ void cGridStructGen::SetGeneratorParams(const AStringMap & a_GeneratorParams)
 
 
 
-void cGridStructGen::GetStructuresForChunk(int a_ChunkX, int a_ChunkZ, cStructurePtrs & a_Structures)
+void cGridStructGen::GetStructuresForChunk(int a_ChunkX, int a_ChunkZ, std::vector<cStructurePtr> & a_Structures)
 {
+	a_Structures.clear();
+
 	// Calculate the min and max grid coords of the structures to be returned:
 	int MinBlockX = a_ChunkX * cChunkDef::Width - m_MaxStructureSizeX - m_MaxOffsetX;
 	int MinBlockZ = a_ChunkZ * cChunkDef::Width - m_MaxStructureSizeZ - m_MaxOffsetZ;
@@ -146,7 +148,9 @@ void cGridStructGen::GetStructuresForChunk(int a_ChunkX, int a_ChunkZ, cStructur
 	int MinZ = MinGridZ * m_GridSizeZ;
 	int MaxZ = MaxGridZ * m_GridSizeZ;
 
-	// Walk the cache, move each structure that we want into a_Structures:
+	// Walk the cache, copy each structure that we want into a_Structures and move it to the front of the cache
+	// (before Front), keeping the order. Splicing within the list moves the nodes without reallocating them:
+	cStructurePtrs::iterator Front = m_Cache.begin();
 	for (cStructurePtrs::iterator itr = m_Cache.begin(), end = m_Cache.end(); itr != end;)
 	{
 		if (
@@ -156,7 +160,15 @@ void cGridStructGen::GetStructuresForChunk(int a_ChunkX, int a_ChunkZ, cStructur
 		{
 			// want
 			a_Structures.push_back(*itr);
-			itr = m_Cache.erase(itr);
+			if (itr == Front)
+			{
+				++Front;
+				++itr;
+			}
+			else
+			{
+				m_Cache.splice(Front, m_Cache, itr++);
+			}
 		}
 		else
 		{
@@ -173,7 +185,7 @@ void cGridStructGen::GetStructuresForChunk(int a_ChunkX, int a_ChunkZ, cStructur
 		{
 			int GridZ = z * m_GridSizeZ;
 			bool Found = false;
-			for (cStructurePtrs::const_iterator itr = a_Structures.begin(), end = a_Structures.end(); itr != end; ++itr)
+			for (auto itr = a_Structures.cbegin(), end = a_Structures.cend(); itr != end; ++itr)
 			{
 				if (((*itr)->m_GridX == GridX) && ((*itr)->m_GridZ == GridZ))
 				{
@@ -191,14 +203,11 @@ void cGridStructGen::GetStructuresForChunk(int a_ChunkX, int a_ChunkZ, cStructur
 					Structure.reset(new cEmptyStructure(GridX, GridZ, OriginX, OriginZ));
 				}
 				a_Structures.push_back(Structure);
+				m_Cache.insert(Front, Structure);
 			}
 		}  // for z
 	}  // for x
 
-	// Copy a_Forts into m_Cache to the beginning:
-	cStructurePtrs StructuresCopy (a_Structures);
-	m_Cache.splice(m_Cache.begin(), StructuresCopy, StructuresCopy.begin(), StructuresCopy.end());
-
 	// Trim the cache if it's too long:
 	size_t CacheSize = 0;
 	for (cStructurePtrs::iterator itr = m_Cache.begin(), end = m_Cache.end(); itr != end; ++itr)
@@ -221,12 +230,14 @@ void cGridStructGen::GenFinish(cChunkDesc & a_ChunkDesc)
 {
 	int ChunkX = a_ChunkDesc.GetChunkX();
 	int ChunkZ = a_ChunkDesc.GetChunkZ();
-	cStructurePtrs Structures;
-	GetStructuresForChunk(ChunkX, ChunkZ, Structures);
-	for (cStructurePtrs::const_iterator itr = Structures.begin(); itr != Structures.end(); ++itr)
+	GetStructuresForChunk(ChunkX, ChunkZ, m_ChunkStructures);
+	for (const auto & Structure: m_ChunkStructures)
 	{
-		(*itr)->DrawIntoChunk(a_ChunkDesc);
-	}  // for itr - Structures[]
+		Structure->DrawIntoChunk(a_ChunkDesc);
+	}  // for Structure - m_ChunkStructures[]
+
+	// Release the structures that have been trimmed from the cache, but keep the capacity for the next chunk:
+	m_ChunkStructures.clear();
 }
 
 
@@ -137,14 +137,19 @@ protected:
 	/** Cache for the most recently generated structures, ordered by the recentness. */
 	cStructurePtrs m_Cache;
 
+	/** The structures intersecting the chunk being generated by GenFinish().
+	A member so that its capacity is reused for each chunk. */
+	std::vector<cStructurePtr> m_ChunkStructures;
+
 
 	/** Clears everything from the cache */
 	void ClearCache(void);
 
 	/** Returns all structures that may intersect the given chunk.
 	The structures are considered as intersecting iff their bounding box (defined by m_MaxStructureSize)
-	around their gridpoint intersects the chunk. */
-	void GetStructuresForChunk(int a_ChunkX, int a_ChunkZ, cStructurePtrs & a_Structures);
+	around their gridpoint intersects the chunk. a_Structures is cleared first.
+	The returned structures are moved to the front of the cache. */
+	void GetStructuresForChunk(int a_ChunkX, int a_ChunkZ, std::vector<cStructurePtr> & a_Structures);
 
 	// Functions for the descendants to override:
 	/** Create a new structure at the specified gridpoint */
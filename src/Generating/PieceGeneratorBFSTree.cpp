@@ -105,54 +105,51 @@ bool cPieceGeneratorBFSTree::TryPlacePieceAtConnector(
 )
 {
 	// Get a list of available connections:
-	cConnections Connections;
+	auto & Connections = m_Connections;
+	Connections.clear();
 	int WantedConnectorType = -a_Connector.m_Type;
-	cPieces AvailablePieces = m_PiecePool.GetPiecesWithConnector(WantedConnectorType);
+	const auto & AvailablePieces = GetPiecesWithConnector(WantedConnectorType);
 	Connections.reserve(AvailablePieces.size());
 	Vector3i ConnPos = cPiece::cConnector::AddDirection(a_Connector.m_Pos, a_Connector.m_Direction);  // The position at which the new connector should be placed - 1 block away from the current connector
 	int WeightTotal = 0;
-	for (cPieces::iterator itrP = AvailablePieces.begin(), endP = AvailablePieces.end(); itrP != endP; ++itrP)
+	for (const auto & Available : AvailablePieces)
 	{
 		// Get the relative chance of this piece being generated in this path:
-		int Weight = m_PiecePool.GetPieceWeight(a_ParentPiece, a_Connector, **itrP);
+		auto & Piece = *Available.m_Piece;
+		int Weight = m_PiecePool.GetPieceWeight(a_ParentPiece, a_Connector, Piece);
 		if (Weight <= 0)
 		{
 			continue;
 		}
 
-		// Try fitting each of the piece's connector:
-		cPiece::cConnectors Connectors = (*itrP)->GetConnectors();
-		auto verticalLimit = (*itrP)->GetVerticalLimit();
-		for (cPiece::cConnectors::iterator itrC = Connectors.begin(), endC = Connectors.end(); itrC != endC; ++itrC)
+		// Try fitting each of the piece's connectors of the wanted type:
+		auto verticalLimit = Piece.GetVerticalLimit();
+		for (const auto & Connector : Available.m_Connectors)
 		{
-			if (itrC->m_Type != WantedConnectorType)
-			{
-				continue;
-			}
-			// This is a same-type connector, find out how to rotate to it:
-			int NumCCWRotations = cPiece::cConnector::GetNumCCWRotationsToFit(a_Connector.m_Direction, itrC->m_Direction);
-			if ((NumCCWRotations < 0) || !(*itrP)->CanRotateCCW(NumCCWRotations))
+			// Find out how to rotate to the connector:
+			int NumCCWRotations = cPiece::cConnector::GetNumCCWRotationsToFit(a_Connector.m_Direction, Connector.m_Direction);
+			if ((NumCCWRotations < 0) || !Piece.CanRotateCCW(NumCCWRotations))
 			{
 				// Doesn't support this rotation
 				continue;
 			}
 
 			// Check if the piece's VerticalLimit allows this connection:
-			if ((verticalLimit != nullptr) && (!verticalLimit->CanBeAtHeight(ConnPos.x, ConnPos.z, ConnPos.y - itrC->m_Pos.y)))
+			if ((verticalLimit != nullptr) && (!verticalLimit->CanBeAtHeight(ConnPos.x, ConnPos.z, ConnPos.y - Connector.m_Pos.y)))
 			{
 				continue;
 			}
 
-			if (!CheckConnection(a_Connector, ConnPos, **itrP, *itrC, NumCCWRotations, a_OutPieces))
+			if (!CheckConnection(a_Connector, ConnPos, Piece, Connector, NumCCWRotations))
 			{
 				// Doesn't fit in this rotation
 				continue;
 			}
 			// Fits, add it to list of possibile connections:
-			Connections.emplace_back(**itrP, *itrC, NumCCWRotations, Weight);
+			Connections.emplace_back(Piece, Connector, NumCCWRotations, Weight);
 			WeightTotal += Weight;
-		}  // for itrC - Connectors[]
-	}  // for itrP - AvailablePieces[]
+		}  // for Connector - Available.m_Connectors[]
+	}  // for Available - AvailablePieces[]
 	if (Connections.empty())
 	{
 		// No available connections, bail out
@@ -190,6 +187,7 @@ bool cPieceGeneratorBFSTree::TryPlacePieceAtConnector(
 		}
 		a_OutConnectors.emplace_back(PlacedPiece.get(), Conn.m_Piece->RotateMoveConnector(*itr, Conn.m_NumCCWRotations, ConnPos.x, ConnPos.y, ConnPos.z));
 	}
+	m_PlacedHitBoxes.Add(PlacedPiece->GetHitBox());
 	a_OutPieces.push_back(std::move(PlacedPiece));
 
 	return true;
@@ -204,21 +202,42 @@ bool cPieceGeneratorBFSTree::CheckConnection(
 	const Vector3i & a_ToPos,
 	const cPiece & a_Piece,
 	const cPiece::cConnector & a_NewConnector,
-	int a_NumCCWRotations,
-	const cPlacedPieces & a_OutPieces
+	int a_NumCCWRotations
 )
 {
-	// For each placed piece, test the hitbox against the new piece:
+	// Test the hitbox of the new piece against the placed pieces nearby:
 	cCuboid RotatedHitBox = a_Piece.RotateHitBoxToConnector(a_NewConnector, a_ToPos, a_NumCCWRotations);
 	RotatedHitBox.Sort();
-	for (cPlacedPieces::const_iterator itr = a_OutPieces.begin(), end = a_OutPieces.end(); itr != end; ++itr)
+	return !m_PlacedHitBoxes.DoesIntersect(RotatedHitBox);
+}
+
+
+
+
+
+const cPieceGeneratorBFSTree::cPiecesConnectors & cPieceGeneratorBFSTree::GetPiecesWithConnector(int a_ConnectorType)
+{
+	auto itr = m_PiecesByConnector.find(a_ConnectorType);
+	if (itr != m_PiecesByConnector.end())
 	{
-		if ((*itr)->GetHitBox().DoesIntersect(RotatedHitBox))
+		return itr->second;
+	}
+
+	// Not cached yet, query the pool and keep only the connectors of the requested type:
+	auto & PiecesConnectors = m_PiecesByConnector[a_ConnectorType];
+	for (auto Piece : m_PiecePool.GetPiecesWithConnector(a_ConnectorType))
+	{
+		cPieceConnectors Entry{Piece, {}};
+		for (const auto & Connector : Piece->GetConnectors())
 		{
-			return false;
+			if (Connector.m_Type == a_ConnectorType)
+			{
+				Entry.m_Connectors.push_back(Connector);
+			}
 		}
+		PiecesConnectors.push_back(std::move(Entry));
 	}
-	return true;
+	return PiecesConnectors;
 }
 
 
@@ -228,10 +247,13 @@ bool cPieceGeneratorBFSTree::CheckConnection(
 void cPieceGeneratorBFSTree::PlacePieces(int a_BlockX, int a_BlockZ, int a_MaxDepth, cPlacedPieces & a_OutPieces)
 {
 	a_OutPieces.clear();
-	cFreeConnectors ConnectorPool;
+	m_PlacedHitBoxes.Clear();
+	auto & ConnectorPool = m_ConnectorPool;
+	ConnectorPool.clear();
 
 	// Place the starting piece:
 	a_OutPieces.push_back(PlaceStartingPiece(a_BlockX, a_BlockZ, ConnectorPool));
+	m_PlacedHitBoxes.Add(a_OutPieces.back()->GetHitBox());
 
 	/*
 	// DEBUG:
@@ -317,7 +339,7 @@ void cPieceGeneratorBFSTree::DebugConnectorPool(const cPieceGeneratorBFSTree::cF
 ////////////////////////////////////////////////////////////////////////////////
 // cPieceGeneratorBFSTree::cConnection:
 
-cPieceGeneratorBFSTree::cConnection::cConnection(cPiece & a_Piece, cPiece::cConnector & a_Connector, int a_NumCCWRotations, int a_Weight) :
+cPieceGeneratorBFSTree::cConnection::cConnection(cPiece & a_Piece, const cPiece::cConnector & a_Connector, int a_NumCCWRotations, int a_Weight) :
 	m_Piece(&a_Piece),
 	m_Connector(a_Connector),
 	m_NumCCWRotations(a_NumCCWRotations),
@@ -329,6 +351,68 @@ cPieceGeneratorBFSTree::cConnection::cConnection(cPiece & a_Piece, cPiece::cConn
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+// cPieceGeneratorBFSTree::cHitBoxGrid:
+
+void cPieceGeneratorBFSTree::cHitBoxGrid::Clear(void)
+{
+	m_HitBoxes.clear();
+	m_Cells.clear();
+}
+
+
+
+
+
+void cPieceGeneratorBFSTree::cHitBoxGrid::Add(const cCuboid & a_HitBox)
+{
+	ASSERT(a_HitBox.IsSorted());
+
+	const auto Index = m_HitBoxes.size();
+	m_HitBoxes.push_back(a_HitBox);
+	for (int CellX = a_HitBox.p1.x >> CELL_SIZE_BITS; CellX <= (a_HitBox.p2.x >> CELL_SIZE_BITS); CellX++)
+	{
+		for (int CellZ = a_HitBox.p1.z >> CELL_SIZE_BITS; CellZ <= (a_HitBox.p2.z >> CELL_SIZE_BITS); CellZ++)
+		{
+			m_Cells[GetCellKey(CellX, CellZ)].push_back(Index);
+		}
+	}
+}
+
+
+
+
+
+bool cPieceGeneratorBFSTree::cHitBoxGrid::DoesIntersect(const cCuboid & a_HitBox) const
+{
+	ASSERT(a_HitBox.IsSorted());
+
+	// A hitbox spanning multiple cells may get tested more than once, which is cheaper than de-duplicating:
+	for (int CellX = a_HitBox.p1.x >> CELL_SIZE_BITS; CellX <= (a_HitBox.p2.x >> CELL_SIZE_BITS); CellX++)
+	{
+		for (int CellZ = a_HitBox.p1.z >> CELL_SIZE_BITS; CellZ <= (a_HitBox.p2.z >> CELL_SIZE_BITS); CellZ++)
+		{
+			const auto itr = m_Cells.find(GetCellKey(CellX, CellZ));
+			if (itr == m_Cells.end())
+			{
+				continue;
+			}
+			for (const auto Index : itr->second)
+			{
+				if (m_HitBoxes[Index].DoesIntersect(a_HitBox))
+				{
+					return true;
+				}
+			}
+		}
+	}
+	return false;
+}
+
+
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 // cPieceGeneratorBFSTree::cFreeConnector:
 
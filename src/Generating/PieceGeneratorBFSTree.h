@@ -38,7 +38,7 @@ protected:
 		int m_NumCCWRotations;             // Number of rotations necessary to match the two connectors
 		int m_Weight;                      // Relative chance that this connection will be chosen
 
-		cConnection(cPiece & a_Piece, cPiece::cConnector & a_Connector, int a_NumCCWRotations, int a_Weight);
+		cConnection(cPiece & a_Piece, const cPiece::cConnector & a_Connector, int a_NumCCWRotations, int a_Weight);
 	};
 	typedef std::vector<cConnection> cConnections;
 
@@ -54,6 +54,48 @@ protected:
 	typedef std::vector<cFreeConnector> cFreeConnectors;
 
 
+	/** A pool piece together with its connectors of a single type. */
+	struct cPieceConnectors
+	{
+		cPiece * m_Piece;
+		cPiece::cConnectors m_Connectors;
+	};
+	typedef std::vector<cPieceConnectors> cPiecesConnectors;
+
+
+	/** Uniform grid over the XZ plane, indexing the hitboxes of the placed pieces.
+	Used so that a new piece is checked for collisions only against the placed pieces near it. */
+	class cHitBoxGrid
+	{
+	public:
+		/** Removes all the hitboxes. */
+		void Clear(void);
+
+		/** Adds the specified (sorted) hitbox into the grid. */
+		void Add(const cCuboid & a_HitBox);
+
+		/** Returns true if the specified (sorted) hitbox intersects any of the hitboxes in the grid. */
+		bool DoesIntersect(const cCuboid & a_HitBox) const;
+
+	protected:
+
+		/** The size of a grid cell, in blocks, as a power of two. */
+		static const int CELL_SIZE_BITS = 4;
+
+		/** All the hitboxes in the grid. */
+		std::vector<cCuboid> m_HitBoxes;
+
+		/** Indices into m_HitBoxes of the hitboxes overlapping each grid cell, by the cell key. */
+		std::unordered_map<UInt64, std::vector<size_t>> m_Cells;
+
+		/** Returns the key of the grid cell with the specified coords. */
+		static UInt64 GetCellKey(int a_CellX, int a_CellZ)
+		{
+			return (static_cast<UInt64>(static_cast<UInt32>(a_CellX)) << 32) | static_cast<UInt32>(a_CellZ);
+		}
+	};
+
+
 	/** The pool from which pieces are taken. */
 	cPiecePool & m_PiecePool;
 
@@ -63,6 +105,20 @@ protected:
 	/** The seed used by this generator. */
 	int m_Seed;
 
+	/** The pool pieces and their connectors, by the connector type.
+	Filled on first use of each type, the pool's pieces don't change during the generator's lifetime. */
+	std::unordered_map<int, cPiecesConnectors> m_PiecesByConnector;
+
+	/** The hitboxes of the pieces placed so far by PlacePieces(). */
+	cHitBoxGrid m_PlacedHitBoxes;
+
+	/** The connectors waiting to be expanded in PlacePieces().
+	A member rather than a local, so that its capacity is reused when the generator places more structures. */
+	cFreeConnectors m_ConnectorPool;
+
+	/** The possible connections at a single connector, used by TryPlacePieceAtConnector(). A member for the same reason. */
+	cConnections m_Connections;
+
 
 	/** Selects a starting piece and places it, including its height and rotation.
 	Also puts the piece's connectors in a_OutConnectors. */
@@ -72,11 +128,14 @@ protected:
 	bool TryPlacePieceAtConnector(
 		const cPlacedPiece & a_ParentPiece,      // The existing piece to a new piece should be placed
 		const cPiece::cConnector & a_Connector,  // The existing connector (world-coords) to which a new piece should be placed
-		cPlacedPieces & a_OutPieces,             // Already placed pieces, to be checked for intersections
+		cPlacedPieces & a_OutPieces,             // Already placed pieces, the new piece is added here
 		cFreeConnectors & a_OutConnectors        // List of free connectors to which the new connectors will be placed
 	);
 
-	/** Checks if the specified piece would fit with the already-placed pieces, using the specified connector
+	/** Returns the pool pieces that have a connector of the specified type, with only their connectors of that type. */
+	const cPiecesConnectors & GetPiecesWithConnector(int a_ConnectorType);
+
+	/** Checks if the specified piece would fit with the already-placed pieces (m_PlacedHitBoxes), using the specified connector
 	and number of CCW rotations.
 	a_ExistingConnector is in world-coords and is already rotated properly
 	a_ToPos is the world-coords position on which the new connector should be placed (1 block away from a_ExistingConnector, in its Direction)
@@ -87,8 +146,7 @@ protected:
 		const Vector3i & a_ToPos,                        // The position on which the new connector should be placed
 		const cPiece & a_Piece,                          // The new piece
 		const cPiece::cConnector & a_NewConnector,       // The connector of the new piece
-		int a_NumCCWRotations,                           // Number of rotations for the new piece to align the connector
-		const cPlacedPieces & a_OutPieces                // All the already-placed pieces to check
+		int a_NumCCWRotations                            // Number of rotations for the new piece to align the connector
 	);
 
 	/** DEBUG: Outputs all the connectors in the pool into stdout.
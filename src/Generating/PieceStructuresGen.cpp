@@ -63,8 +63,11 @@ public:
 	virtual cStructurePtr CreateStructure(int a_GridX, int a_GridZ, int a_OriginX, int a_OriginZ) override
 	{
 		cPlacedPieces OutPieces;
-		cPieceGeneratorBFSTree PieceTree(m_PiecePool, m_Seed);
-		PieceTree.PlacePieces(a_OriginX, a_OriginZ, m_MaxDepth, OutPieces);
+		if (m_PieceTree == nullptr)
+		{
+			m_PieceTree = std::make_unique<cPieceGeneratorBFSTree>(m_PiecePool, m_Seed);
+		}
+		m_PieceTree->PlacePieces(a_OriginX, a_OriginZ, m_MaxDepth, OutPieces);
 		return std::make_shared<cPrefabStructure>(a_GridX, a_GridZ, a_OriginX, a_OriginZ, std::move(OutPieces), m_HeightGen);
 	}
 
@@ -111,6 +114,10 @@ protected:
 
 	/** Maximum depth of the generated piece tree. */
 	int m_MaxDepth;
+
+	/** Places the pieces of each structure. Kept between the structures so that its working buffers are reused.
+	Created on first use, after the pool has been loaded and the seed offset applied from the pool's metadata. */
+	std::unique_ptr<cPieceGeneratorBFSTree> m_PieceTree;
 };
 
 
@@ -152,8 +152,8 @@ void cPrefab::Draw(cChunkDesc & a_Dest, const Vector3i & a_Placement, int a_NumR
 
 	// If the placement is outside this chunk, bail out:
 	if (
-		(Placement.x > cChunkDef::Width) || (Placement.x + Image.GetSizeX() < 0) ||
-		(Placement.z > cChunkDef::Width) || (Placement.z + Image.GetSizeZ() < 0)
+		(Placement.x >= cChunkDef::Width) || (Placement.x + Image.GetSizeX() <= 0) ||
+		(Placement.z >= cChunkDef::Width) || (Placement.z + Image.GetSizeZ() <= 0)
 	)
 	{
 		return;
@@ -23,7 +23,8 @@ void cStructGenTrees::GenFinish(cChunkDesc & a_ChunkDesc)
 	int ChunkX = a_ChunkDesc.GetChunkX();
 	int ChunkZ = a_ChunkDesc.GetChunkZ();
 
-	cChunkDesc WorkerDesc({ChunkX, ChunkZ});
+	auto & WorkerDesc = m_WorkerDesc;
+	WorkerDesc.Reset({ChunkX, ChunkZ});
 
 	// Generate trees:
 	for (int x = 0; x <= 2; x++)
@@ -55,7 +56,10 @@ void cStructGenTrees::GenFinish(cChunkDesc & a_ChunkDesc)
 
 			double NumTrees = GetNumTrees(BaseX, BaseZ, Dest->GetBiomeMap());
 
-			sSetBlockVector OutsideLogs, OutsideOther;
+			auto & OutsideLogs = m_OutsideLogs;
+			auto & OutsideOther = m_OutsideOther;
+			OutsideLogs.clear();
+			OutsideOther.clear();
 			if (NumTrees < 1)
 			{
 				Vector3i Pos;
@@ -80,7 +84,8 @@ void cStructGenTrees::GenFinish(cChunkDesc & a_ChunkDesc)
 					GenerateSingleTree(BaseX, BaseZ, i, Pos, *Dest, OutsideLogs, OutsideOther);
 				}
 			}
-			sSetBlockVector IgnoredOverflow;
+			auto & IgnoredOverflow = m_IgnoredOverflow;
+			IgnoredOverflow.clear();
 			IgnoredOverflow.reserve(OutsideOther.size());
 			ApplyTreeImage(ChunkX, ChunkZ, a_ChunkDesc, OutsideOther, IgnoredOverflow);
 			IgnoredOverflow.clear();
@@ -116,7 +121,10 @@ void cStructGenTrees::GenerateSingleTree(
 		return;
 	}
 
-	sSetBlockVector TreeLogs, TreeOther;
+	auto & TreeLogs = m_TreeLogs;
+	auto & TreeOther = m_TreeOther;
+	TreeLogs.clear();
+	TreeOther.clear();
 	GetTreeImageByBiome(
 		{ a_ChunkX * cChunkDef::Width + a_Pos.x, a_Pos.y + 1, a_ChunkZ * cChunkDef::Width + a_Pos.z },
 		m_Noise, a_Seq,
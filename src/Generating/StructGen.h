@@ -27,7 +27,8 @@ public:
 		m_Noise(a_Seed),
 		m_BiomeGen(a_BiomeGen),
 		m_ShapeGen(a_ShapeGen),
-		m_CompositionGen(a_CompositionGen)
+		m_CompositionGen(a_CompositionGen),
+		m_WorkerDesc({0, 0})
 	{}
 
 protected:
@@ -38,6 +39,19 @@ protected:
 	cTerrainShapeGen &       m_ShapeGen;
 	cTerrainCompositionGen & m_CompositionGen;
 
+	/** The chunk description into which the neighboring chunks' terrain is generated.
+	Together with the vectors below, reused across the chunks to avoid reallocating for each chunk. */
+	cChunkDesc m_WorkerDesc;
+
+	/** The tree blocks that didn't fit into the generated chunk, while processing a single neighbor. */
+	sSetBlockVector m_OutsideLogs, m_OutsideOther;
+
+	/** The tree blocks of the neighbors that don't fit into the generated chunk either, thrown away. */
+	sSetBlockVector m_IgnoredOverflow;
+
+	/** The image of the tree being generated in GenerateSingleTree(). */
+	sSetBlockVector m_TreeLogs, m_TreeOther;
+
 	/** Generates and applies an image of a single tree.
 	Parts of the tree inside the chunk are applied to a_ChunkDesc.
 	Parts of the tree outside the chunk are stored in a_OutsideXYZ
@@ -244,8 +244,29 @@ void cLightingThread::LightChunk(cLightingChunkStay & a_Item)
 	}
 
 	cChunkDef::LightNibbles BlockLight, SkyLight;
+	CalcChunkLight(
+		[this, &a_Item](int a_OffsetX, int a_OffsetZ, cChunkDataCallback & a_Callback)
+		{
+			VERIFY(m_World.GetChunkData({a_Item.m_ChunkX + a_OffsetX, a_Item.m_ChunkZ + a_OffsetZ}, a_Callback));
+		},
+		BlockLight, SkyLight
+	);
+
+	m_World.ChunkLighted(a_Item.m_ChunkX, a_Item.m_ChunkZ, BlockLight, SkyLight);
+
+	if (a_Item.m_CallbackAfter != nullptr)
+	{
+		a_Item.m_CallbackAfter->Call({a_Item.m_ChunkX, a_Item.m_ChunkZ}, true);
+	}
+}
+
+
 
-	ReadChunks(a_Item.m_ChunkX, a_Item.m_ChunkZ);
+
+
+void cLightingThread::CalcChunkLight(cChunkReader a_ReadChunk, cChunkDef::LightNibbles & a_BlockLight, cChunkDef::LightNibbles & a_SkyLight)
+{
+	ReadChunks(a_ReadChunk);
 
 	PrepareBlockLight();
 	CalcLight(m_BlockLight);
@@ -312,22 +333,15 @@ void cLightingThread::LightChunk(cLightingChunkStay & a_Item)
 	}
 	//*/
 
-	CompressLight(m_BlockLight, BlockLight);
-	CompressLight(m_SkyLight, SkyLight);
-
-	m_World.ChunkLighted(a_Item.m_ChunkX, a_Item.m_ChunkZ, BlockLight, SkyLight);
-
-	if (a_Item.m_CallbackAfter != nullptr)
-	{
-		a_Item.m_CallbackAfter->Call({a_Item.m_ChunkX, a_Item.m_ChunkZ}, true);
-	}
+	CompressLight(m_BlockLight, a_BlockLight);
+	CompressLight(m_SkyLight, a_SkyLight);
 }
 
 
 
 
 
-void cLightingThread::ReadChunks(int a_ChunkX, int a_ChunkZ)
+void cLightingThread::ReadChunks(cChunkReader a_ReadChunk)
 {
 	cReader Reader(m_Blocks, m_HeightMap);
 
@@ -337,7 +351,7 @@ void cLightingThread::ReadChunks(int a_ChunkX, int a_ChunkZ)
 		for (int x = 0; x < 3; x++)
 		{
 			Reader.m_ReadingChunkX = x;
-			VERIFY(m_World.GetChunkData({a_ChunkX + x - 1, a_ChunkZ + z - 1}, Reader));
+			a_ReadChunk(x - 1, z - 1, Reader);
 		}  // for z
 	}  // for x
 
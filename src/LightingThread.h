@@ -33,6 +33,7 @@ Chunks from m_PostponedQueue are moved back into m_Queue when their neighbors ge
 
 #include "OSSupport/IsThread.h"
 #include "ChunkStay.h"
+#include "FunctionRef.h"
 
 
 
@@ -40,6 +41,7 @@ Chunks from m_PostponedQueue are moved back into m_Queue when their neighbors ge
 
 // fwd: "cWorld.h"
 class cWorld;
+class cChunkDataCallback;
 
 
 
@@ -66,6 +68,15 @@ public:
 
 	size_t GetQueueLength(void);
 
+	/** Called for each chunk of the 3x3 area around the chunk being lit, with the chunk's offset (-1 .. 1) from the middle one.
+	Expected to feed the chunk's data into the callback, the same way cWorld::GetChunkData() does. */
+	using cChunkReader = cFunctionRef<void(int a_OffsetX, int a_OffsetZ, cChunkDataCallback & a_Callback)>;
+
+	/** Calculates the light of the middle chunk of a 3x3 area that is read through a_ReadChunk, rather than from the world.
+	Used for chunks that aren't loaded in the world, such as by the pregenerator.
+	Uses the object's buffers, so it may only be called on an instance whose thread is not running. */
+	void CalcChunkLight(cChunkReader a_ReadChunk, cChunkDef::LightNibbles & a_BlockLight, cChunkDef::LightNibbles & a_SkyLight);
+
 protected:
 
 	class cLightingChunkStay :
@@ -137,8 +148,8 @@ protected:
 	/** Lights the entire chunk. If neighbor chunks don't exist, touches them and re-queues the chunk */
 	void LightChunk(cLightingChunkStay & a_Item);
 
-	/** Prepares m_BlockTypes and m_HeightMap data; zeroes out the light arrays */
-	void ReadChunks(int a_ChunkX, int a_ChunkZ);
+	/** Prepares m_BlockTypes and m_HeightMap data from the 3x3 chunks read through a_ReadChunk; zeroes out the light arrays */
+	void ReadChunks(cChunkReader a_ReadChunk);
 
 	/** Uses m_HeightMap to initialize the m_SkyLight[] data; fills in seeds for the skylight */
 	void PrepareSkyLight(void);
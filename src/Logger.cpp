@@ -40,6 +40,50 @@ static void WriteLogOpener(fmt::memory_buffer & Buffer)
 
 
 
+/** Hands the queued messages to the listeners, in batches. */
+class cLogger::cWriterThread:
+	public cIsThread
+{
+	using Super = cIsThread;
+
+public:
+
+	cWriterThread(cLogger & a_Logger):
+		Super("Logger"),
+		m_Logger(a_Logger)
+	{
+	}
+
+	void Stop()
+	{
+		m_ShouldTerminate = true;
+		m_Logger.m_WriterEvent.Set();
+		Super::Stop();
+	}
+
+protected:
+
+	virtual void Execute(void) override
+	{
+		// Only warnings and errors wake the writer up, the rest waits for the next interval:
+		static const unsigned WriteIntervalMSec = 20;
+		while (!m_ShouldTerminate)
+		{
+			m_Logger.m_WriterEvent.Wait(WriteIntervalMSec);
+			cCSLock Lock(m_Logger.m_CriticalSection);
+			m_Logger.WriteQueuedLines();
+		}
+	}
+
+private:
+
+	cLogger & m_Logger;
+};
+
+
+
+
+
 cLogger & cLogger::GetInstance(void)
 {
 	static cLogger Instance;
@@ -73,11 +117,205 @@ void cLogger::LogSimple(std::string_view a_Message, eLogLevel a_LogLevel)
 
 void cLogger::LogLine(std::string_view a_Line, eLogLevel a_LogLevel)
 {
+	const bool IsImportant = (a_LogLevel == eLogLevel::Warning) || (a_LogLevel == eLogLevel::Error);
+
+	// Announce the producer before checking the flag, StopAsync() clears the flag before waiting for the producers (both seq_cst):
+	m_NumQueueing.fetch_add(1);
+	const bool IsAsync = m_IsAsync.load();
+	const bool IsQueued = IsAsync && QueueLine(a_Line, a_LogLevel);
+	m_NumQueueing.fetch_sub(1, std::memory_order_release);
+
+	if (IsAsync)
+	{
+		if (IsQueued)
+		{
+			if (IsImportant)
+			{
+				m_WriterEvent.Set();
+			}
+			return;
+		}
+
+		// The queue is full. Drop the unimportant messages, write the important ones right away:
+		if (!IsImportant)
+		{
+			m_NumDropped.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+	}
+
 	cCSLock Lock(m_CriticalSection);
+
+	// Keep the order, anything still in the queue was logged before this line:
+	WriteQueuedLines();
+
 	for (size_t i = 0; i < m_LogListeners.size(); i++)
 	{
 		m_LogListeners[i]->Log(a_Line, a_LogLevel);
+		m_LogListeners[i]->Flush();
+	}
+}
+
+
+
+
+
+bool cLogger::QueueLine(std::string_view a_Line, eLogLevel a_LogLevel)
+{
+	auto Pos = m_QueueWritePos.load(std::memory_order_relaxed);
+	for (;;)
+	{
+		auto & Slot = m_Queue[Pos & (QueueSize - 1)];
+		const auto Sequence = Slot.m_Sequence.load(std::memory_order_acquire);
+		const auto Difference = static_cast<std::ptrdiff_t>(Sequence - Pos);
+		if (Difference == 0)
+		{
+			// The slot is free, try to claim it:
+			if (m_QueueWritePos.compare_exchange_weak(Pos, Pos + 1, std::memory_order_relaxed))
+			{
+				// The slot's string keeps its capacity, so this doesn't allocate once the queue is warmed up:
+				Slot.m_Line.assign(a_Line);
+				Slot.m_LogLevel = a_LogLevel;
+				Slot.m_Sequence.store(Pos + 1, std::memory_order_release);
+				return true;
+			}
+			// Another producer claimed it, Pos has been updated by the compare_exchange, retry
+		}
+		else if (Difference < 0)
+		{
+			// The slot still holds a message from the previous lap, the queue is full:
+			return false;
+		}
+		else
+		{
+			Pos = m_QueueWritePos.load(std::memory_order_relaxed);
+		}
+	}
+}
+
+
+
+
+
+void cLogger::WriteQueuedLines()
+{
+	if (m_Queue == nullptr)
+	{
+		return;
+	}
+
+	bool HasWritten = false;
+	for (;;)
+	{
+		auto & Slot = m_Queue[m_QueueReadPos & (QueueSize - 1)];
+		if (Slot.m_Sequence.load(std::memory_order_acquire) != m_QueueReadPos + 1)
+		{
+			// Empty, or the producer hasn't finished writing the message yet:
+			break;
+		}
+
+		for (const auto & Listener : m_LogListeners)
+		{
+			Listener->Log(Slot.m_Line, Slot.m_LogLevel);
+		}
+		Slot.m_Sequence.store(m_QueueReadPos + QueueSize, std::memory_order_release);
+		m_QueueReadPos += 1;
+		HasWritten = true;
+	}
+
+	if (const auto NumDropped = m_NumDropped.exchange(0, std::memory_order_relaxed); NumDropped > 0)
+	{
+		fmt::memory_buffer Buffer;
+		WriteLogOpener(Buffer);
+		fmt::format_to(std::back_inserter(Buffer), "The log queue was full, {} messages were dropped\n", NumDropped);
+		for (const auto & Listener : m_LogListeners)
+		{
+			Listener->Log(std::string_view(Buffer.data(), Buffer.size()), eLogLevel::Warning);
+		}
+		HasWritten = true;
+	}
+
+	if (HasWritten)
+	{
+		for (const auto & Listener : m_LogListeners)
+		{
+			Listener->Flush();
+		}
+	}
+}
+
+
+
+
+
+void cLogger::StartAsync()
+{
+	if (m_IsAsync)
+	{
+		return;
+	}
+
+	if (m_Queue == nullptr)
+	{
+		m_Queue = std::make_unique<sQueueSlot[]>(QueueSize);
+		for (size_t i = 0; i < QueueSize; i++)
+		{
+			m_Queue[i].m_Sequence.store(i, std::memory_order_relaxed);
+		}
+	}
+
+	m_WriterThread = std::make_unique<cWriterThread>(*this);
+	m_WriterThread->Start();
+	m_IsAsync.store(true, std::memory_order_release);
+}
+
+
+
+
+
+void cLogger::StopAsync()
+{
+	if (!m_IsAsync)
+	{
+		return;
+	}
+
+	// No new message gets queued after this, but the producers that have seen the flag set may still be queueing theirs:
+	m_IsAsync.store(false);
+	m_WriterThread->Stop();
+	m_WriterThread.reset();
+	while (m_NumQueueing.load(std::memory_order_acquire) != 0)
+	{
+		std::this_thread::yield();
+	}
+
+	// Drain the queue again, the writer may have stopped before the last producers finished:
+	Flush();
+}
+
+
+
+
+
+void cLogger::Flush()
+{
+	cCSLock Lock(m_CriticalSection);
+	WriteQueuedLines();
+}
+
+
+
+
+
+void cLogger::TryFlush()
+{
+	// The CS is recursive, bail out if the crash interrupted this very thread in the middle of writing:
+	if (m_CriticalSection.IsLockedByCurrentThread() || !m_CriticalSection.TryLock())
+	{
+		return;
 	}
+	WriteQueuedLines();
+	m_CriticalSection.Unlock();
 }
 
 
@@ -11,6 +11,9 @@ public:
 		public:
 		virtual void Log(std::string_view a_Message, eLogLevel a_LogLevel) = 0;
 
+		/** Called after a batch of messages has been logged, the listener may flush its output here. */
+		virtual void Flush() {}
+
 		virtual ~cListener(){}
 	};
 
@@ -60,6 +63,21 @@ public:
 
 	cAttachment AttachListener(std::unique_ptr<cListener> a_Listener);
 
+	/** Starts handing the messages to the listeners from a separate writer thread.
+	The logging threads only put the messages into a lock-free queue, they don't wait for any I/O.
+	When the queue is full, regular and info messages are dropped (the writer reports how many), warnings and errors are written right away. */
+	void StartAsync();
+
+	/** Writes out the queued messages, stops the writer thread and returns to writing the messages synchronously. */
+	void StopAsync();
+
+	/** Writes out the queued messages from the calling thread. */
+	void Flush();
+
+	/** Writes out the queued messages from the calling thread, unless another thread is writing them at the moment, or this thread was interrupted while writing them.
+	Never waits for the lock. Used on crash, so that the last messages aren't lost without risking a deadlock in the signal handler. */
+	void TryFlush();
+
 	static cLogger & GetInstance(void);
 
 	// Must be called before calling GetInstance in a multithreaded context
@@ -67,9 +85,55 @@ public:
 
 private:
 
+	class cWriterThread;
+
+	/** A single message in the async queue.
+	m_Sequence tells whether the slot is free for the writing position, or holds a message for the reading position. */
+	struct sQueueSlot
+	{
+		std::atomic<size_t> m_Sequence;
+		AString m_Line;
+		eLogLevel m_LogLevel;
+	};
+
+	/** Number of the slots in the async queue, must be a power of two. */
+	static constexpr size_t QueueSize = 4096;
+
+	/** Protects the listeners; the reading from the async queue is serialized by it as well. */
 	cCriticalSection m_CriticalSection;
 	std::vector<std::unique_ptr<cListener>> m_LogListeners;
 
+	/** Set while the messages go through the async queue. */
+	std::atomic<bool> m_IsAsync = false;
+
+	/** The async queue, a bounded lock-free multi-producer ring of QueueSize slots.
+	Allocated on the first StartAsync() and kept until destruction, so that late producers can't write into freed memory. */
+	std::unique_ptr<sQueueSlot[]> m_Queue;
+
+	/** Position of the next slot to be claimed by a producer. */
+	std::atomic<size_t> m_QueueWritePos = 0;
+
+	/** Number of the threads currently between checking m_IsAsync and finishing QueueLine().
+	StopAsync() waits for it to drop to zero, so that no message is queued after its final flush. */
+	std::atomic<size_t> m_NumQueueing = 0;
+
+	/** Position of the next slot to be written out. Protected by m_CriticalSection. */
+	size_t m_QueueReadPos = 0;
+
+	/** Number of the messages dropped because the queue was full, since the last report. */
+	std::atomic<size_t> m_NumDropped = 0;
+
+	/** Wakes up the writer thread before its regular interval. */
+	cEvent m_WriterEvent;
+
+	std::unique_ptr<cWriterThread> m_WriterThread;
+
 	void DetachListener(cListener * a_Listener);
 	void LogLine(std::string_view a_Line, eLogLevel a_LogLevel);
+
+	/** Puts the line into the async queue. Returns false if the queue is full. */
+	bool QueueLine(std::string_view a_Line, eLogLevel a_LogLevel);
+
+	/** Hands all the queued lines to the listeners. Expects m_CriticalSection to be held. */
+	void WriteQueuedLines();
 };
@@ -147,6 +147,11 @@
 		{
 			// Whatever the console default is
 			printf("\x1b[0m");
+		}
+
+
+		virtual void Flush() override
+		{
 			fflush(stdout);
 		}
 	};
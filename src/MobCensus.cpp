@@ -7,23 +7,32 @@
 
 
 
-void cMobCensus::CollectMob(cMonster & a_Monster, cChunk & a_Chunk, double a_Distance)
+cMobCensus::cMobCensus(void) :
+	m_NumMobs(),
+	m_NumChunks(0)
 {
-	m_ProximityCounter.CollectMob(a_Monster, a_Chunk, a_Distance);
-	m_MobFamilyCollecter.CollectMob(a_Monster);
 }
 
 
 
 
 
-bool cMobCensus::IsCapped(cMonster::eFamily a_MobFamily)
+void cMobCensus::CollectMobs(cMonster::eFamily a_MobFamily, int a_NumMobs)
+{
+	m_NumMobs[static_cast<size_t>(a_MobFamily)] += a_NumMobs;
+}
+
+
+
+
+
+bool cMobCensus::IsCapped(cMonster::eFamily a_MobFamily) const
 {
 	const int ratio = 319;  // This should be 256 as we are only supposed to take account from chunks that are in 17 x 17 from a player
 	// but for now, we use all chunks loaded by players. that means 19 x 19 chunks. That's why we use 256 * (19 * 19) / (17 * 17) = 319
 	// MG TODO : code the correct count
-	const auto MobCap = ((GetCapMultiplier(a_MobFamily) * GetNumChunks()) / ratio);
-	return (MobCap < m_MobFamilyCollecter.GetNumberOfCollectedMobs(a_MobFamily));
+	const auto MobCap = ((GetCapMultiplier(a_MobFamily) * m_NumChunks) / ratio);
+	return (MobCap < m_NumMobs[static_cast<size_t>(a_MobFamily)]);
 }
 
 
@@ -52,40 +61,22 @@ int cMobCensus::GetCapMultiplier(cMonster::eFamily a_MobFamily)
 
 void cMobCensus::CollectSpawnableChunk(cChunk & a_Chunk)
 {
-	m_EligibleForSpawnChunks.insert(&a_Chunk);
-}
-
-
-
-
-
-int cMobCensus::GetNumChunks(void)
-{
-	return static_cast<int>(m_EligibleForSpawnChunks.size());
+	UNUSED(a_Chunk);
+	m_NumChunks += 1;
 }
 
 
 
 
 
-cMobProximityCounter & cMobCensus::GetProximityCounter(void)
+void cMobCensus::Logd() const
 {
-	return m_ProximityCounter;
+	LOGD("Hostile mobs : %d %s", m_NumMobs[cMonster::mfHostile], IsCapped(cMonster::mfHostile) ? "(capped)" : "");
+	LOGD("Ambient mobs : %d %s", m_NumMobs[cMonster::mfAmbient], IsCapped(cMonster::mfAmbient) ? "(capped)" : "");
+	LOGD("Water mobs   : %d %s", m_NumMobs[cMonster::mfWater],   IsCapped(cMonster::mfWater)   ? "(capped)" : "");
+	LOGD("Passive mobs : %d %s", m_NumMobs[cMonster::mfPassive], IsCapped(cMonster::mfPassive) ? "(capped)" : "");
 }
 
 
 
 
-
-void cMobCensus::Logd()
-{
-	LOGD("Hostile mobs : %d %s", m_MobFamilyCollecter.GetNumberOfCollectedMobs(cMonster::mfHostile), IsCapped(cMonster::mfHostile) ? "(capped)" : "");
-	LOGD("Ambient mobs : %d %s", m_MobFamilyCollecter.GetNumberOfCollectedMobs(cMonster::mfAmbient), IsCapped(cMonster::mfAmbient) ? "(capped)" : "");
-	LOGD("Water mobs   : %d %s", m_MobFamilyCollecter.GetNumberOfCollectedMobs(cMonster::mfWater),   IsCapped(cMonster::mfWater)   ? "(capped)" : "");
-	LOGD("Passive mobs : %d %s", m_MobFamilyCollecter.GetNumberOfCollectedMobs(cMonster::mfPassive), IsCapped(cMonster::mfPassive) ? "(capped)" : "");
-}
-
-
-
-
-
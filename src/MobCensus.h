@@ -1,54 +1,48 @@
 
 #pragma once
 
-#include "MobProximityCounter.h"
-#include "MobFamilyCollecter.h"
+#include "Mobs/Monster.h"  // This is a side-effect of keeping Mobfamily inside Monster class. I'd prefer to keep both (Mobfamily and Monster) inside a "Monster" namespace MG TODO : do it
 
 
 
 
 // fwd:
 class cChunk;
-class cMonster;
 
 
 
 
 
-/** This class is used to collect information, for each Mob, what is the distance of the closest player
-it was first being designed in order to make mobs spawn / despawn / act
-as the behaviour and even life of mobs depends on the distance to closest player
-
-as side effect : it also collect the chunks that are elligible for spawning
-as side effect 2 : it also know the caps for mobs number and can compare census to this numbers
-*/
+/** This class is used to count the mobs of each family in the chunks that are eligible for spawning,
+so that the spawning can compare the numbers to the caps.
+The chunks keep their own per-family mob counts up to date as mobs are added, removed and cross chunk borders,
+so the census only sums those counts; it doesn't visit the individual mobs.
+The distance to players only matters for the spawn position, so it is checked by cChunk::SpawnMobs() instead. */
 class cMobCensus
 {
 public:
-	/** Returns the nested proximity counter */
-	cMobProximityCounter & GetProximityCounter(void);
+	cMobCensus(void);
 
 	// collect an elligible Chunk for Mob Spawning
 	// MG TODO : code the correct rule (not loaded chunk but short distant from players)
 	void CollectSpawnableChunk(cChunk & a_Chunk);
 
-	/** Collect a mob - its distance to player, its family ... */
-	void CollectMob(cMonster & a_Monster, cChunk & a_Chunk, double a_Distance);
+	/** Adds the specified number of mobs of the family to the census. */
+	void CollectMobs(cMonster::eFamily a_MobFamily, int a_NumMobs);
 
 	/** Returns true if the family is capped (i.e. there are more mobs of this family than max) */
-	bool IsCapped(cMonster::eFamily a_MobFamily);
+	bool IsCapped(cMonster::eFamily a_MobFamily) const;
 
 	/** log the results of census to server console */
-	void Logd(void);
+	void Logd(void) const;
 
 protected :
-	cMobProximityCounter m_ProximityCounter;
-	cMobFamilyCollecter m_MobFamilyCollecter;
 
-	std::set<cChunk *> m_EligibleForSpawnChunks;
+	/** Number of mobs collected for each family, indexed by cMonster::eFamily. */
+	std::array<int, cMonster::mfNoSpawn + 1> m_NumMobs;
 
-	/** Returns the number of chunks that are elligible for spawning (for now, the loaded, valid chunks) */
-	int GetNumChunks();
+	/** The number of chunks that are elligible for spawning (for now, the loaded, valid chunks) */
+	int m_NumChunks;
 
 	/** Returns the cap multiplier value of the given monster family */
 	static int GetCapMultiplier(cMonster::eFamily a_MobFamily);
@@ -43,6 +43,7 @@ static void NonCtrlHandler(int a_Signal)
 				"       | from commit " BUILD_COMMIT_ID "\n"
 #endif
 			);
+			cLogger::GetInstance().TryFlush();
 
 			std::signal(SIGSEGV, SIG_DFL);
 			return;
@@ -64,6 +65,7 @@ static void NonCtrlHandler(int a_Signal)
 				"       | from commit " BUILD_COMMIT_ID "\n"
 #endif
 			);
+			cLogger::GetInstance().TryFlush();
 
 			std::signal(SIGSEGV, SIG_DFL);
 			return;
@@ -30,6 +30,22 @@ void cCriticalSection::Lock()
 
 
 
+bool cCriticalSection::TryLock()
+{
+	if (!m_Mutex.try_lock())
+	{
+		return false;
+	}
+
+	m_RecursionCount += 1;
+	m_OwningThreadID = std::this_thread::get_id();
+	return true;
+}
+
+
+
+
+
 void cCriticalSection::Unlock()
 {
 	ASSERT(IsLockedByCurrentThread());
@@ -13,6 +13,10 @@ public:
 	void Lock(void);
 	void Unlock(void);
 
+	/** Locks the CS if it is free (or already held by the calling thread), without waiting.
+	Returns true if the CS has been locked, it then needs to be unlocked by Unlock(). */
+	bool TryLock(void);
+
 	cCriticalSection(void);
 
 	/** Returns true if the CS is currently locked.
@@ -0,0 +1,153 @@
+
+// PermissionTrie.cpp
+
+// Implements the cPermissionTrie class that matches dot-delimited permissions against a set of templates with wildcards
+
+#include "Globals.h"
+#include "PermissionTrie.h"
+
+
+
+
+
+/** Calls a_Callback for each dot-delimited part of a_String, with the same rules as StringSplit(a_String, "."):
+empty parts are kept, except for a trailing one.
+Stops and returns false as soon as a_Callback returns false. */
+template <typename Callback>
+static bool ForEachPart(std::string_view a_String, Callback a_Callback)
+{
+	size_t Prev = 0;
+	size_t CutAt;
+	while ((CutAt = a_String.find('.', Prev)) != std::string_view::npos)
+	{
+		if (!a_Callback(a_String.substr(Prev, CutAt - Prev)))
+		{
+			return false;
+		}
+		Prev = CutAt + 1;
+	}
+	if (Prev < a_String.size())
+	{
+		return a_Callback(a_String.substr(Prev));
+	}
+	return true;
+}
+
+
+
+
+
+void cPermissionTrie::Clear(void)
+{
+	m_Root.m_Children.clear();
+	m_Root.m_IsTerminal = false;
+	m_Root.m_HasWildcard = false;
+}
+
+
+
+
+
+void cPermissionTrie::Add(const AString & a_Template)
+{
+	auto * Node = &m_Root;
+	const bool IsComplete = ForEachPart(a_Template, [&Node](std::string_view a_Part)
+	{
+		if (a_Part == "*")
+		{
+			Node->m_HasWildcard = true;
+			return false;
+		}
+
+		auto itr = Node->m_Children.find(a_Part);
+		if (itr == Node->m_Children.end())
+		{
+			itr = Node->m_Children.emplace(AString(a_Part), std::make_unique<sNode>()).first;
+		}
+		Node = itr->second.get();
+		return true;
+	});
+
+	if (IsComplete)
+	{
+		Node->m_IsTerminal = true;
+	}
+}
+
+
+
+
+
+void cPermissionTrie::Set(const AStringVector & a_Templates)
+{
+	Clear();
+	for (const auto & Template : a_Templates)
+	{
+		Add(Template);
+	}
+}
+
+
+
+
+
+bool cPermissionTrie::Matches(std::string_view a_Permission) const
+{
+	const auto * Node = &m_Root;
+	bool IsWildcardMatch = false;
+	const bool IsComplete = ForEachPart(a_Permission, [&Node, &IsWildcardMatch](std::string_view a_Part)
+	{
+		if (Node->m_HasWildcard)
+		{
+			// Has matched so far and now there's a wildcard in a template, so the permission matches:
+			IsWildcardMatch = true;
+			return false;
+		}
+
+		const auto itr = Node->m_Children.find(a_Part);
+		if (itr == Node->m_Children.end())
+		{
+			// Found a mismatch
+			return false;
+		}
+		Node = itr->second.get();
+		return true;
+	});
+
+	if (IsWildcardMatch)
+	{
+		return true;
+	}
+
+	// All the parts have matched, the permission matches if a template ends here:
+	return IsComplete && Node->m_IsTerminal;
+}
+
+
+
+
+
+bool cPermissionTrie::TemplateMatches(const AStringVector & a_Permission, const AStringVector & a_Template)
+{
+	// Check the sub-items if they are the same or there's a wildcard:
+	size_t lenP = a_Permission.size();
+	size_t lenT = a_Template.size();
+	size_t minLen = std::min(lenP, lenT);
+	for (size_t i = 0; i < minLen; i++)
+	{
+		if (a_Template[i] == "*")
+		{
+			// Has matched so far and now there's a wildcard in the template, so the permission matches:
+			return true;
+		}
+		if (a_Permission[i] != a_Template[i])
+		{
+			// Found a mismatch
+			return false;
+		}
+	}
+
+	// So far all the sub-items have matched
+	// If the sub-item count is the same, then the permission matches
+	return (lenP == lenT);
+}
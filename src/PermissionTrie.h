@@ -0,0 +1,59 @@
+
+// PermissionTrie.h
+
+// Declares the cPermissionTrie class that matches dot-delimited permissions against a set of templates with wildcards
+
+
+
+
+
+#pragma once
+
+
+
+
+
+/** A set of permission templates (such as "core.teleport" or "worldedit.*"), compiled into a trie of their dot-delimited parts.
+A permission matches a template if all their parts are the same, or if all the parts are the same up to a "*" part in the template;
+ie. "a.b.c" matches both "a.b.c" and "a.*", but doesn't match "a.b".
+This is the same rule as TemplateMatches(), but a lookup neither splits the permission into strings nor
+scans all the templates; it walks down the trie, comparing each part against the interned parts stored in the nodes. */
+class cPermissionTrie
+{
+public:
+
+	/** Removes all the templates. */
+	void Clear(void);
+
+	/** Adds the specified template. The parts after a "*" part are ignored, since the wildcard matches anything. */
+	void Add(const AString & a_Template);
+
+	/** Replaces the contents with the specified templates. */
+	void Set(const AStringVector & a_Templates);
+
+	/** Returns true if the permission matches any of the templates. */
+	bool Matches(std::string_view a_Permission) const;
+
+	/** Returns true iff a_Permission matches the a_Template, both already split into their dot-delimited parts.
+	A match is defined by either being exactly the same, or each sub-item matches until there's a wildcard in a_Template.
+	Ie. {"a", "b", "c"} matches {"a", "b", "*"} but doesn't match {"a", "b"}
+	Used by cPlayer::PermissionMatches(). */
+	static bool TemplateMatches(const AStringVector & a_Permission, const AStringVector & a_Template);
+
+private:
+
+	struct sNode
+	{
+		/** The child nodes, for each possible next part of the templates.
+		Uses a transparent comparator, so that it can be searched with a string_view without allocating. */
+		std::map<AString, std::unique_ptr<sNode>, std::less<>> m_Children;
+
+		/** True if a template ends at this node. */
+		bool m_IsTerminal = false;
+
+		/** True if a template has a "*" as the next part; any permission that reaches this node and has more parts matches. */
+		bool m_HasWildcard = false;
+	};
+
+	sNode m_Root;
+};
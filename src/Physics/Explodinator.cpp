@@ -22,6 +22,17 @@ namespace Explodinator
 	static const auto TraceCubeSideLength = 16U;
 	static const auto BoundingBoxStepUnit = 0.5;
 
+	/** A stack of items dropped by the explosion, together with the position of the first block that dropped it. */
+	struct sDrop
+	{
+		cItem m_Item;
+		Vector3i m_Position;
+	};
+
+	/** The items dropped by all the blocks destroyed by an explosion.
+	Same items are merged into full stacks, so that a blast through a wall of dirt spawns a few pickups instead of hundreds. */
+	using cDrops = std::vector<sDrop>;
+
 	/** Converts an absolute floating-point Position into a Chunk-relative one. */
 	static Vector3f AbsoluteToRelative(const Vector3f a_Position, const cChunkCoords a_ChunkPosition)
 	{
@@ -428,10 +439,48 @@ namespace Explodinator
 		cBlockHandler::For(a_DestroyedBlock.Type()).OnBroken(Interface, a_World, a_AbsolutePosition, a_DestroyedBlock, a_ExplodingEntity);
 	}
 
+	/** Merges the items dropped by a destroyed block at the given position into the explosion's drops. */
+	static void AddDrops(cDrops & a_Drops, const cItems & a_Items, const Vector3i a_Position)
+	{
+		for (auto Item : a_Items)
+		{
+			const auto MaxStackSize = Item.GetMaxStackSize();
+			for (auto & Drop : a_Drops)
+			{
+				if (Item.m_ItemCount <= 0)
+				{
+					break;
+				}
+				if ((Drop.m_Item.m_ItemCount >= MaxStackSize) || !Drop.m_Item.IsEqual(Item))
+				{
+					continue;
+				}
+
+				const auto Moved = std::min<char>(Item.m_ItemCount, MaxStackSize - Drop.m_Item.m_ItemCount);
+				Drop.m_Item.m_ItemCount += Moved;
+				Item.m_ItemCount -= Moved;
+			}
+
+			if (Item.m_ItemCount > 0)
+			{
+				a_Drops.push_back({ std::move(Item), a_Position });
+			}
+		}
+	}
+
+	/** Spawns one pickup for each merged stack of the explosion's drops. */
+	static void SpawnDrops(cWorld & a_World, const cDrops & a_Drops)
+	{
+		for (const auto & Drop : a_Drops)
+		{
+			a_World.SpawnItemPickups(cItems(cItem(Drop.m_Item)), Drop.m_Position);
+		}
+	}
+
 	/** Work out what should happen when an explosion destroys the given block.
 	Tasks include lighting TNT, dropping pickups, setting fire and flinging shrapnel according to Minecraft rules.
 	OK, _mostly_ Minecraft rules. */
-	static void DestroyBlock(cChunk & a_Chunk, const Vector3i a_Position, const int a_Power, const bool a_Fiery, const cEntity * const a_ExplodingEntity)
+	static void DestroyBlock(cChunk & a_Chunk, const Vector3i a_Position, const int a_Power, const bool a_Fiery, const cEntity * const a_ExplodingEntity, cDrops & a_Drops)
 	{
 		const auto DestroyedBlock = a_Chunk.GetBlock(a_Position);
 		if (IsBlockAir(DestroyedBlock))
@@ -455,7 +504,7 @@ namespace Explodinator
 		}
 		else if ((a_ExplodingEntity != nullptr) && (a_ExplodingEntity->IsTNT() || BlockAlwaysDrops(DestroyedBlock) || Random.RandBool(1.f / a_Power)))  // For TNT explosions, destroying a block that always drops, or if RandBool, drop pickups
 		{
-			a_Chunk.GetWorld()->SpawnItemPickups(cBlockHandler::For(DestroyedBlock.Type()).ConvertToPickups(DestroyedBlock), Absolute);
+			AddDrops(a_Drops, cBlockHandler::For(DestroyedBlock.Type()).ConvertToPickups(DestroyedBlock), Absolute);
 		}
 		else if (a_Fiery && Random.RandBool(1 / 3.0))  // 33% chance of starting fires if it can start fires
 		{
@@ -484,8 +533,9 @@ namespace Explodinator
 		SetBlock(World, a_Chunk, Absolute, a_Position, DestroyedBlock, Block::Air::Air(), a_ExplodingEntity);
 	}
 
-	/** Traces the path taken by one Explosion Lazor (tm) with given direction and intensity, that will destroy blocks until it is exhausted. */
-	static void DestructionTrace(cChunk * a_Chunk, Vector3f a_Origin, const Vector3f a_Direction, const int a_Power, const bool a_Fiery, float a_Intensity, const cEntity * const a_ExplodingEntity)
+	/** Traces the path taken by one Explosion Lazor (tm) with given direction and intensity, marking the blocks it destroys until it is exhausted.
+	The absolute positions of the destroyed blocks are appended to a_Destroyed; the world isn't modified, so that all the rays see the blocks as they were before the blast. */
+	static void DestructionTrace(cChunk * a_Chunk, Vector3f a_Origin, const Vector3f a_Direction, float a_Intensity, std::vector<Vector3i> & a_Destroyed)
 	{
 		// The current position the ray is at.
 		auto Checkpoint = a_Origin;
@@ -515,7 +565,7 @@ namespace Explodinator
 				break;
 			}
 
-			DestroyBlock(*Neighbour, Position, a_Power, a_Fiery, a_ExplodingEntity);
+			a_Destroyed.push_back(cChunkDef::RelativeToAbsolute(Position, Neighbour->GetPos()));
 
 			// Adjust coordinates to be relative to the neighbour chunk:
 			Checkpoint = RebaseRelativePosition(a_Chunk->GetPos(), Neighbour->GetPos(), Checkpoint);
@@ -534,12 +584,14 @@ namespace Explodinator
 		return a_Power * (0.7f + a_Random.RandReal(0.6f));
 	}
 
-	/** Sends out Explosion Lazors (tm) originating from the given position that destroy blocks. */
-	static void DamageBlocks(cChunk & a_Chunk, const Vector3f a_Position, const int a_Power, const bool a_Fiery, const cEntity * const a_ExplodingEntity)
+	/** Sends out Explosion Lazors (tm) originating from the given position, returning the absolute positions of the blocks they destroy.
+	Each block is listed once, even if hit by several rays, and the list is sorted by chunk and height so that it can be applied chunk by chunk. */
+	static std::vector<Vector3i> TraceBlocks(cChunk & a_Chunk, const Vector3f a_Position, const int a_Power)
 	{
 		// Oh boy... Better hope you have a hot cache, 'cos this little manoeuvre's gonna cost us 1352 raytraces in one tick...
 		const int HalfSide = TraceCubeSideLength / 2;
 		auto & Random = GetRandomProvider();
+		std::vector<Vector3i> Destroyed;
 
 		// The following loops implement the tracing algorithm described in http://minecraft.wiki/w/Explosion
 
@@ -549,8 +601,8 @@ namespace Explodinator
 		{
 			for (float OffsetZ = -HalfSide; OffsetZ < HalfSide; OffsetZ++)
 			{
-				DestructionTrace(&a_Chunk, a_Position, Vector3f(OffsetX, +HalfSide, OffsetZ), a_Power, a_Fiery, RandomIntensity(Random, a_Power), a_ExplodingEntity);
-				DestructionTrace(&a_Chunk, a_Position, Vector3f(OffsetX, -HalfSide, OffsetZ), a_Power, a_Fiery, RandomIntensity(Random, a_Power), a_ExplodingEntity);
+				DestructionTrace(&a_Chunk, a_Position, Vector3f(OffsetX, +HalfSide, OffsetZ), RandomIntensity(Random, a_Power), Destroyed);
+				DestructionTrace(&a_Chunk, a_Position, Vector3f(OffsetX, -HalfSide, OffsetZ), RandomIntensity(Random, a_Power), Destroyed);
 			}
 		}
 
@@ -559,8 +611,8 @@ namespace Explodinator
 		{
 			for (float OffsetY = -HalfSide + 1; OffsetY < HalfSide - 1; OffsetY++)
 			{
-				DestructionTrace(&a_Chunk, a_Position, Vector3f(OffsetX, OffsetY, +HalfSide), a_Power, a_Fiery, RandomIntensity(Random, a_Power), a_ExplodingEntity);
-				DestructionTrace(&a_Chunk, a_Position, Vector3f(OffsetX, OffsetY, -HalfSide), a_Power, a_Fiery, RandomIntensity(Random, a_Power), a_ExplodingEntity);
+				DestructionTrace(&a_Chunk, a_Position, Vector3f(OffsetX, OffsetY, +HalfSide), RandomIntensity(Random, a_Power), Destroyed);
+				DestructionTrace(&a_Chunk, a_Position, Vector3f(OffsetX, OffsetY, -HalfSide), RandomIntensity(Random, a_Power), Destroyed);
 			}
 		}
 
@@ -569,10 +621,53 @@ namespace Explodinator
 		{
 			for (float OffsetY = -HalfSide + 1; OffsetY < HalfSide - 1; OffsetY++)
 			{
-				DestructionTrace(&a_Chunk, a_Position, Vector3f(+HalfSide, OffsetY, OffsetZ), a_Power, a_Fiery, RandomIntensity(Random, a_Power), a_ExplodingEntity);
-				DestructionTrace(&a_Chunk, a_Position, Vector3f(-HalfSide, OffsetY, OffsetZ), a_Power, a_Fiery, RandomIntensity(Random, a_Power), a_ExplodingEntity);
+				DestructionTrace(&a_Chunk, a_Position, Vector3f(+HalfSide, OffsetY, OffsetZ), RandomIntensity(Random, a_Power), Destroyed);
+				DestructionTrace(&a_Chunk, a_Position, Vector3f(-HalfSide, OffsetY, OffsetZ), RandomIntensity(Random, a_Power), Destroyed);
 			}
 		}
+
+		// Neighbouring rays overlap a lot near the centre, remove the duplicates:
+		std::sort(Destroyed.begin(), Destroyed.end(), [](const Vector3i a_Lhs, const Vector3i a_Rhs)
+		{
+			const auto LhsChunk = cChunkDef::BlockToChunk(a_Lhs);
+			const auto RhsChunk = cChunkDef::BlockToChunk(a_Rhs);
+			return
+				std::tie(LhsChunk.m_ChunkX, LhsChunk.m_ChunkZ, a_Lhs.y, a_Lhs.z, a_Lhs.x) <
+				std::tie(RhsChunk.m_ChunkX, RhsChunk.m_ChunkZ, a_Rhs.y, a_Rhs.z, a_Rhs.x);
+		});
+		Destroyed.erase(std::unique(Destroyed.begin(), Destroyed.end()), Destroyed.end());
+		return Destroyed;
+	}
+
+	/** Destroys the blocks hit by the explosion, chunk by chunk, and spawns their merged drops. */
+	static void DamageBlocks(cChunk & a_Chunk, const Vector3f a_Position, const int a_Power, const bool a_Fiery, const cEntity * const a_ExplodingEntity)
+	{
+		const auto Destroyed = TraceBlocks(a_Chunk, a_Position, a_Power);
+		cDrops Drops;
+
+		// The positions are sorted by chunk, so the neighbour lookup is only needed when crossing into the next chunk:
+		cChunk * Chunk = nullptr;
+		for (const auto & Absolute : Destroyed)
+		{
+			auto Relative = cChunkDef::AbsoluteToRelative(Absolute, a_Chunk.GetPos());
+			if ((Chunk == nullptr) || (Chunk->GetPos() != cChunkDef::BlockToChunk(Absolute)))
+			{
+				Chunk = a_Chunk.GetRelNeighborChunkAdjustCoords(Relative);
+				if ((Chunk == nullptr) || !Chunk->IsValid())
+				{
+					Chunk = nullptr;
+					continue;
+				}
+			}
+			else
+			{
+				Relative = cChunkDef::AbsoluteToRelative(Absolute, Chunk->GetPos());
+			}
+
+			DestroyBlock(*Chunk, Relative, a_Power, a_Fiery, a_ExplodingEntity, Drops);
+		}
+
+		SpawnDrops(*a_Chunk.GetWorld(), Drops);
 	}
 
 	/** Sends an explosion packet to all clients in the given chunk. */
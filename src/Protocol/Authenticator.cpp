@@ -25,8 +25,73 @@ constexpr char DEFAULT_AUTH_ADDRESS[] = "/session/minecraft/hasJoined?username=%
 
 
 
+class cAuthenticator::cRequest:
+	public cUrlClient::cCallbacks
+{
+public:
+
+	cRequest(cUser && a_User, std::shared_ptr<cEvent> a_Event, std::chrono::steady_clock::time_point a_Deadline):
+		m_User(std::move(a_User)),
+		m_Deadline(a_Deadline),
+		m_Event(std::move(a_Event)),
+		m_IsFinished(false),
+		m_IsError(false)
+	{
+	}
+
+	/** Returns true once the response has been fully received, or the request failed. */
+	bool IsFinished(void) const { return m_IsFinished.load(std::memory_order_acquire); }
+
+	/** The response body. Only valid once IsFinished() returns true. */
+	const AString & GetResponse(void) const { return m_Response; }
+
+	/** Returns true if the request failed. Only valid once IsFinished() returns true. */
+	bool IsError(void) const { return m_IsError; }
+
+	cUser m_User;
+
+	/** When the user gets kicked if there's still no response. */
+	std::chrono::steady_clock::time_point m_Deadline;
+
+private:
+
+	std::shared_ptr<cEvent> m_Event;
+
+	AString m_Response;
+
+	std::atomic<bool> m_IsFinished;
+
+	bool m_IsError;
+
+	virtual void OnBodyData(const void * a_Data, size_t a_Size) override
+	{
+		m_Response.append(static_cast<const char *>(a_Data), a_Size);
+	}
+
+	virtual void OnBodyFinished() override
+	{
+		m_IsFinished.store(true, std::memory_order_release);
+		m_Event->Set();
+	}
+
+	virtual void OnError(const AString & a_ErrorMsg) override
+	{
+		LOGWARNING("%s: HTTP error while authenticating user %s: %s", __FUNCTION__, m_User.m_Name.c_str(), a_ErrorMsg.c_str());
+		m_IsError = true;
+		m_IsFinished.store(true, std::memory_order_release);
+		m_Event->Set();
+	}
+};
+
+
+
+
+
 cAuthenticator::cAuthenticator(void) :
 	Super("Authenticator"),
+	m_Event(std::make_shared<cEvent>()),
+	m_MaxConcurrentRequests(16),
+	m_RequestTimeout(std::chrono::seconds(10)),
 	m_Server(DEFAULT_AUTH_SERVER),
 	m_Address(DEFAULT_AUTH_ADDRESS),
 	m_ShouldAuthenticate(true)
@@ -51,6 +116,8 @@ void cAuthenticator::ReadSettings(cSettingsRepositoryInterface & a_Settings)
 	m_Server             = a_Settings.GetValueSet ("Authentication", "Server", DEFAULT_AUTH_SERVER);
 	m_Address            = a_Settings.GetValueSet ("Authentication", "Address", DEFAULT_AUTH_ADDRESS);
 	m_ShouldAuthenticate = a_Settings.GetValueSetB("Authentication", "Authenticate", true);
+	m_MaxConcurrentRequests = static_cast<size_t>(std::max(1, a_Settings.GetValueSetI("Authentication", "MaxConcurrentRequests", 16)));
+	m_RequestTimeout = std::chrono::seconds(std::max(1, a_Settings.GetValueSetI("Authentication", "RequestTimeoutSec", 10)));
 
 	// prepend https:// if missing
 	constexpr std::string_view HttpPrefix = "http://";
@@ -104,7 +171,7 @@ void cAuthenticator::Authenticate(int a_ClientID, const std::string_view a_Usern
 
 	cCSLock Lock(m_CS);
 	m_Queue.emplace_back(a_ClientID, a_Username, a_ServerHash);
-	m_QueueNonempty.Set();
+	m_Event->Set();
 }
 
 
@@ -124,7 +191,7 @@ void cAuthenticator::Start(cSettingsRepositoryInterface & a_Settings)
 void cAuthenticator::Stop(void)
 {
 	m_ShouldTerminate = true;
-	m_QueueNonempty.Set();
+	m_Event->Set();
 	Super::Stop();
 }
 
@@ -134,68 +201,113 @@ void cAuthenticator::Stop(void)
 
 void cAuthenticator::Execute(void)
 {
-	for (;;)
+	// The responses are checked for timeouts at least this often:
+	static const unsigned TimeoutCheckIntervalMSec = 1000;
+
+	while (!m_ShouldTerminate)
+	{
+		m_Event->Wait(TimeoutCheckIntervalMSec);
+		if (m_ShouldTerminate)
+		{
+			break;
+		}
+		FinishRequests();
+		SendRequests();
+	}
+
+	// Any responses still to come are ignored, the requests keep themselves alive until then:
+	m_InFlight.clear();
+}
+
+
+
+
+
+void cAuthenticator::SendRequests(void)
+{
+	cUserList Users;
 	{
 		cCSLock Lock(m_CS);
-		while (!m_ShouldTerminate && (m_Queue.size() == 0))
+		while (!m_Queue.empty() && (m_InFlight.size() + Users.size() < m_MaxConcurrentRequests))
 		{
-			cCSUnlock Unlock(Lock);
-			m_QueueNonempty.Wait();
+			Users.push_back(std::move(m_Queue.front()));
+			m_Queue.pop_front();
 		}
-		if (m_ShouldTerminate)
+	}
+
+	for (auto & User : Users)
+	{
+		LOGD("Trying to authenticate user %s", User.m_Name.c_str());
+
+		// Create the GET request:
+		AString ActualAddress = m_Address;
+		ReplaceURL(ActualAddress, "%USERNAME%", User.m_Name);
+		ReplaceURL(ActualAddress, "%SERVERID%", User.m_ServerID);
+
+		// Send the request, the response is received in the network thread:
+		const int ClientID = User.m_ClientID;
+		auto Request = std::make_shared<cRequest>(std::move(User), m_Event, std::chrono::steady_clock::now() + m_RequestTimeout);
+		auto [IsSuccessful, ErrorMessage] = cUrlClient::Get(m_Server + ActualAddress, Request);
+		if (!IsSuccessful)
 		{
-			return;
+			LOGWARNING("%s: HTTP error: %s", __FUNCTION__, ErrorMessage.c_str());
+			cRoot::Get()->KickUser(ClientID, "Failed to authenticate account!");
+			continue;
 		}
-		ASSERT(!m_Queue.empty());
+		m_InFlight.push_back(std::move(Request));
+	}
+}
+
+
 
-		cAuthenticator::cUser User = std::move(m_Queue.front());
-		int & ClientID = User.m_ClientID;
-		AString & Username = User.m_Name;
-		AString & ServerID = User.m_ServerID;
-		m_Queue.pop_front();
-		Lock.Unlock();
+
+
+void cAuthenticator::FinishRequests(void)
+{
+	const auto Now = std::chrono::steady_clock::now();
+	m_InFlight.erase(std::remove_if(m_InFlight.begin(), m_InFlight.end(), [Now](const std::shared_ptr<cRequest> & a_Request)
+	{
+		auto & User = a_Request->m_User;
+		if (!a_Request->IsFinished())
+		{
+			if (Now < a_Request->m_Deadline)
+			{
+				// Still waiting for the response:
+				return false;
+			}
+			LOGWARNING("Authentication of user %s timed out", User.m_Name.c_str());
+			cRoot::Get()->KickUser(User.m_ClientID, "Authentication timed out!");
+			return true;
+		}
 
 		cUUID UUID;
 		Json::Value Properties;
-		if (AuthWithYggdrasil(Username, ServerID, UUID, Properties))
+		if (!a_Request->IsError() && ParseAuthResponse(a_Request->GetResponse(), User.m_Name, UUID, Properties))
 		{
-			LOGINFO("User %s authenticated with UUID %s", Username.c_str(), UUID.ToShortString().c_str());
-			cRoot::Get()->GetServer()->AuthenticateUser(ClientID, std::move(Username), UUID, std::move(Properties));
+			LOGINFO("User %s authenticated with UUID %s", User.m_Name.c_str(), UUID.ToShortString().c_str());
+			cRoot::Get()->GetServer()->AuthenticateUser(User.m_ClientID, std::move(User.m_Name), UUID, std::move(Properties));
 		}
 		else
 		{
-			cRoot::Get()->KickUser(ClientID, "Failed to authenticate account!");
+			cRoot::Get()->KickUser(User.m_ClientID, "Failed to authenticate account!");
 		}
-	}  // for (-ever)
+		return true;
+	}), m_InFlight.end());
 }
 
 
 
 
 
-bool cAuthenticator::AuthWithYggdrasil(AString & a_UserName, const AString & a_ServerId, cUUID & a_UUID, Json::Value & a_Properties) const
+bool cAuthenticator::ParseAuthResponse(const AString & a_Response, AString & a_UserName, cUUID & a_UUID, Json::Value & a_Properties)
 {
-	LOGD("Trying to authenticate user %s", a_UserName.c_str());
-
-	// Create the GET request:
-	AString ActualAddress = m_Address;
-	ReplaceURL(ActualAddress, "%USERNAME%", a_UserName);
-	ReplaceURL(ActualAddress, "%SERVERID%", a_ServerId);
-
-	// Create and send the HTTP request
-	auto [IsSuccessful, Response] = cUrlClient::BlockingGet(m_Server + ActualAddress);
-	if (!IsSuccessful)
-	{
-		return false;
-	}
-
 	// Parse the Json response:
-	if (Response.empty())
+	if (a_Response.empty())
 	{
 		return false;
 	}
 	Json::Value root;
-	if (!JsonUtils::ParseString(Response, root))
+	if (!JsonUtils::ParseString(a_Response, root))
 	{
 		LOGWARNING("%s: Cannot parse received data (authentication) to JSON!", __FUNCTION__);
 		return false;
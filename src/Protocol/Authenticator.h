@@ -4,7 +4,8 @@
 // Interfaces to the cAuthenticator class representing the thread that authenticates users against the official Mojang servers
 // Authentication prevents "hackers" from joining with an arbitrary username (possibly impersonating the server admins)
 // For more info, see http://wiki.vg/Session
-// In Cuberite, authentication is implemented as a single thread that receives queued auth requests and dispatches them one by one.
+// In Cuberite, authentication is implemented as a single thread that receives queued auth requests and dispatches them
+// to the auth server asynchronously, with a limited number of requests in flight at once.
 
 
 
@@ -68,9 +69,24 @@ private:
 
 	using cUserList = std::deque<cUser>;
 
+	/** A single auth request sent to the server, receives the response in the network thread. */
+	class cRequest;
+
 	cCriticalSection m_CS;
 	cUserList        m_Queue;
-	cEvent           m_QueueNonempty;
+
+	/** Wakes up the thread when a user is queued or a response is received.
+	Shared with the requests, whose callbacks may come after the authenticator has been stopped. */
+	std::shared_ptr<cEvent> m_Event;
+
+	/** The requests that have been sent and wait for the response. Accessed only from the authenticator thread. */
+	std::vector<std::shared_ptr<cRequest>> m_InFlight;
+
+	/** The maximum number of requests in flight at once, the rest of the users wait in m_Queue. */
+	size_t m_MaxConcurrentRequests;
+
+	/** The time after which a user whose request hasn't been answered yet is kicked. */
+	std::chrono::steady_clock::duration m_RequestTimeout;
 
 	/** The server that is to be contacted for auth / UUID conversions */
 	AString m_Server;
@@ -87,9 +103,15 @@ private:
 	/** cIsThread override: */
 	virtual void Execute(void) override;
 
-	/** Returns true if the user authenticated okay, false on error
+	/** Sends the requests for the queued users, as long as there's room for more requests in flight. */
+	void SendRequests(void);
+
+	/** Authenticates or kicks the users whose requests have finished or timed out. */
+	void FinishRequests(void);
+
+	/** Returns true if the auth server's response authenticates the user okay, false on error
 	Returns the case-corrected username, UUID, and properties (eg. skin). */
-	bool AuthWithYggdrasil(AString & a_UserName, const AString & a_ServerId, cUUID & a_UUID, Json::Value & a_Properties) const;
+	static bool ParseAuthResponse(const AString & a_Response, AString & a_UserName, cUUID & a_UUID, Json::Value & a_Properties);
 };
 
 
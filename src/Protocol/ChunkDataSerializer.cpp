@@ -6,12 +6,11 @@
 #include "../ClientHandle.h"
 #include "../WorldStorage/FastNBT.h"
 #include "BlockEntities/BlockEntity.h"
+#include "Palettes/BlockMap.h"
 #include "Palettes/Upgrade.h"
 #include "Palettes/Palette_1_13.h"
 #include "Palettes/Palette_1_13_1.h"
 #include "Palettes/Palette_1_14.h"
-#include "Palettes/Palette_1_15.h"
-#include "Palettes/Palette_1_16.h"
 #include "Palettes/Palette_1_18.h"
 #include "Palettes/Palette_1_19.h"
 #include "Palettes/Palette_1_20.h"
@@ -19,6 +18,8 @@
 #include "Palettes/Palette_1_21_4.h"
 namespace
 {
+	using IdTable = BlockMap::IdTable;
+
 	std::pair<UInt16, size_t> GetSectionBitmask(const ChunkBlockData & a_BlockData, const ChunkLightData & a_LightData)
 	{
 		size_t Present = 0;
@@ -58,110 +59,34 @@ namespace
 		return { Mask, Present };
 	}
 
-	auto PaletteLegacy(const BlockState a_Block)
+	/* The palettes all take the protocol version's ID table, which the caller resolves once per chunk;
+	the hardcoded palettes of the older versions ignore it. */
+
+	auto PaletteLegacy(const IdTable *, const BlockState a_Block)
 	{
 		auto NumericBlock = PaletteUpgrade::ToBlock(a_Block);
 		return (NumericBlock.first << 4) | NumericBlock.second;
 	}
 
-	auto Palette393(const BlockState a_Block)
+	auto Palette393(const IdTable *, const BlockState a_Block)
 	{
 		return Palette_1_13::From(a_Block);
 	}
 
-	auto Palette401(const BlockState a_Block)
+	auto Palette401(const IdTable *, const BlockState a_Block)
 	{
 		return Palette_1_13_1::From(a_Block);
 	}
 
-	auto Palette477(const BlockState a_Block)
+	auto Palette477(const IdTable *, const BlockState a_Block)
 	{
 		return Palette_1_14::From(a_Block);
 	}
 
-	auto Palette573(const BlockState a_Block)
-	{
-		return Palette_1_15::From(a_Block);
-	}
-
-	auto Palette735(const BlockState a_Block)
-	{
-		return Palette_1_16::From(a_Block);
-	}
-
-	auto Palette751(const BlockState a_Block)
-	{
-		return cRoot::Get()->GetBlockMap()->GetProtocolBlockId(cProtocol::Version::v1_16_2, a_Block);
-	}
-
-	auto Palette755(const BlockState a_Block)
-	{
-		return cRoot::Get()->GetBlockMap()->GetProtocolBlockId(cProtocol::Version::v1_17, a_Block);
-	}
-
-	auto Palette757(const BlockState a_Block)
-	{
-		return cRoot::Get()->GetBlockMap()->GetProtocolBlockId(cProtocol::Version::v1_18, a_Block);
-	}
-
-	auto Palette759(const BlockState a_Block)
-	{
-		return cRoot::Get()->GetBlockMap()->GetProtocolBlockId(cProtocol::Version::v1_19, a_Block);
-	}
-
-	auto Palette760(const BlockState a_Block)
-	{
-		return cRoot::Get()->GetBlockMap()->GetProtocolBlockId(cProtocol::Version::v1_19_1, a_Block);
-	}
-
-	auto Palette761(const BlockState a_Block)
-	{
-		return cRoot::Get()->GetBlockMap()->GetProtocolBlockId(cProtocol::Version::v1_19_3, a_Block);
-	}
-
-	auto Palette762(const BlockState a_Block)
-	{
-		return cRoot::Get()->GetBlockMap()->GetProtocolBlockId(cProtocol::Version::v1_19_4, a_Block);
-	}
-
-	auto Palette763(const BlockState a_Block)
-	{
-		return cRoot::Get()->GetBlockMap()->GetProtocolBlockId(cProtocol::Version::v1_20, a_Block);
-	}
-
-	auto Palette764(const BlockState a_Block)
-	{
-		return cRoot::Get()->GetBlockMap()->GetProtocolBlockId(cProtocol::Version::v1_20_2, a_Block);
-	}
-
-	auto Palette766(const BlockState a_Block)
-	{
-		return cRoot::Get()->GetBlockMap()->GetProtocolBlockId(cProtocol::Version::v1_20_5, a_Block);
-	}
-
-	auto Palette767(const BlockState a_Block)
-	{
-		return cRoot::Get()->GetBlockMap()->GetProtocolBlockId(cProtocol::Version::v1_21, a_Block);
-	}
-
-	auto Palette768(const BlockState a_Block)
-	{
-		return cRoot::Get()->GetBlockMap()->GetProtocolBlockId(cProtocol::Version::v1_21_2, a_Block);
-	}
-
-	auto Palette769(const BlockState a_Block)
-	{
-		return cRoot::Get()->GetBlockMap()->GetProtocolBlockId(cProtocol::Version::v1_21_4, a_Block);
-	}
-
-	auto Palette770(const BlockState a_Block)
-	{
-		return cRoot::Get()->GetBlockMap()->GetProtocolBlockId(cProtocol::Version::v1_21_5, a_Block);
-	}
-
-	auto Palette771(const BlockState a_Block)
+	/** Translates the block through the ID table loaded from the version's blocks.json, without any locking. */
+	auto PaletteIdTable(const IdTable * a_IdTable, const BlockState a_Block)
 	{
-		return cRoot::Get()->GetBlockMap()->GetProtocolBlockId(cProtocol::Version::v1_21_6, a_Block);
+		return BlockMap::cBlockMap::ToProtocolBlockId(a_IdTable, a_Block);
 	}
 }
 
@@ -182,7 +107,7 @@ cChunkDataSerializer::cChunkDataSerializer(const eDimension a_Dimension) :
 
 
 
-void cChunkDataSerializer::SendToClients(const int a_ChunkX, const int a_ChunkZ, const ChunkBlockData & a_BlockData, const ChunkLightData & a_LightData, const unsigned char * a_BiomeMap, const std::vector<cBlockEntity *> & a_BlockEntities, const cChunkDef::HeightMap & a_SurfaceHeightMap, const ClientHandles & a_SendTo)
+void cChunkDataSerializer::SendToClients(const int a_ChunkX, const int a_ChunkZ, const UInt64 a_Revision, const ChunkBlockData & a_BlockData, const ChunkLightData & a_LightData, const unsigned char * a_BiomeMap, const std::vector<cBlockEntity *> & a_BlockEntities, const cChunkDef::HeightMap & a_SurfaceHeightMap, const ClientHandles & a_SendTo)
 {
 	for (const auto & Client : a_SendTo)
 	{
@@ -190,14 +115,14 @@ void cChunkDataSerializer::SendToClients(const int a_ChunkX, const int a_ChunkZ,
 		{
 			case cProtocol::Version::v1_8_0:
 			{
-				Serialize(Client, a_ChunkX, a_ChunkZ, a_BlockData, a_LightData, a_BiomeMap, a_BlockEntities, a_SurfaceHeightMap, CacheVersion::v47);
+				Serialize(Client, a_ChunkX, a_ChunkZ, a_Revision, a_BlockData, a_LightData, a_BiomeMap, a_BlockEntities, a_SurfaceHeightMap, CacheVersion::v47);
 				continue;
 			}
 			case cProtocol::Version::v1_9_0:
 			case cProtocol::Version::v1_9_1:
 			case cProtocol::Version::v1_9_2:
 			{
-				Serialize(Client, a_ChunkX, a_ChunkZ, a_BlockData, a_LightData, a_BiomeMap, a_BlockEntities, a_SurfaceHeightMap, CacheVersion::v107);
+				Serialize(Client, a_ChunkX, a_ChunkZ, a_Revision, a_BlockData, a_LightData, a_BiomeMap, a_BlockEntities, a_SurfaceHeightMap, CacheVersion::v107);
 				continue;
 			}
 			case cProtocol::Version::v1_9_4:
@@ -208,18 +133,18 @@ void cChunkDataSerializer::SendToClients(const int a_ChunkX, const int a_ChunkZ,
 			case cProtocol::Version::v1_12_1:
 			case cProtocol::Version::v1_12_2:
 			{
-				Serialize(Client, a_ChunkX, a_ChunkZ, a_BlockData, a_LightData, a_BiomeMap, a_BlockEntities, a_SurfaceHeightMap, CacheVersion::v110);
+				Serialize(Client, a_ChunkX, a_ChunkZ, a_Revision, a_BlockData, a_LightData, a_BiomeMap, a_BlockEntities, a_SurfaceHeightMap, CacheVersion::v110);
 				continue;
 			}
 			case cProtocol::Version::v1_13:
 			{
-				Serialize(Client, a_ChunkX, a_ChunkZ, a_BlockData, a_LightData, a_BiomeMap, a_BlockEntities, a_SurfaceHeightMap, CacheVersion::v393);  // This version didn't last very long xD
+				Serialize(Client, a_ChunkX, a_ChunkZ, a_Revision, a_BlockData, a_LightData, a_BiomeMap, a_BlockEntities, a_SurfaceHeightMap, CacheVersion::v393);  // This version didn't last very long xD
 				continue;
 			}
 			case cProtocol::Version::v1_13_1:
 			case cProtocol::Version::v1_13_2:
 			{
-				Serialize(Client, a_ChunkX, a_ChunkZ, a_BlockData, a_LightData, a_BiomeMap, a_BlockEntities, a_SurfaceHeightMap, CacheVersion::v401);
+				Serialize(Client, a_ChunkX, a_ChunkZ, a_Revision, a_BlockData, a_LightData, a_BiomeMap, a_BlockEntities, a_SurfaceHeightMap, CacheVersion::v401);
 				continue;
 			}
 			case cProtocol::Version::v1_14:
@@ -228,132 +153,137 @@ void cChunkDataSerializer::SendToClients(const int a_ChunkX, const int a_ChunkZ,
 			case cProtocol::Version::v1_14_3:
 			case cProtocol::Version::v1_14_4:
 			{
-				Serialize(Client, a_ChunkX, a_ChunkZ, a_BlockData, a_LightData, a_BiomeMap, a_BlockEntities, a_SurfaceHeightMap, CacheVersion::v477);
+				Serialize(Client, a_ChunkX, a_ChunkZ, a_Revision, a_BlockData, a_LightData, a_BiomeMap, a_BlockEntities, a_SurfaceHeightMap, CacheVersion::v477);
 				continue;
 			}
 			case cProtocol::Version::v1_15:
 			case cProtocol::Version::v1_15_1:
 			case cProtocol::Version::v1_15_2:
 			{
-				Serialize(Client, a_ChunkX, a_ChunkZ, a_BlockData, a_LightData, a_BiomeMap, a_BlockEntities, a_SurfaceHeightMap, CacheVersion::v573);
+				Serialize(Client, a_ChunkX, a_ChunkZ, a_Revision, a_BlockData, a_LightData, a_BiomeMap, a_BlockEntities, a_SurfaceHeightMap, CacheVersion::v573);
 				continue;
 			}
 			case cProtocol::Version::v1_16:
 			case cProtocol::Version::v1_16_1:
 			{
-				Serialize(Client, a_ChunkX, a_ChunkZ, a_BlockData, a_LightData, a_BiomeMap, a_BlockEntities, a_SurfaceHeightMap, CacheVersion::v735);
+				Serialize(Client, a_ChunkX, a_ChunkZ, a_Revision, a_BlockData, a_LightData, a_BiomeMap, a_BlockEntities, a_SurfaceHeightMap, CacheVersion::v735);
 				continue;
 			}
 			case cProtocol::Version::v1_16_2:
 			case cProtocol::Version::v1_16_3:
 			case cProtocol::Version::v1_16_4:
 			{
-				Serialize(Client, a_ChunkX, a_ChunkZ, a_BlockData, a_LightData, a_BiomeMap, a_BlockEntities, a_SurfaceHeightMap, CacheVersion::v751);
+				Serialize(Client, a_ChunkX, a_ChunkZ, a_Revision, a_BlockData, a_LightData, a_BiomeMap, a_BlockEntities, a_SurfaceHeightMap, CacheVersion::v751);
 				continue;
 			}
 			case cProtocol::Version::v1_17:
 			case cProtocol::Version::v1_17_1:
 			{
-				Serialize(Client, a_ChunkX, a_ChunkZ, a_BlockData, a_LightData, a_BiomeMap, a_BlockEntities, a_SurfaceHeightMap, CacheVersion::v755);
+				Serialize(Client, a_ChunkX, a_ChunkZ, a_Revision, a_BlockData, a_LightData, a_BiomeMap, a_BlockEntities, a_SurfaceHeightMap, CacheVersion::v755);
 				continue;
 			}
 			case cProtocol::Version::v1_18:
 			case cProtocol::Version::v1_18_2:
 			{
-				Serialize(Client, a_ChunkX, a_ChunkZ, a_BlockData, a_LightData, a_BiomeMap, a_BlockEntities, a_SurfaceHeightMap, CacheVersion::v757);
+				Serialize(Client, a_ChunkX, a_ChunkZ, a_Revision, a_BlockData, a_LightData, a_BiomeMap, a_BlockEntities, a_SurfaceHeightMap, CacheVersion::v757);
 				continue;
 			}
 			case cProtocol::Version::v1_19:
 			{
-				Serialize(Client, a_ChunkX, a_ChunkZ, a_BlockData, a_LightData, a_BiomeMap, a_BlockEntities, a_SurfaceHeightMap, CacheVersion::v759);
+				Serialize(Client, a_ChunkX, a_ChunkZ, a_Revision, a_BlockData, a_LightData, a_BiomeMap, a_BlockEntities, a_SurfaceHeightMap, CacheVersion::v759);
 				continue;
 			}
 			case cProtocol::Version::v1_19_1:
 			{
-				Serialize(Client, a_ChunkX, a_ChunkZ, a_BlockData, a_LightData, a_BiomeMap, a_BlockEntities, a_SurfaceHeightMap, CacheVersion::v760);
+				Serialize(Client, a_ChunkX, a_ChunkZ, a_Revision, a_BlockData, a_LightData, a_BiomeMap, a_BlockEntities, a_SurfaceHeightMap, CacheVersion::v760);
 				continue;
 			}
 			case cProtocol::Version::v1_19_3:
 			{
-				Serialize(Client, a_ChunkX, a_ChunkZ, a_BlockData, a_LightData, a_BiomeMap, a_BlockEntities, a_SurfaceHeightMap, CacheVersion::v761);
+				Serialize(Client, a_ChunkX, a_ChunkZ, a_Revision, a_BlockData, a_LightData, a_BiomeMap, a_BlockEntities, a_SurfaceHeightMap, CacheVersion::v761);
 				continue;
 			}
 			case cProtocol::Version::v1_19_4:
 			{
-				Serialize(Client, a_ChunkX, a_ChunkZ, a_BlockData, a_LightData, a_BiomeMap, a_BlockEntities, a_SurfaceHeightMap, CacheVersion::v762);
+				Serialize(Client, a_ChunkX, a_ChunkZ, a_Revision, a_BlockData, a_LightData, a_BiomeMap, a_BlockEntities, a_SurfaceHeightMap, CacheVersion::v762);
 				continue;
 			}
 			case cProtocol::Version::v1_20:
 			{
-				Serialize(Client, a_ChunkX, a_ChunkZ, a_BlockData, a_LightData, a_BiomeMap, a_BlockEntities, a_SurfaceHeightMap, CacheVersion::v763);
+				Serialize(Client, a_ChunkX, a_ChunkZ, a_Revision, a_BlockData, a_LightData, a_BiomeMap, a_BlockEntities, a_SurfaceHeightMap, CacheVersion::v763);
 				continue;
 			}
 			case cProtocol::Version::v1_20_2:
 			{
-				Serialize(Client, a_ChunkX, a_ChunkZ, a_BlockData, a_LightData, a_BiomeMap, a_BlockEntities, a_SurfaceHeightMap, CacheVersion::v764);
+				Serialize(Client, a_ChunkX, a_ChunkZ, a_Revision, a_BlockData, a_LightData, a_BiomeMap, a_BlockEntities, a_SurfaceHeightMap, CacheVersion::v764);
 				continue;
 			}
 			case cProtocol::Version::v1_20_3:
 			{
-				Serialize(Client, a_ChunkX, a_ChunkZ, a_BlockData, a_LightData, a_BiomeMap, a_BlockEntities, a_SurfaceHeightMap, CacheVersion::v765);
+				Serialize(Client, a_ChunkX, a_ChunkZ, a_Revision, a_BlockData, a_LightData, a_BiomeMap, a_BlockEntities, a_SurfaceHeightMap, CacheVersion::v765);
 				continue;
 			}
 			case cProtocol::Version::v1_20_5:
 			{
-				Serialize(Client, a_ChunkX, a_ChunkZ, a_BlockData, a_LightData, a_BiomeMap, a_BlockEntities, a_SurfaceHeightMap, CacheVersion::v766);
+				Serialize(Client, a_ChunkX, a_ChunkZ, a_Revision, a_BlockData, a_LightData, a_BiomeMap, a_BlockEntities, a_SurfaceHeightMap, CacheVersion::v766);
 				continue;
 			}
 			case cProtocol::Version::v1_21:
 			{
-				Serialize(Client, a_ChunkX, a_ChunkZ, a_BlockData, a_LightData, a_BiomeMap, a_BlockEntities, a_SurfaceHeightMap, CacheVersion::v767);
+				Serialize(Client, a_ChunkX, a_ChunkZ, a_Revision, a_BlockData, a_LightData, a_BiomeMap, a_BlockEntities, a_SurfaceHeightMap, CacheVersion::v767);
 				continue;
 			}
 			case cProtocol::Version::v1_21_2:
 			{
-				Serialize(Client, a_ChunkX, a_ChunkZ, a_BlockData, a_LightData, a_BiomeMap, a_BlockEntities, a_SurfaceHeightMap, CacheVersion::v768);
+				Serialize(Client, a_ChunkX, a_ChunkZ, a_Revision, a_BlockData, a_LightData, a_BiomeMap, a_BlockEntities, a_SurfaceHeightMap, CacheVersion::v768);
 				continue;
 			}
 			case cProtocol::Version::v1_21_4:
 			{
-				Serialize(Client, a_ChunkX, a_ChunkZ, a_BlockData, a_LightData, a_BiomeMap, a_BlockEntities, a_SurfaceHeightMap, CacheVersion::v769);
+				Serialize(Client, a_ChunkX, a_ChunkZ, a_Revision, a_BlockData, a_LightData, a_BiomeMap, a_BlockEntities, a_SurfaceHeightMap, CacheVersion::v769);
 				continue;
 			}
 			case cProtocol::Version::v1_21_5:
 			{
-				Serialize(Client, a_ChunkX, a_ChunkZ, a_BlockData, a_LightData, a_BiomeMap, a_BlockEntities, a_SurfaceHeightMap, CacheVersion::v770);
+				Serialize(Client, a_ChunkX, a_ChunkZ, a_Revision, a_BlockData, a_LightData, a_BiomeMap, a_BlockEntities, a_SurfaceHeightMap, CacheVersion::v770);
 				continue;
 			}
 			case cProtocol::Version::v1_21_6:
 			case cProtocol::Version::v1_21_7:
 			{
-				Serialize(Client, a_ChunkX, a_ChunkZ, a_BlockData, a_LightData, a_BiomeMap, a_BlockEntities, a_SurfaceHeightMap, CacheVersion::v771);
+				Serialize(Client, a_ChunkX, a_ChunkZ, a_Revision, a_BlockData, a_LightData, a_BiomeMap, a_BlockEntities, a_SurfaceHeightMap, CacheVersion::v771);
 				continue;
 			}
 		}
 		UNREACHABLE("Unknown chunk data serialization version");
 	}
-
-	// Our cache is only persistent during the function call:
-	for (auto & Cache : m_Cache)
-	{
-		Cache.Engaged = false;
-	}
 }
 
 
 
 
 
-inline void cChunkDataSerializer::Serialize(const ClientHandles::value_type & a_Client, const int a_ChunkX, const int a_ChunkZ, const ChunkBlockData & a_BlockData, const ChunkLightData & a_LightData, const unsigned char * a_BiomeMap, const std::vector<cBlockEntity *> & a_BlockEntities, const cChunkDef::HeightMap & a_SurfaceHeightMap, const CacheVersion a_CacheVersion)
+inline void cChunkDataSerializer::Serialize(const ClientHandles::value_type & a_Client, const int a_ChunkX, const int a_ChunkZ, const UInt64 a_Revision, const ChunkBlockData & a_BlockData, const ChunkLightData & a_LightData, const unsigned char * a_BiomeMap, const std::vector<cBlockEntity *> & a_BlockEntities, const cChunkDef::HeightMap & a_SurfaceHeightMap, const CacheVersion a_CacheVersion)
 {
-	auto & Cache = m_Cache[static_cast<size_t>(a_CacheVersion)];
-	if (Cache.Engaged)
+	const CacheKey Key{ { a_ChunkX, a_ChunkZ }, a_CacheVersion };
+	if (const auto Cached = m_CacheIndex.find(Key); Cached != m_CacheIndex.end())
 	{
-		// Success! We've done it already, just re-use:
-		a_Client->SendChunkData(a_ChunkX, a_ChunkZ, Cache.ToSend);
-		return;
+		const auto Entry = Cached->second;
+		if (Entry->Revision == a_Revision)
+		{
+			// Success! We've done it already, just re-use:
+			m_Cache.splice(m_Cache.begin(), m_Cache, Entry);
+			a_Client->SendChunkData(a_ChunkX, a_ChunkZ, Entry->ToSend);
+			return;
+		}
+
+		// The chunk has changed since, the cached packet is stale:
+		m_Cache.erase(Entry);
+		m_CacheIndex.erase(Cached);
 	}
 
+	// The ID tables of the newer versions are resolved once here, rather than for each block:
+	const auto BlockMap = cRoot::Get()->GetBlockMap();
 	switch (a_CacheVersion)
 	{
 		case CacheVersion::v47:
@@ -373,108 +303,107 @@ inline void cChunkDataSerializer::Serialize(const ClientHandles::value_type & a_
 		}
 		case CacheVersion::v393:
 		{
-			Serialize393<&Palette393>(a_ChunkX, a_ChunkZ, a_BlockData, a_LightData, a_BiomeMap);
+			Serialize393<&Palette393>(a_ChunkX, a_ChunkZ, a_BlockData, a_LightData, a_BiomeMap, nullptr);
 			break;
 		}
 		case CacheVersion::v401:
 		{
-			Serialize393<&Palette401>(a_ChunkX, a_ChunkZ, a_BlockData, a_LightData, a_BiomeMap);
+			Serialize393<&Palette401>(a_ChunkX, a_ChunkZ, a_BlockData, a_LightData, a_BiomeMap, nullptr);
 			break;
 		}
 		case CacheVersion::v477:
 		{
-			Serialize477<&Palette477>(a_ChunkX, a_ChunkZ, a_BlockData, a_LightData, a_BiomeMap);
+			Serialize477<&Palette477>(a_ChunkX, a_ChunkZ, a_BlockData, a_LightData, a_BiomeMap, nullptr);
 			break;
 		}
 		case CacheVersion::v573:
 		{
-			Serialize573<&Palette573>(a_ChunkX, a_ChunkZ, a_BlockData, a_LightData, a_BiomeMap);
+			Serialize573<&PaletteIdTable>(a_ChunkX, a_ChunkZ, a_BlockData, a_LightData, a_BiomeMap, BlockMap->GetIdTable(cProtocol::Version::v1_15));
 			break;
 		}
 		case CacheVersion::v735:
 		{
-			Serialize735<&Palette735>(a_ChunkX, a_ChunkZ, a_BlockData, a_LightData, a_BiomeMap);
+			Serialize735<&PaletteIdTable>(a_ChunkX, a_ChunkZ, a_BlockData, a_LightData, a_BiomeMap, BlockMap->GetIdTable(cProtocol::Version::v1_16));
 			break;
 		}
 		case CacheVersion::v751:
 		{
-			Serialize751<&Palette751>(a_ChunkX, a_ChunkZ, a_BlockData, a_LightData, a_BiomeMap);
+			Serialize751<&PaletteIdTable>(a_ChunkX, a_ChunkZ, a_BlockData, a_LightData, a_BiomeMap, BlockMap->GetIdTable(cProtocol::Version::v1_16_2));
 			break;
 		}
 		case CacheVersion::v755:
 		{
-			Serialize755<&Palette755>(a_ChunkX, a_ChunkZ, a_BlockData, a_LightData, a_BiomeMap);
+			Serialize755<&PaletteIdTable>(a_ChunkX, a_ChunkZ, a_BlockData, a_LightData, a_BiomeMap, BlockMap->GetIdTable(cProtocol::Version::v1_17));
 			break;
 		}
 		case CacheVersion::v757:
 		{
-			Serialize757<&Palette757>(a_ChunkX, a_ChunkZ, a_BlockData, a_LightData, a_BiomeMap, 0x22);
+			Serialize757<&PaletteIdTable>(a_ChunkX, a_ChunkZ, a_BlockData, a_LightData, a_BiomeMap, BlockMap->GetIdTable(cProtocol::Version::v1_18), 0x22);
 			break;
 		}
 		case CacheVersion::v759:
 		{
-			Serialize757<&Palette759>(a_ChunkX, a_ChunkZ, a_BlockData, a_LightData, a_BiomeMap, 0x1F);
+			Serialize757<&PaletteIdTable>(a_ChunkX, a_ChunkZ, a_BlockData, a_LightData, a_BiomeMap, BlockMap->GetIdTable(cProtocol::Version::v1_19), 0x1F);
 			break;
 		}
 		case CacheVersion::v760:
 		{
-			Serialize757<&Palette760>(a_ChunkX, a_ChunkZ, a_BlockData, a_LightData, a_BiomeMap, 0x21);
+			Serialize757<&PaletteIdTable>(a_ChunkX, a_ChunkZ, a_BlockData, a_LightData, a_BiomeMap, BlockMap->GetIdTable(cProtocol::Version::v1_19_1), 0x21);
 			break;
 		}
 		case CacheVersion::v761:
 		{
-			Serialize757<&Palette761>(a_ChunkX, a_ChunkZ, a_BlockData, a_LightData, a_BiomeMap, 0x20);
+			Serialize757<&PaletteIdTable>(a_ChunkX, a_ChunkZ, a_BlockData, a_LightData, a_BiomeMap, BlockMap->GetIdTable(cProtocol::Version::v1_19_3), 0x20);
 			break;
 		}
 		case CacheVersion::v762:
 		{
-			Serialize757<&Palette762>(a_ChunkX, a_ChunkZ, a_BlockData, a_LightData, a_BiomeMap, 0x24);
+			Serialize757<&PaletteIdTable>(a_ChunkX, a_ChunkZ, a_BlockData, a_LightData, a_BiomeMap, BlockMap->GetIdTable(cProtocol::Version::v1_19_4), 0x24);
 			break;
 		}
 		case CacheVersion::v763:
 		{
-			Serialize763<&Palette763>(a_ChunkX, a_ChunkZ, a_BlockData, a_LightData, a_BiomeMap, 0x24);
+			Serialize763<&PaletteIdTable>(a_ChunkX, a_ChunkZ, a_BlockData, a_LightData, a_BiomeMap, BlockMap->GetIdTable(cProtocol::Version::v1_20), 0x24);
 			break;
 		}
 		case CacheVersion::v764:
 		case CacheVersion::v765:
 		{
-			Serialize764<&Palette764>(a_ChunkX, a_ChunkZ, a_BlockData, a_LightData, a_BiomeMap, a_BlockEntities, a_Client, a_SurfaceHeightMap, 0x25);
+			Serialize764<&PaletteIdTable>(a_ChunkX, a_ChunkZ, a_BlockData, a_LightData, a_BiomeMap, BlockMap->GetIdTable(cProtocol::Version::v1_20_2), a_BlockEntities, a_Client, a_SurfaceHeightMap, 0x25);
 			break;
 		}
 		case CacheVersion::v766:
 		{
-			Serialize764<&Palette766>(a_ChunkX, a_ChunkZ, a_BlockData, a_LightData, a_BiomeMap, a_BlockEntities, a_Client, a_SurfaceHeightMap, 0x27);
+			Serialize764<&PaletteIdTable>(a_ChunkX, a_ChunkZ, a_BlockData, a_LightData, a_BiomeMap, BlockMap->GetIdTable(cProtocol::Version::v1_20_5), a_BlockEntities, a_Client, a_SurfaceHeightMap, 0x27);
 			break;
 		}
 		case CacheVersion::v767:
 		{
-			Serialize764<&Palette767>(a_ChunkX, a_ChunkZ, a_BlockData, a_LightData, a_BiomeMap, a_BlockEntities, a_Client, a_SurfaceHeightMap, 0x27);
+			Serialize764<&PaletteIdTable>(a_ChunkX, a_ChunkZ, a_BlockData, a_LightData, a_BiomeMap, BlockMap->GetIdTable(cProtocol::Version::v1_21), a_BlockEntities, a_Client, a_SurfaceHeightMap, 0x27);
 			break;
 		}
 		case CacheVersion::v768:
 		{
-			Serialize764<&Palette768>(a_ChunkX, a_ChunkZ, a_BlockData, a_LightData, a_BiomeMap, a_BlockEntities, a_Client, a_SurfaceHeightMap, 0x28);
+			Serialize764<&PaletteIdTable>(a_ChunkX, a_ChunkZ, a_BlockData, a_LightData, a_BiomeMap, BlockMap->GetIdTable(cProtocol::Version::v1_21_2), a_BlockEntities, a_Client, a_SurfaceHeightMap, 0x28);
 			break;
 		}
 		case CacheVersion::v769:
 		{
-			Serialize764<&Palette769>(a_ChunkX, a_ChunkZ, a_BlockData, a_LightData, a_BiomeMap, a_BlockEntities, a_Client, a_SurfaceHeightMap, 0x28);
+			Serialize764<&PaletteIdTable>(a_ChunkX, a_ChunkZ, a_BlockData, a_LightData, a_BiomeMap, BlockMap->GetIdTable(cProtocol::Version::v1_21_4), a_BlockEntities, a_Client, a_SurfaceHeightMap, 0x28);
 			break;
 		}
 		case CacheVersion::v770:
 		{
-			Serialize770<&Palette770>(a_ChunkX, a_ChunkZ, a_BlockData, a_LightData, a_BiomeMap, a_BlockEntities, a_Client, a_SurfaceHeightMap, 0x27);
+			Serialize770<&PaletteIdTable>(a_ChunkX, a_ChunkZ, a_BlockData, a_LightData, a_BiomeMap, BlockMap->GetIdTable(cProtocol::Version::v1_21_5), a_BlockEntities, a_Client, a_SurfaceHeightMap, 0x27);
 			break;
 		}
 		case CacheVersion::v771:
 		{
-			Serialize770<&Palette771>(a_ChunkX, a_ChunkZ, a_BlockData, a_LightData, a_BiomeMap, a_BlockEntities, a_Client, a_SurfaceHeightMap, 0x27);
+			Serialize770<&PaletteIdTable>(a_ChunkX, a_ChunkZ, a_BlockData, a_LightData, a_BiomeMap, BlockMap->GetIdTable(cProtocol::Version::v1_21_6), a_BlockEntities, a_Client, a_SurfaceHeightMap, 0x27);
 			break;
 		}
 	}
-	CompressPacketInto(Cache);
-	ASSERT(Cache.Engaged);  // Cache must be populated now
+	const auto & Cache = CompressPacketInto(Key, a_Revision);
 	a_Client->SendChunkData(a_ChunkX, a_ChunkZ, Cache.ToSend);
 }
 
@@ -623,7 +552,7 @@ inline void cChunkDataSerializer::Serialize107(const int a_ChunkX, const int a_C
 		m_Packet.WriteBEUInt8(BitsPerEntry);
 		m_Packet.WriteVarInt32(0);  // Palette length is 0
 		m_Packet.WriteVarInt32(static_cast<UInt32>(ChunkSectionDataArraySize));
-		WriteBlockSectionSeamless<&PaletteLegacy>(Blocks, BitsPerEntry);
+		WriteBlockSectionSeamless<&PaletteLegacy>(Blocks, nullptr, BitsPerEntry);
 		WriteLightSectionGrouped(BlockLights, SkyLights);
 	});
 
@@ -681,7 +610,7 @@ inline void cChunkDataSerializer::Serialize110(const int a_ChunkX, const int a_C
 		m_Packet.WriteBEUInt8(BitsPerEntry);
 		m_Packet.WriteVarInt32(0);  // Palette length is 0
 		m_Packet.WriteVarInt32(static_cast<UInt32>(ChunkSectionDataArraySize));
-		WriteBlockSectionSeamless<&PaletteLegacy>(Blocks, BitsPerEntry);
+		WriteBlockSectionSeamless<&PaletteLegacy>(Blocks, nullptr, BitsPerEntry);
 		WriteLightSectionGrouped(BlockLights, SkyLights);
 	});
 
@@ -697,7 +626,7 @@ inline void cChunkDataSerializer::Serialize110(const int a_ChunkX, const int a_C
 
 
 template <auto Palette>
-inline void cChunkDataSerializer::Serialize393(const int a_ChunkX, const int a_ChunkZ, const ChunkBlockData & a_BlockData, const ChunkLightData & a_LightData, const unsigned char * a_BiomeMap)
+inline void cChunkDataSerializer::Serialize393(const int a_ChunkX, const int a_ChunkZ, const ChunkBlockData & a_BlockData, const ChunkLightData & a_LightData, const unsigned char * a_BiomeMap, const IdTable * a_IdTable)
 {
 	// This function returns the fully compressed packet (including packet size), not the raw packet!
 	// Below variables tagged static because of https://developercommunity.visualstudio.com/content/problem/367326
@@ -741,7 +670,7 @@ inline void cChunkDataSerializer::Serialize393(const int a_ChunkX, const int a_C
 	{
 		m_Packet.WriteBEUInt8(BitsPerEntry);
 		m_Packet.WriteVarInt32(static_cast<UInt32>(ChunkSectionDataArraySize));
-		WriteBlockSectionSeamless<Palette>(Blocks, BitsPerEntry);
+		WriteBlockSectionSeamless<Palette>(Blocks, a_IdTable, BitsPerEntry);
 		WriteLightSectionGrouped(BlockLights, SkyLights);
 	});
 
@@ -760,7 +689,7 @@ inline void cChunkDataSerializer::Serialize393(const int a_ChunkX, const int a_C
 
 
 template <auto Palette>
-inline void cChunkDataSerializer::Serialize477(const int a_ChunkX, const int a_ChunkZ, const ChunkBlockData & a_BlockData, const ChunkLightData & a_LightData, const unsigned char * a_BiomeMap)
+inline void cChunkDataSerializer::Serialize477(const int a_ChunkX, const int a_ChunkZ, const ChunkBlockData & a_BlockData, const ChunkLightData & a_LightData, const unsigned char * a_BiomeMap, const IdTable * a_IdTable)
 {
 	// This function returns the fully compressed packet (including packet size), not the raw packet!
 	// Below variables tagged static because of https://developercommunity.visualstudio.com/content/problem/367326
@@ -808,7 +737,7 @@ inline void cChunkDataSerializer::Serialize477(const int a_ChunkX, const int a_C
 		m_Packet.WriteBEInt16(ChunkBlockData::SectionBlockCount);  // a temp fix to make sure sections don't disappear
 		m_Packet.WriteBEUInt8(BitsPerEntry);
 		m_Packet.WriteVarInt32(static_cast<UInt32>(ChunkSectionDataArraySize));
-		WriteBlockSectionSeamless<Palette>(Blocks, BitsPerEntry);
+		WriteBlockSectionSeamless<Palette>(Blocks, a_IdTable, BitsPerEntry);
 	});
 
 	// Write the biome data
@@ -826,7 +755,7 @@ inline void cChunkDataSerializer::Serialize477(const int a_ChunkX, const int a_C
 
 
 template <auto Palette>
-inline void cChunkDataSerializer::Serialize573(const int a_ChunkX, const int a_ChunkZ, const ChunkBlockData & a_BlockData, const ChunkLightData & a_LightData, const unsigned char * a_BiomeMap)
+inline void cChunkDataSerializer::Serialize573(const int a_ChunkX, const int a_ChunkZ, const ChunkBlockData & a_BlockData, const ChunkLightData & a_LightData, const unsigned char * a_BiomeMap, const IdTable * a_IdTable)
 {
 	// This function returns the fully compressed packet (including packet
 	// size), not the raw packet! Below variables tagged static because of
@@ -889,7 +818,7 @@ inline void cChunkDataSerializer::Serialize573(const int a_ChunkX, const int a_C
 			m_Packet.WriteBEInt16(4096);
 			m_Packet.WriteBEUInt8(BitsPerEntry);
 			m_Packet.WriteVarInt32(static_cast<UInt32>(ChunkSectionDataArraySize));
-			WriteBlockSectionSeamless2<Palette>(Blocks, BitsPerEntry, false);
+			WriteBlockSectionSeamless2<Palette>(Blocks, a_IdTable, BitsPerEntry, false);
 		}
 	}
 
@@ -902,7 +831,7 @@ inline void cChunkDataSerializer::Serialize573(const int a_ChunkX, const int a_C
 
 
 template <auto Palette>
-inline void cChunkDataSerializer::Serialize735(const int a_ChunkX, const int a_ChunkZ, const ChunkBlockData & a_BlockData2, const ChunkLightData & a_LightData, const unsigned char * a_BiomeMap)
+inline void cChunkDataSerializer::Serialize735(const int a_ChunkX, const int a_ChunkZ, const ChunkBlockData & a_BlockData2, const ChunkLightData & a_LightData, const unsigned char * a_BiomeMap, const IdTable * a_IdTable)
 {
 	// This function returns the fully compressed packet (including packet
 	// size), not the raw packet! Below variables tagged static because of
@@ -967,7 +896,7 @@ inline void cChunkDataSerializer::Serialize735(const int a_ChunkX, const int a_C
 			m_Packet.WriteBEInt16(4096);
 			m_Packet.WriteBEUInt8(BitsPerEntry);
 			m_Packet.WriteVarInt32(static_cast<UInt32>(ChunkSectionDataArraySize));
-			WriteBlockSectionSeamless2<Palette>(Blocks, BitsPerEntry, true);
+			WriteBlockSectionSeamless2<Palette>(Blocks, a_IdTable, BitsPerEntry, true);
 		}
 	}
 
@@ -980,7 +909,7 @@ inline void cChunkDataSerializer::Serialize735(const int a_ChunkX, const int a_C
 
 
 template <auto Palette>
-inline void cChunkDataSerializer::Serialize751(const int a_ChunkX, const int a_ChunkZ, const ChunkBlockData & a_BlockData2, const ChunkLightData & a_LightData, const unsigned char * a_BiomeMap)
+inline void cChunkDataSerializer::Serialize751(const int a_ChunkX, const int a_ChunkZ, const ChunkBlockData & a_BlockData2, const ChunkLightData & a_LightData, const unsigned char * a_BiomeMap, const IdTable * a_IdTable)
 {
 	// This function returns the fully compressed packet (including packet
 	// size), not the raw packet! Below variables tagged static because of
@@ -1046,7 +975,7 @@ inline void cChunkDataSerializer::Serialize751(const int a_ChunkX, const int a_C
 			m_Packet.WriteBEInt16(4096);
 			m_Packet.WriteBEUInt8(BitsPerEntry);
 			m_Packet.WriteVarInt32(static_cast<UInt32>(ChunkSectionDataArraySize));
-			WriteBlockSectionSeamless2<Palette>(Blocks, BitsPerEntry, true);
+			WriteBlockSectionSeamless2<Palette>(Blocks, a_IdTable, BitsPerEntry, true);
 		}
 	}
 
@@ -1059,7 +988,7 @@ inline void cChunkDataSerializer::Serialize751(const int a_ChunkX, const int a_C
 
 
 template <auto Palette>
-inline void cChunkDataSerializer::Serialize755(const int a_ChunkX, const int a_ChunkZ, const ChunkBlockData & a_BlockData2, const ChunkLightData & a_LightData, const unsigned char * a_BiomeMap)
+inline void cChunkDataSerializer::Serialize755(const int a_ChunkX, const int a_ChunkZ, const ChunkBlockData & a_BlockData2, const ChunkLightData & a_LightData, const unsigned char * a_BiomeMap, const IdTable * a_IdTable)
 {
 		// This function returns the fully compressed packet (including packet
 	// size), not the raw packet! Below variables tagged static because of
@@ -1125,7 +1054,7 @@ inline void cChunkDataSerializer::Serialize755(const int a_ChunkX, const int a_C
 			m_Packet.WriteBEInt16(4096);
 			m_Packet.WriteBEUInt8(BitsPerEntry);
 			m_Packet.WriteVarInt32(static_cast<UInt32>(ChunkSectionDataArraySize));
-			WriteBlockSectionSeamless2<Palette>(Blocks, BitsPerEntry, true);
+			WriteBlockSectionSeamless2<Palette>(Blocks, a_IdTable, BitsPerEntry, true);
 		}
 	}
 
@@ -1138,7 +1067,7 @@ inline void cChunkDataSerializer::Serialize755(const int a_ChunkX, const int a_C
 
 
 template <auto Palette>
-inline void cChunkDataSerializer::Serialize757(const int a_ChunkX, const int a_ChunkZ, const ChunkBlockData & a_BlockData2, const ChunkLightData & a_LightData, const unsigned char * a_BiomeMap, UInt32 a_packet_id)
+inline void cChunkDataSerializer::Serialize757(const int a_ChunkX, const int a_ChunkZ, const ChunkBlockData & a_BlockData2, const ChunkLightData & a_LightData, const unsigned char * a_BiomeMap, const IdTable * a_IdTable, UInt32 a_packet_id)
 {
 	// This function returns the fully compressed packet (including packet
 	// size), not the raw packet! Below variables tagged static because of
@@ -1185,7 +1114,7 @@ inline void cChunkDataSerializer::Serialize757(const int a_ChunkX, const int a_C
 		m_Packet.WriteBEInt16(4096);
 		m_Packet.WriteBEUInt8(BitsPerEntry);
 		m_Packet.WriteVarInt32(static_cast<UInt32>(ChunkSectionDataArraySize));
-		WriteBlockSectionSeamless2<Palette>(Blocks, BitsPerEntry, true);
+		WriteBlockSectionSeamless2<Palette>(Blocks, a_IdTable, BitsPerEntry, true);
 
 		// Biomes
 		m_Packet.WriteBEUInt8(0);
@@ -1214,7 +1143,7 @@ inline void cChunkDataSerializer::Serialize757(const int a_ChunkX, const int a_C
 
 
 template <auto Palette>
-inline void cChunkDataSerializer::Serialize763(const int a_ChunkX, const int a_ChunkZ, const ChunkBlockData & a_BlockData2, const ChunkLightData & a_LightData, const unsigned char * a_BiomeMap, UInt32 a_packet_id)
+inline void cChunkDataSerializer::Serialize763(const int a_ChunkX, const int a_ChunkZ, const ChunkBlockData & a_BlockData2, const ChunkLightData & a_LightData, const unsigned char * a_BiomeMap, const IdTable * a_IdTable, UInt32 a_packet_id)
 {
 	// This function returns the fully compressed packet (including packet
 	// size), not the raw packet! Below variables tagged static because of
@@ -1261,7 +1190,7 @@ inline void cChunkDataSerializer::Serialize763(const int a_ChunkX, const int a_C
 		m_Packet.WriteBEInt16(4096);
 		m_Packet.WriteBEUInt8(BitsPerEntry);
 		m_Packet.WriteVarInt32(static_cast<UInt32>(ChunkSectionDataArraySize));
-		WriteBlockSectionSeamless2<Palette>(Blocks, BitsPerEntry, true);
+		WriteBlockSectionSeamless2<Palette>(Blocks, a_IdTable, BitsPerEntry, true);
 
 		// Biomes
 		m_Packet.WriteBEUInt8(0);
@@ -1287,7 +1216,7 @@ inline void cChunkDataSerializer::Serialize763(const int a_ChunkX, const int a_C
 
 
 template <auto Palette>
-inline void cChunkDataSerializer::Serialize764(const int a_ChunkX, const int a_ChunkZ, const ChunkBlockData & a_BlockData, const ChunkLightData & a_LightData, const unsigned char * a_BiomeMap, const std::vector<cBlockEntity *> & a_BlockEntities, const ClientHandles::value_type & a_Client, const cChunkDef::HeightMap & a_SurfaceHeightMap, UInt32 a_packet_id)
+inline void cChunkDataSerializer::Serialize764(const int a_ChunkX, const int a_ChunkZ, const ChunkBlockData & a_BlockData, const ChunkLightData & a_LightData, const unsigned char * a_BiomeMap, const IdTable * a_IdTable, const std::vector<cBlockEntity *> & a_BlockEntities, const ClientHandles::value_type & a_Client, const cChunkDef::HeightMap & a_SurfaceHeightMap, UInt32 a_packet_id)
 {
 	// This function returns the fully compressed packet (including packet
 	// size), not the raw packet! Below variables tagged static because of
@@ -1338,7 +1267,7 @@ inline void cChunkDataSerializer::Serialize764(const int a_ChunkX, const int a_C
 		m_Packet.WriteBEInt16(4096);
 		m_Packet.WriteBEUInt8(BitsPerEntry);
 		m_Packet.WriteVarInt32(static_cast<UInt32>(ChunkSectionDataArraySize));
-		WriteBlockSectionSeamless2<Palette>(Blocks, BitsPerEntry, true);
+		WriteBlockSectionSeamless2<Palette>(Blocks, a_IdTable, BitsPerEntry, true);
 
 		// Biomes
 		m_Packet.WriteBEUInt8(0);
@@ -1362,53 +1291,7 @@ inline void cChunkDataSerializer::Serialize764(const int a_ChunkX, const int a_C
 	}
 
 	// Light Data
-	// Each bit corresponds to one chunk section that is lit
-	// Skylight
-	m_Packet.WriteVarInt32(1);
-	Int64 SkyLight = 0;
-	Int64 BlockLight = 0;
-	int light_count = 0, block_count = 0;
-	for (size_t Y = 0; Y < cChunkDef::NumSections; ++Y)
-	{
-		SkyLight |= (a_LightData.GetSkyLightSection(Y) != nullptr) << Y;
-		if (a_LightData.GetSkyLightSection(Y) != nullptr)
-		{
-			light_count++;
-		}
-		BlockLight |= (a_LightData.GetBlockLightSection(Y) != nullptr) << Y;
-		if (a_LightData.GetBlockLightSection(Y) != nullptr)
-		{
-			block_count++;
-		}
-	}
-	m_Packet.WriteBEInt64(SkyLight);
-	// BlockLight
-	m_Packet.WriteVarInt32(1);
-	m_Packet.WriteBEInt64(BlockLight);
-
-	m_Packet.WriteVarInt32(0);
-	m_Packet.WriteVarInt32(0);
-
-	m_Packet.WriteVarInt32(static_cast<UInt32>(light_count));
-	for (size_t Y = 0; Y < cChunkDef::NumSections; ++Y)
-	{
-		auto light = a_LightData.GetSkyLightSection(Y);
-		if (light != nullptr)
-		{
-			m_Packet.WriteVarInt32(2048);
-			m_Packet.Write(light, 2048);
-		}
-	}
-	m_Packet.WriteVarInt32(static_cast<UInt32>(block_count));
-	for (size_t Y = 0; Y < cChunkDef::NumSections; ++Y)
-	{
-		auto light = a_LightData.GetBlockLightSection(Y);
-		if (light != nullptr)
-		{
-			m_Packet.WriteVarInt32(2048);
-			m_Packet.Write(light, 2048);
-		}
-	}
+	WriteLightData(a_LightData);
 }
 
 
@@ -1416,7 +1299,7 @@ inline void cChunkDataSerializer::Serialize764(const int a_ChunkX, const int a_C
 
 
 template <auto Palette>
-inline void cChunkDataSerializer::Serialize770(const int a_ChunkX, const int a_ChunkZ, const ChunkBlockData & a_BlockData, const ChunkLightData & a_LightData, const unsigned char * a_BiomeMap, const std::vector<cBlockEntity *> & a_BlockEntities, const ClientHandles::value_type & a_Client, const cChunkDef::HeightMap & a_SurfaceHeightMap, UInt32 a_packet_id)
+inline void cChunkDataSerializer::Serialize770(const int a_ChunkX, const int a_ChunkZ, const ChunkBlockData & a_BlockData, const ChunkLightData & a_LightData, const unsigned char * a_BiomeMap, const IdTable * a_IdTable, const std::vector<cBlockEntity *> & a_BlockEntities, const ClientHandles::value_type & a_Client, const cChunkDef::HeightMap & a_SurfaceHeightMap, UInt32 a_packet_id)
 {
 	// This function returns the fully compressed packet (including packet
 	// size), not the raw packet! Below variables tagged static because of
@@ -1465,7 +1348,7 @@ inline void cChunkDataSerializer::Serialize770(const int a_ChunkX, const int a_C
 		const auto Blocks = a_BlockData.GetSection(Y);
 		m_Packet.WriteBEInt16(4096);
 		m_Packet.WriteBEUInt8(BitsPerEntry);
-		WriteBlockSectionSeamless2<Palette>(Blocks, BitsPerEntry, true);
+		WriteBlockSectionSeamless2<Palette>(Blocks, a_IdTable, BitsPerEntry, true);
 
 		// Biomes
 		m_Packet.WriteBEUInt8(0);
@@ -1488,53 +1371,7 @@ inline void cChunkDataSerializer::Serialize770(const int a_ChunkX, const int a_C
 	}
 
 	// Light Data
-	// Each bit corresponds to one chunk section that is lit
-	// Skylight
-	m_Packet.WriteVarInt32(1);
-	Int64 SkyLight = 0;
-	Int64 BlockLight = 0;
-	int light_count = 0, block_count = 0;
-	for (size_t Y = 0; Y < cChunkDef::NumSections; ++Y)
-	{
-		SkyLight |= (a_LightData.GetSkyLightSection(Y) != nullptr) << Y;
-		if (a_LightData.GetSkyLightSection(Y) != nullptr)
-		{
-			light_count++;
-		}
-		BlockLight |= (a_LightData.GetBlockLightSection(Y) != nullptr) << Y;
-		if (a_LightData.GetBlockLightSection(Y) != nullptr)
-		{
-			block_count++;
-		}
-	}
-	m_Packet.WriteBEInt64(SkyLight);
-	// BlockLight
-	m_Packet.WriteVarInt32(1);
-	m_Packet.WriteBEInt64(BlockLight);
-
-	m_Packet.WriteVarInt32(0);
-	m_Packet.WriteVarInt32(0);
-
-	m_Packet.WriteVarInt32(static_cast<UInt32>(light_count));
-	for (size_t Y = 0; Y < cChunkDef::NumSections; ++Y)
-	{
-		auto light = a_LightData.GetSkyLightSection(Y);
-		if (light != nullptr)
-		{
-			m_Packet.WriteVarInt32(2048);
-			m_Packet.Write(light, 2048);
-		}
-	}
-	m_Packet.WriteVarInt32(static_cast<UInt32>(block_count));
-	for (size_t Y = 0; Y < cChunkDef::NumSections; ++Y)
-	{
-		auto light = a_LightData.GetBlockLightSection(Y);
-		if (light != nullptr)
-		{
-			m_Packet.WriteVarInt32(2048);
-			m_Packet.Write(light, 2048);
-		}
-	}
+	WriteLightData(a_LightData);
 }
 
 
@@ -1542,7 +1379,7 @@ inline void cChunkDataSerializer::Serialize770(const int a_ChunkX, const int a_C
 
 
 template <auto Palette>
-inline void cChunkDataSerializer::WriteBlockSectionSeamless2(const ChunkBlockData::BlockArray * a_Blocks, const UInt8 a_BitsPerEntry, bool padding)
+inline void cChunkDataSerializer::WriteBlockSectionSeamless2(const ChunkBlockData::BlockArray * a_Blocks, const IdTable * a_IdTable, const UInt8 a_BitsPerEntry, bool padding)
 {
 	// https://wiki.vg/Chunk_Format#Data_structure
 
@@ -1554,7 +1391,7 @@ inline void cChunkDataSerializer::WriteBlockSectionSeamless2(const ChunkBlockDat
 
 	for (size_t Index = 0; Index != ChunkBlockData::SectionBlockCount; Index++)
 	{
-		const auto Value = a_Blocks == nullptr ? 0 : Palette((*a_Blocks)[Index]);
+		const auto Value = a_Blocks == nullptr ? 0 : Palette(a_IdTable, (*a_Blocks)[Index]);
 
 		// The _signed_ count of bits in Value left to write
 		const auto Remaining = static_cast<char>(a_BitsPerEntry - (64 - BitIndex));
@@ -1690,7 +1527,7 @@ inline void cChunkDataSerializer::WriteHeightMap(UInt64 * a_Array, const cChunkD
 
 
 template <auto Palette>
-inline void cChunkDataSerializer::WriteBlockSectionSeamless(const ChunkBlockData::BlockArray * a_Blocks, const UInt8 a_BitsPerEntry)
+inline void cChunkDataSerializer::WriteBlockSectionSeamless(const ChunkBlockData::BlockArray * a_Blocks, const IdTable * a_IdTable, const UInt8 a_BitsPerEntry)
 {
 	// https://wiki.vg/Chunk_Format#Data_structure
 
@@ -1706,7 +1543,7 @@ inline void cChunkDataSerializer::WriteBlockSectionSeamless(const ChunkBlockData
 	{
 		auto Block = BlocksExist ? (*a_Blocks)[Index] : 0;
 
-		const auto Value = Palette(Block);
+		const auto Value = Palette(a_IdTable, Block);
 
 		// Write as much as possible of Value, starting from BitIndex, into Buffer:
 		Buffer |= static_cast<UInt64>(Value) << BitIndex;
@@ -1738,6 +1575,80 @@ inline void cChunkDataSerializer::WriteBlockSectionSeamless(const ChunkBlockData
 
 
 
+inline void cChunkDataSerializer::WriteLightData(const ChunkLightData & a_LightData)
+{
+	// Each mask bit corresponds to one chunk section.
+	// Sections lit with light level 0 throughout are only flagged in the empty masks, without their data:
+	UInt64 SkyLightMask = 0, BlockLightMask = 0;
+	UInt64 EmptySkyLightMask = 0, EmptyBlockLightMask = 0;
+	UInt32 NumSkyLights = 0, NumBlockLights = 0;
+	for (size_t Y = 0; Y < cChunkDef::NumSections; ++Y)
+	{
+		if (a_LightData.GetSkyLightSection(Y) != nullptr)
+		{
+			if (a_LightData.GetUniformSkyLight(Y) == 0)
+			{
+				EmptySkyLightMask |= UInt64(1) << Y;
+			}
+			else
+			{
+				SkyLightMask |= UInt64(1) << Y;
+				NumSkyLights++;
+			}
+		}
+		if (a_LightData.GetBlockLightSection(Y) != nullptr)
+		{
+			if (a_LightData.GetUniformBlockLight(Y) == 0)
+			{
+				EmptyBlockLightMask |= UInt64(1) << Y;
+			}
+			else
+			{
+				BlockLightMask |= UInt64(1) << Y;
+				NumBlockLights++;
+			}
+		}
+	}
+
+	// The masks are BitSets, a long array prefixed by its length; the empty ones are left out entirely when zero:
+	m_Packet.WriteVarInt32(1);
+	m_Packet.WriteBEUInt64(SkyLightMask);
+	m_Packet.WriteVarInt32(1);
+	m_Packet.WriteBEUInt64(BlockLightMask);
+	for (const auto Mask : { EmptySkyLightMask, EmptyBlockLightMask })
+	{
+		m_Packet.WriteVarInt32((Mask == 0) ? 0 : 1);
+		if (Mask != 0)
+		{
+			m_Packet.WriteBEUInt64(Mask);
+		}
+	}
+
+	// Uniformly full sections share a single section in memory, but the protocol has no mask for those, so they're sent whole:
+	m_Packet.WriteVarInt32(NumSkyLights);
+	for (size_t Y = 0; Y < cChunkDef::NumSections; ++Y)
+	{
+		if ((SkyLightMask & (UInt64(1) << Y)) != 0)
+		{
+			m_Packet.WriteVarInt32(static_cast<UInt32>(ChunkLightData::SectionLightCount));
+			m_Packet.Write(a_LightData.GetSkyLightSection(Y)->data(), ChunkLightData::SectionLightCount);
+		}
+	}
+	m_Packet.WriteVarInt32(NumBlockLights);
+	for (size_t Y = 0; Y < cChunkDef::NumSections; ++Y)
+	{
+		if ((BlockLightMask & (UInt64(1) << Y)) != 0)
+		{
+			m_Packet.WriteVarInt32(static_cast<UInt32>(ChunkLightData::SectionLightCount));
+			m_Packet.Write(a_LightData.GetBlockLightSection(Y)->data(), ChunkLightData::SectionLightCount);
+		}
+	}
+}
+
+
+
+
+
 inline void cChunkDataSerializer::WriteLightSectionGrouped(const ChunkLightData::LightArray * const a_BlockLights, const ChunkLightData::LightArray * const a_SkyLights)
 {
 	// Write lighting:
@@ -1768,10 +1679,22 @@ inline void cChunkDataSerializer::WriteLightSectionGrouped(const ChunkLightData:
 
 
 
-inline void cChunkDataSerializer::CompressPacketInto(ChunkDataCache & a_Cache)
+inline const cChunkDataSerializer::ChunkDataCache & cChunkDataSerializer::CompressPacketInto(const CacheKey & a_Key, const UInt64 a_Revision)
 {
+	m_Cache.push_front({ a_Key, a_Revision, {} });
+	m_CacheIndex[a_Key] = m_Cache.begin();
+
+	auto & Cache = m_Cache.front();
 	m_Compressor.ReadFrom(m_Packet);
 	m_Packet.CommitRead();
-	cProtocol_1_8_0::CompressPacket(m_Compressor, a_Cache.ToSend);
-	a_Cache.Engaged = true;
+	cProtocol_1_8_0::CompressPacket(m_Compressor, Cache.ToSend);
+
+	// Drop the least recently used packets over the limit:
+	while (m_Cache.size() > MaxCachedPackets)
+	{
+		m_CacheIndex.erase(m_Cache.back().Key);
+		m_Cache.pop_back();
+	}
+
+	return Cache;
 }
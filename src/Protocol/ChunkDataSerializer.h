@@ -4,6 +4,7 @@
 #include "../ChunkData.h"
 #include "../Defines.h"
 #include "CircularBufferCompressor.h"
+#include "Palettes/IdTable.h"
 #include "StringCompression.h"
 
 
@@ -17,12 +18,15 @@ class cByteBuffer;
 
 
 /** Serializes one chunk's data to (possibly multiple) protocol versions.
-Caches the serialized data for as long as this object lives, so that the same data can be sent to
-other clients using the same protocol. */
+Caches the finished (compressed) packets in a bounded LRU, keyed by chunk coords and protocol version and
+validated against the chunk's modification revision, so that the same data can be sent to other clients
+using the same protocol without being re-serialized, for as long as the chunk doesn't change. */
 class cChunkDataSerializer
 {
 	using ClientHandles = std::vector<std::shared_ptr<cClientHandle>>;
 
+	using IdTable = BlockMap::IdTable;
+
 	/** Enum to collapse protocol versions into a contiguous index. */
 	enum class CacheVersion
 	{
@@ -54,65 +58,97 @@ class cChunkDataSerializer
 		Last = CacheVersion::v772
 	};
 
-	/** A single cache entry containing the raw data, compressed data, and a validity flag. */
+	/** Identifies a single serialized chunk packet in the cache. */
+	struct CacheKey
+	{
+		cChunkCoords Coords;
+		CacheVersion Version;
+
+		bool operator == (const CacheKey & a_Other) const
+		{
+			return (Coords == a_Other.Coords) && (Version == a_Other.Version);
+		}
+	};
+
+	struct CacheKeyHash
+	{
+		size_t operator () (const CacheKey & a_Key) const
+		{
+			return cChunkCoordsHash()(a_Key.Coords) ^ (static_cast<size_t>(a_Key.Version) << 24);
+		}
+	};
+
+	/** A single cache entry containing the compressed packet and the chunk revision it was serialized from. */
 	struct ChunkDataCache
 	{
+		CacheKey Key;
+		UInt64 Revision;
 		ContiguousByteBuffer ToSend;
-		bool Engaged = false;
 	};
 
+	using CacheList = std::list<ChunkDataCache>;
+
+	/** The maximum number of finished packets kept in the cache, across all chunks and protocol versions. */
+	static constexpr size_t MaxCachedPackets = 1024;
+
 public:
 
 	cChunkDataSerializer(eDimension a_Dimension);
 
 	/** For each client, serializes the chunk into their protocol version and sends it.
-	Parameters are the coordinates of the chunk to serialise, and the data and biome data read from the chunk. */
-	void SendToClients(int a_ChunkX, int a_ChunkZ, const ChunkBlockData & a_BlockData, const ChunkLightData & a_LightData, const unsigned char * a_BiomeMap, const std::vector<cBlockEntity *> & a_BlockEntities, const cChunkDef::HeightMap & a_SurfaceHeightMap, const ClientHandles & a_SendTo);
+	Parameters are the coordinates of the chunk to serialise, its modification revision, and the data and biome data read from the chunk.
+	Packets already cached for the same coords and revision are re-sent without serializing again. */
+	void SendToClients(int a_ChunkX, int a_ChunkZ, UInt64 a_Revision, const ChunkBlockData & a_BlockData, const ChunkLightData & a_LightData, const unsigned char * a_BiomeMap, const std::vector<cBlockEntity *> & a_BlockEntities, const cChunkDef::HeightMap & a_SurfaceHeightMap, const ClientHandles & a_SendTo);
 
 private:
 
-	/** Serialises the given chunk, storing the result into the given cache entry, and sends the data.
-	If the cache entry is already present, simply re-uses it. */
-	inline void Serialize(const ClientHandles::value_type & a_Client, int a_ChunkX, int a_ChunkZ, const ChunkBlockData & a_BlockData, const ChunkLightData & a_LightData, const unsigned char * a_BiomeMap, const std::vector<cBlockEntity *> & a_BlockEntities, const cChunkDef::HeightMap & a_SurfaceHeightMap, CacheVersion a_CacheVersion);
+	/** Serialises the given chunk, storing the result into the cache, and sends the data.
+	If a cache entry with the same revision is already present, simply re-uses it. */
+	inline void Serialize(const ClientHandles::value_type & a_Client, int a_ChunkX, int a_ChunkZ, UInt64 a_Revision, const ChunkBlockData & a_BlockData, const ChunkLightData & a_LightData, const unsigned char * a_BiomeMap, const std::vector<cBlockEntity *> & a_BlockEntities, const cChunkDef::HeightMap & a_SurfaceHeightMap, CacheVersion a_CacheVersion);
 
 	inline void Serialize47 (int a_ChunkX, int a_ChunkZ, const ChunkBlockData & a_BlockData, const ChunkLightData & a_LightData, const unsigned char * a_BiomeMap);  // Release 1.8
 	inline void Serialize107(int a_ChunkX, int a_ChunkZ, const ChunkBlockData & a_BlockData, const ChunkLightData & a_LightData, const unsigned char * a_BiomeMap);  // Release 1.9
 	inline void Serialize110(int a_ChunkX, int a_ChunkZ, const ChunkBlockData & a_BlockData, const ChunkLightData & a_LightData, const unsigned char * a_BiomeMap);  // Release 1.9.4
 	template <auto Palette>
-	inline void Serialize393(int a_ChunkX, int a_ChunkZ, const ChunkBlockData & a_BlockData, const ChunkLightData & a_LightData, const unsigned char * a_BiomeMap);  // Release 1.13 - 1.13.2
+	inline void Serialize393(int a_ChunkX, int a_ChunkZ, const ChunkBlockData & a_BlockData, const ChunkLightData & a_LightData, const unsigned char * a_BiomeMap, const IdTable * a_IdTable);  // Release 1.13 - 1.13.2
 	template <auto Palette>
-	inline void Serialize477(int a_ChunkX, int a_ChunkZ, const ChunkBlockData & a_BlockData, const ChunkLightData & a_LightData, const unsigned char * a_BiomeMap);	 // Release 1.14 - 1.14.4
+	inline void Serialize477(int a_ChunkX, int a_ChunkZ, const ChunkBlockData & a_BlockData, const ChunkLightData & a_LightData, const unsigned char * a_BiomeMap, const IdTable * a_IdTable);	 // Release 1.14 - 1.14.4
 	template <auto Palette>
-	inline void Serialize573(int a_ChunkX, int a_ChunkZ, const ChunkBlockData & a_BlockData, const ChunkLightData & a_LightData, const unsigned char * a_BiomeMap);
+	inline void Serialize573(int a_ChunkX, int a_ChunkZ, const ChunkBlockData & a_BlockData, const ChunkLightData & a_LightData, const unsigned char * a_BiomeMap, const IdTable * a_IdTable);
 	template <auto Palette>
-	inline void Serialize735(int a_ChunkX, int a_ChunkZ, const ChunkBlockData & a_BlockData, const ChunkLightData & a_LightData, const unsigned char * a_BiomeMap);
+	inline void Serialize735(int a_ChunkX, int a_ChunkZ, const ChunkBlockData & a_BlockData, const ChunkLightData & a_LightData, const unsigned char * a_BiomeMap, const IdTable * a_IdTable);
 	template <auto Palette>
-	inline void Serialize751(int a_ChunkX, int a_ChunkZ, const ChunkBlockData & a_BlockData, const ChunkLightData & a_LightData, const unsigned char * a_BiomeMap);
+	inline void Serialize751(int a_ChunkX, int a_ChunkZ, const ChunkBlockData & a_BlockData, const ChunkLightData & a_LightData, const unsigned char * a_BiomeMap, const IdTable * a_IdTable);
 	template <auto Palette>
-	inline void Serialize755(int a_ChunkX, int a_ChunkZ, const ChunkBlockData & a_BlockData, const ChunkLightData & a_LightData, const unsigned char * a_BiomeMap);
+	inline void Serialize755(int a_ChunkX, int a_ChunkZ, const ChunkBlockData & a_BlockData, const ChunkLightData & a_LightData, const unsigned char * a_BiomeMap, const IdTable * a_IdTable);
 	template <auto Palette>
-	inline void Serialize757(int a_ChunkX, int a_ChunkZ, const ChunkBlockData & a_BlockData, const ChunkLightData & a_LightData, const unsigned char * a_BiomeMap, UInt32 a_packet_id);
+	inline void Serialize757(int a_ChunkX, int a_ChunkZ, const ChunkBlockData & a_BlockData, const ChunkLightData & a_LightData, const unsigned char * a_BiomeMap, const IdTable * a_IdTable, UInt32 a_packet_id);
 	template <auto Palette>
-	inline void Serialize763(int a_ChunkX, int a_ChunkZ, const ChunkBlockData & a_BlockData, const ChunkLightData & a_LightData, const unsigned char * a_BiomeMap, UInt32 a_packet_id);
+	inline void Serialize763(int a_ChunkX, int a_ChunkZ, const ChunkBlockData & a_BlockData, const ChunkLightData & a_LightData, const unsigned char * a_BiomeMap, const IdTable * a_IdTable, UInt32 a_packet_id);
 	template <auto Palette>
-	inline void Serialize764(int a_ChunkX, int a_ChunkZ, const ChunkBlockData & a_BlockData, const ChunkLightData & a_LightData, const unsigned char * a_BiomeMap, const std::vector<cBlockEntity *> & a_BlockEntities, const ClientHandles::value_type & a_Client, const cChunkDef::HeightMap & a_SurfaceHeightMap, UInt32 a_packet_id);
+	inline void Serialize764(int a_ChunkX, int a_ChunkZ, const ChunkBlockData & a_BlockData, const ChunkLightData & a_LightData, const unsigned char * a_BiomeMap, const IdTable * a_IdTable, const std::vector<cBlockEntity *> & a_BlockEntities, const ClientHandles::value_type & a_Client, const cChunkDef::HeightMap & a_SurfaceHeightMap, UInt32 a_packet_id);
 	template <auto Palette>
-	inline void Serialize770(int a_ChunkX, int a_ChunkZ, const ChunkBlockData & a_BlockData, const ChunkLightData & a_LightData, const unsigned char * a_BiomeMap, const std::vector<cBlockEntity *> & a_BlockEntities, const ClientHandles::value_type & a_Client, const cChunkDef::HeightMap & a_SurfaceHeightMap, UInt32 a_packet_id);
+	inline void Serialize770(int a_ChunkX, int a_ChunkZ, const ChunkBlockData & a_BlockData, const ChunkLightData & a_LightData, const unsigned char * a_BiomeMap, const IdTable * a_IdTable, const std::vector<cBlockEntity *> & a_BlockEntities, const ClientHandles::value_type & a_Client, const cChunkDef::HeightMap & a_SurfaceHeightMap, UInt32 a_packet_id);
 
 	template <auto Palette>
-	inline void WriteBlockSectionSeamless2(const ChunkBlockData::BlockArray * a_Blocks, const UInt8 a_BitsPerEntry, bool padding);
+	inline void WriteBlockSectionSeamless2(const ChunkBlockData::BlockArray * a_Blocks, const IdTable * a_IdTable, const UInt8 a_BitsPerEntry, bool padding);
 	/** Writes all blocks in a chunk section into a series of Int64.
 	Writes start from the bit directly subsequent to the previous write's end, possibly crossing over to the next Int64. */
 	template <auto Palette>
-	inline void WriteBlockSectionSeamless(const ChunkBlockData::BlockArray * a_Blocks, UInt8 a_BitsPerEntry);
+	inline void WriteBlockSectionSeamless(const ChunkBlockData::BlockArray * a_Blocks, const IdTable * a_IdTable, UInt8 a_BitsPerEntry);
 
 	inline void WriteHeightMap(UInt64 * a_Array, const cChunkDef::HeightMap & a_HeightMap, const UInt8 a_BitsPerEntry, bool padding);
 
+	/** Writes the light masks and light arrays of the whole chunk, as used by the 1.20.2+ chunk data packets.
+	Sections that are dark throughout are sent as bits in the empty light masks rather than as full arrays. */
+	inline void WriteLightData(const ChunkLightData & a_LightData);
+
 	/** Copies all lights in a chunk section into the packet, block light followed immediately by sky light. */
 	inline void WriteLightSectionGrouped(const ChunkLightData::LightArray * a_BlockLights, const ChunkLightData::LightArray * a_SkyLights);
 
-	/** Finalises the data, compresses it if required, and stores it into cache. */
-	inline void CompressPacketInto(ChunkDataCache & a_Cache);
+	/** Finalises the data, compresses it if required, and stores it into the cache as the most recently used entry.
+	Evicts the least recently used entries over MaxCachedPackets. Returns the new cache entry. */
+	inline const ChunkDataCache & CompressPacketInto(const CacheKey & a_Key, UInt64 a_Revision);
 
 	/** A staging area used to construct the chunk packet, persistent to avoid reallocating. */
 	cByteBuffer m_Packet;
@@ -123,7 +159,9 @@ private:
 	/** The dimension for the World this Serializer is tied to. */
 	const eDimension m_Dimension;
 
-	/** A cache, mapping protocol version to a fully serialised chunk.
-	It is used during a single invocation of SendToClients with more than one client. */
-	std::array<ChunkDataCache, static_cast<size_t>(CacheVersion::Last) + 1> m_Cache;
+	/** The cached fully serialised chunks, most recently used first. */
+	CacheList m_Cache;
+
+	/** Maps chunk coords and protocol version into their entry in m_Cache. */
+	std::unordered_map<CacheKey, CacheList::iterator, CacheKeyHash> m_CacheIndex;
 } ;
@@ -2,8 +2,72 @@
 #include <Bindings/BlockTypePalette.h>
 #include "BlockMap.h"
 #include "Protocol/ProtocolRecognizer.h"
+#include "OSSupport/File.h"
 #include "filesystem"
 
+
+
+
+
+namespace
+{
+	/** Header of the binary ID table cache, followed by Count UInt32 protocol block IDs.
+	The cache is specific to the machine that wrote it, so the values are in the native byte order;
+	a cache from a machine with a different byte order fails the magic check and gets regenerated. */
+	struct sIdTableCacheHeader
+	{
+		static constexpr UInt32 MagicValue = 0x4d504243;  // "CBPM"
+		static constexpr UInt32 FormatVersionValue = 1;
+
+		UInt32 Magic;
+		UInt32 FormatVersion;
+
+		/** Size and modification time of the blocks.json the table was created from. */
+		UInt64 SourceSize;
+		UInt64 SourceTime;
+
+		/** Size and modification time of the latest version's blocks.json, the table is indexed by its IDs. */
+		UInt64 LatestSize;
+		UInt64 LatestTime;
+
+		UInt32 Count;
+		UInt32 Padding;
+	};
+
+
+
+
+
+	AString GetVersionFolder(cProtocol::Version a_Version)
+	{
+		return "Protocol/" + cMultiVersionProtocol::GetVersionTextFromInt(a_Version) + "/";
+	}
+
+
+
+
+
+	/** Fills in the source file stamps of the cache header for the specified version. */
+	sIdTableCacheHeader MakeCacheHeader(cProtocol::Version a_Version)
+	{
+		const auto SourceFileName = GetVersionFolder(a_Version) + "blocks.json";
+		const auto LatestFileName = GetVersionFolder(cProtocol::Version::Latest) + "blocks.json";
+
+		sIdTableCacheHeader Header{};
+		Header.Magic = sIdTableCacheHeader::MagicValue;
+		Header.FormatVersion = sIdTableCacheHeader::FormatVersionValue;
+		Header.SourceSize = static_cast<UInt64>(cFile::GetSize(SourceFileName));
+		Header.SourceTime = cFile::GetLastModificationTime(SourceFileName);
+		Header.LatestSize = static_cast<UInt64>(cFile::GetSize(LatestFileName));
+		Header.LatestTime = cFile::GetLastModificationTime(LatestFileName);
+		return Header;
+	}
+}  // namespace (anonymous)
+
+
+
+
+
 namespace BlockMap
 {
 	void cBlockMap::AddVersion(cProtocol::Version a_Version)
@@ -12,57 +76,71 @@ namespace BlockMap
 		{
 			return;
 		}
-		if (m_PerVersionMap.count(a_Version) != 0)
-		{
-			LOGWARNING(fmt::format(FMT_STRING("Tried to add version {} twice, ignoring"), cMultiVersionProtocol::GetVersionTextFromInt(a_Version)));
-			return;
-		}
-		AString file_name = "Protocol/" + cMultiVersionProtocol::GetVersionTextFromInt(a_Version) + "/blocks.json";
-		std::fstream file;
-		file.open(file_name, std::ios::in);
-		if (!file.is_open())
+
+		if (a_Version != cProtocol::Version::Latest)
 		{
-			LOGERROR(fmt::format(FMT_STRING("Failed to open block.json file for version {}. Check if it exists at Protocol\\{}\\blocks.json. THIS VERSION WILL NOT WORK"), cMultiVersionProtocol::GetVersionTextFromInt(a_Version), cMultiVersionProtocol::GetVersionTextFromInt(a_Version)));
+			GetIdTable(a_Version);
 			return;
 		}
-		if (file.fail())
+
+		cCSLock Lock(m_CS);
+		if (m_PerVersionMap.count(a_Version) != 0)
 		{
-			LOGERROR(fmt::format(FMT_STRING("Failed to read block.json file for version {}. THIS VERSION WILL NOT WORK"), cMultiVersionProtocol::GetVersionTextFromInt(a_Version)));
+			LOGWARNING(fmt::format(FMT_STRING("Tried to add version {} twice, ignoring"), cMultiVersionProtocol::GetVersionTextFromInt(a_Version)));
 			return;
 		}
-		LOG(fmt::format(FMT_STRING("Loading block palette for version {}"), cMultiVersionProtocol::GetVersionTextFromInt(a_Version)));
-		const auto sz = std::filesystem::file_size(file_name);
-		std::string result(sz, '\0');
-		file.read(result.data(), static_cast<std::streamsize>(sz));
-		m_PerVersionMap[a_Version] = BlockTypePalette();
-		m_PerVersionMap.at(a_Version).loadFromString(result);
+		LoadPaletteFromFile(a_Version, m_PerVersionMap[a_Version]);
 	}
 
 
 
 
 
-	UInt32 cBlockMap::GetProtocolBlockId(cProtocol::Version a_target, BlockState a_block)
+	const cBlockMap::IdTable * cBlockMap::GetIdTable(cProtocol::Version a_Version)
 	{
-		const BlockTypePalette & latest = m_PerVersionMap[cProtocol::Version::Latest];
-		BlockTypePalette & target_ver = m_PerVersionMap[a_target];
+		// The BlockStates are the latest version's IDs:
+		if (a_Version == cProtocol::Version::Latest)
+		{
+			return nullptr;
+		}
+
+		// Once loaded, the table is found without locking:
+		const auto Slot = static_cast<size_t>(a_Version) - static_cast<size_t>(cProtocol::Version::v1_13);
+		const bool HasSlot = (a_Version >= cProtocol::Version::v1_13) && (Slot < m_LoadedIds.size());
+		if (HasSlot)
+		{
+			if (const auto Table = m_LoadedIds[Slot].load(std::memory_order_acquire); Table != nullptr)
+			{
+				return Table;
+			}
+		}
 
-		const auto & entry = latest.entry(a_block.ID);
-		const auto ret = target_ver.maybeIndex(entry.first, entry.second);
-		if (ret.second)
+		cCSLock Lock(m_CS);
+		const auto Table = LoadIdTable(a_Version);
+		if (HasSlot)
 		{
-			return ret.first;
+			m_LoadedIds[Slot].store(Table, std::memory_order_release);
 		}
-		return 0;
+		return Table;
 	}
 
 
 
 
 
-	const BlockTypePalette & cBlockMap::GetPalette(cProtocol::Version a_target) const
+	const BlockTypePalette & cBlockMap::GetPalette(cProtocol::Version a_target)
 	{
-		return m_PerVersionMap.at(a_target);
+		cCSLock Lock(m_CS);
+		auto itr = m_PerVersionMap.find(a_target);
+		if (itr != m_PerVersionMap.end())
+		{
+			return itr->second;
+		}
+
+		// Not loaded yet, parse the full palette now (an empty one is kept if it fails, so that the error is reported only once):
+		auto & Palette = m_PerVersionMap[a_target];
+		LoadPaletteFromFile(a_target, Palette);
+		return Palette;
 	}
 
 
@@ -90,8 +168,142 @@ namespace BlockMap
 					continue;
 				}
 
-				AddVersion(e_version);
+				cCSLock Lock(m_CS);
+				m_AvailableVersions.insert(e_version);
 			}
 		}
+
+		// The latest palette is needed right away by the world storage, the rest is loaded on first use by a client:
+		AddVersion(cProtocol::Version::Latest);
+	}
+
+
+
+
+
+	const cBlockMap::IdTable * cBlockMap::LoadIdTable(cProtocol::Version a_Version)
+	{
+		auto itr = m_PerVersionIds.find(a_Version);
+		if (itr != m_PerVersionIds.end())
+		{
+			return itr->second.get();
+		}
+
+		if (!m_AvailableVersions.empty() && (m_AvailableVersions.count(a_Version) == 0))
+		{
+			LOGERROR(fmt::format(FMT_STRING("Block palette for version {} is not available in the Protocol folder. THIS VERSION WILL NOT WORK"), cMultiVersionProtocol::GetVersionTextFromInt(a_Version)));
+		}
+
+		// Try the binary cache first:
+		auto Table = LoadIdTableCache(a_Version);
+		if (Table == nullptr)
+		{
+			// Parse the json and translate against the latest palette, then throw the parsed palette away:
+			Table = std::make_unique<IdTable>();
+			BlockTypePalette Palette;
+			if (LoadPaletteFromFile(a_Version, Palette))
+			{
+				auto Latest = m_PerVersionMap.find(cProtocol::Version::Latest);
+				if (Latest == m_PerVersionMap.end())
+				{
+					Latest = m_PerVersionMap.emplace(cProtocol::Version::Latest, BlockTypePalette()).first;
+					LoadPaletteFromFile(cProtocol::Version::Latest, Latest->second);
+				}
+				*Table = Palette.createTransformTableWithFallback(Latest->second, 0);
+				SaveIdTableCache(a_Version, *Table);
+			}
+		}
+
+		// Store even an empty table on failure, so that the error is reported only once:
+		return m_PerVersionIds.emplace(a_Version, std::move(Table)).first->second.get();
+	}
+
+
+
+
+
+	bool cBlockMap::LoadPaletteFromFile(cProtocol::Version a_Version, BlockTypePalette & a_Palette)
+	{
+		AString file_name = GetVersionFolder(a_Version) + "blocks.json";
+		std::fstream file;
+		file.open(file_name, std::ios::in);
+		if (!file.is_open())
+		{
+			LOGERROR(fmt::format(FMT_STRING("Failed to open block.json file for version {}. Check if it exists at Protocol\\{}\\blocks.json. THIS VERSION WILL NOT WORK"), cMultiVersionProtocol::GetVersionTextFromInt(a_Version), cMultiVersionProtocol::GetVersionTextFromInt(a_Version)));
+			return false;
+		}
+		if (file.fail())
+		{
+			LOGERROR(fmt::format(FMT_STRING("Failed to read block.json file for version {}. THIS VERSION WILL NOT WORK"), cMultiVersionProtocol::GetVersionTextFromInt(a_Version)));
+			return false;
+		}
+		LOG(fmt::format(FMT_STRING("Loading block palette for version {}"), cMultiVersionProtocol::GetVersionTextFromInt(a_Version)));
+		const auto sz = std::filesystem::file_size(file_name);
+		std::string result(sz, '\0');
+		file.read(result.data(), static_cast<std::streamsize>(sz));
+		try
+		{
+			a_Palette.loadFromString(result);
+		}
+		catch (const std::exception & exc)
+		{
+			LOGERROR(fmt::format(FMT_STRING("Failed to parse block.json file for version {}: {}. THIS VERSION WILL NOT WORK"), cMultiVersionProtocol::GetVersionTextFromInt(a_Version), exc.what()));
+			return false;
+		}
+		return true;
+	}
+
+
+
+
+
+	std::unique_ptr<cBlockMap::IdTable> cBlockMap::LoadIdTableCache(cProtocol::Version a_Version)
+	{
+		const auto Data = cFile::ReadWholeFile(GetVersionFolder(a_Version) + "blocks.bin");
+		if (Data.size() < sizeof(sIdTableCacheHeader))
+		{
+			return nullptr;
+		}
+
+		sIdTableCacheHeader Header;
+		memcpy(&Header, Data.data(), sizeof(Header));
+		const auto Expected = MakeCacheHeader(a_Version);
+		if (
+			(Header.Magic != Expected.Magic) ||
+			(Header.FormatVersion != Expected.FormatVersion) ||
+			(Header.SourceSize != Expected.SourceSize) ||
+			(Header.SourceTime != Expected.SourceTime) ||
+			(Header.LatestSize != Expected.LatestSize) ||
+			(Header.LatestTime != Expected.LatestTime) ||
+			(Data.size() != sizeof(Header) + Header.Count * sizeof(UInt32))
+		)
+		{
+			// Stale or corrupt cache, will be regenerated:
+			return nullptr;
+		}
+
+		auto Table = std::make_unique<IdTable>(Header.Count);
+		memcpy(Table->data(), Data.data() + sizeof(Header), Header.Count * sizeof(UInt32));
+		LOGD(fmt::format(FMT_STRING("Loaded cached block palette for version {}"), cMultiVersionProtocol::GetVersionTextFromInt(a_Version)));
+		return Table;
+	}
+
+
+
+
+
+	void cBlockMap::SaveIdTableCache(cProtocol::Version a_Version, const IdTable & a_Table)
+	{
+		auto Header = MakeCacheHeader(a_Version);
+		Header.Count = static_cast<UInt32>(a_Table.size());
+
+		cFile File;
+		if (!File.Open(GetVersionFolder(a_Version) + "blocks.bin", cFile::fmWrite))
+		{
+			LOGD(fmt::format(FMT_STRING("Cannot write the block palette cache for version {}, it will be parsed again on the next start"), cMultiVersionProtocol::GetVersionTextFromInt(a_Version)));
+			return;
+		}
+		File.Write(&Header, sizeof(Header));
+		File.Write(a_Table.data(), a_Table.size() * sizeof(UInt32));
 	}
 }
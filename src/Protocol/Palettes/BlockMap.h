@@ -2,6 +2,7 @@
 
 #include <Bindings/BlockTypePalette.h>
 #include "BlockState.h"
+#include "IdTable.h"
 #include "Protocol/Protocol.h"
 
 
@@ -11,24 +12,88 @@ namespace BlockMap
 	class cBlockMap
 	{
 public:
+		using IdTable = BlockMap::IdTable;
+
+		/** Loads the palette of the specified version, if not already loaded.
+		For the latest version, the full palette is kept. For the older versions, only the compact
+		BlockState -> protocol ID table is kept, read from the binary cache next to blocks.json if it is up to date. */
 		void AddVersion(cProtocol::Version a_Version);
 
 		/** This function expects that the BlockStates hardcoded match the latest version supported.
-		*  It also expects that the a_target Version was previously added.
-		*  Instead of doing multiple looks ups we could at startup for each supported version make a BlockState <-> Version_Specific_Id map and just have a single lookup
-		*  Perhaps a compile option or a config option?
+		*  If the a_target Version wasn't loaded yet, it is loaded on first use.
+		*  The lookup is a single array index into the per-version table.
+		*  Returns 0 (air) for blocks that don't exist in the target version.
+		*  Callers translating many blocks should resolve the table once through GetIdTable() instead.
 		*/
-		UInt32 GetProtocolBlockId(cProtocol::Version a_target, BlockState a_block);
-		const BlockTypePalette & GetPalette(cProtocol::Version a_target) const;
+		UInt32 GetProtocolBlockId(cProtocol::Version a_target, BlockState a_block)
+		{
+			return ToProtocolBlockId(GetIdTable(a_target), a_block);
+		}
 
+		/** Returns the ID table for the specified version, loading it on first use.
+		Returns nullptr for the latest version, whose protocol IDs are the BlockState IDs themselves.
+		Once the table is loaded, this doesn't lock; the table stays valid for the lifetime of the map. */
+		const IdTable * GetIdTable(cProtocol::Version a_Version);
+
+		/** Translates the block through a table returned by GetIdTable().
+		Returns 0 (air) for blocks that don't exist in the target version. */
+		static UInt32 ToProtocolBlockId(const IdTable * a_Table, BlockState a_Block)
+		{
+			if (a_Table == nullptr)
+			{
+				return a_Block.ID;
+			}
+			return (a_Block.ID < a_Table->size()) ? (*a_Table)[a_Block.ID] : 0;
+		}
+
+		/** Returns the full palette for the specified version, loading it on first use.
+		Only the latest version's palette is kept in memory by default, the older ones are parsed here only when needed. */
+		const BlockTypePalette & GetPalette(cProtocol::Version a_target);
+
+		/** Scans the Protocol folder for the available versions and loads the latest palette.
+		The palettes for the other versions are loaded lazily, by the first client that needs them. */
 		void LoadAll();
 
 		bool IsVersionLoaded(cProtocol::Version a_Version) const
 		{
-			return m_PerVersionMap.count(a_Version) != 0;
+			cCSLock Lock(m_CS);
+			return (m_PerVersionMap.count(a_Version) != 0) || (m_PerVersionIds.count(a_Version) != 0);
 		}
 private:
-		/** Maps each protocol to its corresponding palette */
+
+		/** Number of protocol versions covered by m_LoadedIds, starting at v1_13. */
+		static constexpr size_t NumIdSlots = static_cast<size_t>(cProtocol::Version::v1_21_7) - static_cast<size_t>(cProtocol::Version::v1_13) + 1;
+
+		/** Protects all the maps, versions are loaded from any thread that serializes blocks for a client. */
+		mutable cCriticalSection m_CS;
+
+		/** Maps each protocol to its corresponding palette, only the latest version and those explicitly requested through GetPalette(). */
 		std::map<cProtocol::Version, BlockTypePalette> m_PerVersionMap;
+
+		/** Maps each older protocol to its BlockState ID -> protocol block ID table.
+		The tables are never removed, so the references handed out stay valid. */
+		std::map<cProtocol::Version, std::unique_ptr<const IdTable>> m_PerVersionIds;
+
+		/** The tables from m_PerVersionIds, indexed by the protocol number minus v1_13, so that GetIdTable() finds them without locking.
+		Set once a table is loaded; versions outside the range are always looked up in m_PerVersionIds. */
+		std::array<std::atomic<const IdTable *>, NumIdSlots> m_LoadedIds{};
+
+		/** Versions that have a Protocol/<version> folder, filled by LoadAll(). */
+		std::set<cProtocol::Version> m_AvailableVersions;
+
+		/** Returns the ID table for the specified (non-latest) version, loading it if needed.
+		Never returns nullptr, an empty table is stored if the version cannot be loaded. Expects m_CS to be held. */
+		const IdTable * LoadIdTable(cProtocol::Version a_Version);
+
+		/** Parses the blocks.json file of the specified version into a_Palette.
+		Returns false and logs the reason on failure. */
+		static bool LoadPaletteFromFile(cProtocol::Version a_Version, BlockTypePalette & a_Palette);
+
+		/** Loads the ID table for the specified version from the binary cache.
+		Returns nullptr if the cache doesn't exist or is stale (the source json files changed). */
+		static std::unique_ptr<IdTable> LoadIdTableCache(cProtocol::Version a_Version);
+
+		/** Writes the ID table for the specified version into the binary cache. */
+		static void SaveIdTableCache(cProtocol::Version a_Version, const IdTable & a_Table);
 	};
 }
@@ -0,0 +1,12 @@
+#pragma once
+
+
+
+
+
+namespace BlockMap
+{
+	/** Maps the latest version's BlockState IDs to the protocol block IDs of an older version.
+	Declared apart from cBlockMap, so that the users of the tables don't need to include BlockMap.h. */
+	using IdTable = std::vector<UInt32>;
+}
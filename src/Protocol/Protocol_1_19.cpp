@@ -799,13 +799,13 @@ void cProtocol_1_19::SendRespawn(eDimension a_Dimension)
 
 void cProtocol_1_19::HandlePacketChatMessage(cByteBuffer & a_ByteBuffer)
 {
-	ContiguousByteBuffer sigdata;
-
-	HANDLE_READ(a_ByteBuffer, ReadVarUTF8String, AString, Message);
+	HANDLE_READ(a_ByteBuffer, ReadVarUTF8String, std::string_view, Message);
 	HANDLE_READ(a_ByteBuffer, ReadBEInt64,       Int64,   timestamp);
 	HANDLE_READ(a_ByteBuffer, ReadBEInt64,       Int64,  sig_salt);
 	HANDLE_READ(a_ByteBuffer, ReadVarInt32,      UInt32, sig_data_len);
-	if (!a_ByteBuffer.ReadSome(sigdata, sig_data_len))
+
+	// The signature isn't verified, skip it:
+	if (!a_ByteBuffer.SkipRead(sig_data_len))
 	{
 		return;
 	}
@@ -2353,16 +2353,15 @@ void cProtocol_1_19_3::HandlePacketCommandExecution(cByteBuffer & a_ByteBuffer)
 
 void cProtocol_1_19_3::HandlePacketChatMessage(cByteBuffer & a_ByteBuffer)
 {
-	ContiguousByteBuffer sigdata;
-
-	HANDLE_READ(a_ByteBuffer, ReadVarUTF8String, AString, Message);
+	HANDLE_READ(a_ByteBuffer, ReadVarUTF8String, std::string_view, Message);
 	HANDLE_READ(a_ByteBuffer, ReadBEInt64,       Int64,   timestamp);
 	HANDLE_READ(a_ByteBuffer, ReadBEInt64,       Int64,  sig_salt);
 
+	// The signature isn't verified, skip it:
 	HANDLE_READ(a_ByteBuffer, ReadBool,       bool,  HasMessageSigData);
 	if (HasMessageSigData)
 	{
-		if (!a_ByteBuffer.ReadSome(sigdata, 256))
+		if (!a_ByteBuffer.SkipRead(256))
 		{
 			return;
 		}
@@ -2371,8 +2370,7 @@ void cProtocol_1_19_3::HandlePacketChatMessage(cByteBuffer & a_ByteBuffer)
 	// Acknowledgment ???
 	HANDLE_READ(a_ByteBuffer, ReadVarInt32,      UInt32, offset);
 
-	ContiguousByteBuffer bitsetvalue;
-	a_ByteBuffer.ReadSome(bitsetvalue, 3);  // temp fix
+	a_ByteBuffer.SkipRead(3);  // temp fix, the acknowledged bitset
 
 	m_Client->HandleChat(Message);
 }
@@ -68,7 +68,8 @@ cProtocol_1_8_0::cProtocol_1_8_0(cClientHandle * a_Client, const AString & a_Ser
 	Super(a_Client),
 	m_State(a_State),
 	m_ServerAddress(a_ServerAddress),
-	m_IsEncrypted(false)
+	m_IsEncrypted(false),
+	m_PacketBuffer(16 KiB)
 {
 	AStringVector Params;
 	SplitZeroTerminatedStrings(a_ServerAddress, Params);
@@ -2552,7 +2553,7 @@ void cProtocol_1_8_0::HandlePacketBlockPlace(cByteBuffer & a_ByteBuffer)
 
 void cProtocol_1_8_0::HandlePacketChatMessage(cByteBuffer & a_ByteBuffer)
 {
-	HANDLE_READ(a_ByteBuffer, ReadVarUTF8String, AString, Message);
+	HANDLE_READ(a_ByteBuffer, ReadVarUTF8String, std::string_view, Message);
 
 	m_Client->HandleChat(Message);
 }
@@ -3692,22 +3693,26 @@ void cProtocol_1_8_0::AddReceivedData(cByteBuffer & a_Buffer, const ContiguousBy
 
 			if (UncompressedSize > 0)
 			{
-				// Decompress the data:
+				// Decompress the data into the extractor's reusable buffer:
 				m_Extractor.ReadFrom(a_Buffer, PacketLen);
 				a_Buffer.CommitRead();
 
-				const auto UncompressedData = m_Extractor.Extract(UncompressedSize);
-				const auto Uncompressed = UncompressedData.GetView();
-				cByteBuffer bb(Uncompressed.size());
-
-				// Compression was used, move the uncompressed data:
-				VERIFY(bb.Write(Uncompressed.data(), Uncompressed.size()));
-
-				HandlePacket(bb);
+				HandlePacketData(m_Extractor.ExtractView(UncompressedSize));
 				continue;
 			}
 		}
 
+		// Move the packet payload to the reusable packet buffer, if it fits:
+		m_PacketBuffer.Clear();
+		if (m_PacketBuffer.CanWriteBytes(PacketLen))
+		{
+			VERIFY(a_Buffer.ReadToByteBuffer(m_PacketBuffer, static_cast<size_t>(PacketLen)));
+			a_Buffer.CommitRead();
+
+			HandlePacket(m_PacketBuffer);
+			continue;
+		}
+
 		// Move the packet payload to a separate cByteBuffer, bb:
 		cByteBuffer bb(PacketLen);
 
@@ -3995,6 +4000,26 @@ const char * cProtocol_1_8_0::GetProtocolStatisticName(const CustomStatistic a_S
 
 
 
+void cProtocol_1_8_0::HandlePacketData(const ContiguousByteBufferView a_Data)
+{
+	m_PacketBuffer.Clear();
+	if (m_PacketBuffer.CanWriteBytes(a_Data.size()))
+	{
+		VERIFY(m_PacketBuffer.Write(a_Data.data(), a_Data.size()));
+		HandlePacket(m_PacketBuffer);
+		return;
+	}
+
+	// Too large for the reusable buffer:
+	cByteBuffer bb(a_Data.size());
+	VERIFY(bb.Write(a_Data.data(), a_Data.size()));
+	HandlePacket(bb);
+}
+
+
+
+
+
 void cProtocol_1_8_0::HandlePacket(cByteBuffer & a_Buffer)
 {
 	UInt32 PacketType;
@@ -277,6 +277,10 @@ private:
 	CircularBufferCompressor m_Compressor;
 	CircularBufferExtractor m_Extractor;
 
+	/** Buffer for the packet being handled, reused for all packets that fit so that parsing doesn't allocate.
+	The handlers may keep views into it (such as ReadVarUTF8String(std::string_view &)) only until they return. */
+	cByteBuffer m_PacketBuffer;
+
 	/** The logfile where the comm is logged, when g_ShouldLogComm is true */
 	cFile m_CommLogFile;
 
@@ -290,4 +294,7 @@ private:
 
 	/** Handle a complete packet stored in the given buffer. */
 	void HandlePacket(cByteBuffer & a_Buffer);
+
+	/** Handle a complete uncompressed packet, copied into m_PacketBuffer if it fits. */
+	void HandlePacketData(ContiguousByteBufferView a_Data);
 } ;
@@ -1108,3 +1108,7 @@ enum class BlockType
 	ZombieHead,
 	ZombieWallHead,
 };
+
+/** The number of the block types, for tables indexed by BlockType. Must name the last enumerator above. */
+constexpr size_t NumBlockTypes = static_cast<size_t>(BlockType::ZombieWallHead) + 1;
+static_assert(static_cast<size_t>(BlockType::AcaciaButton) == 0, "Tables indexed by BlockType expect the enumerators to start at zero");
@@ -44,11 +44,13 @@
 #include "Protocol/ProtocolRecognizer.h"  // for protocol version constants
 #include "CommandOutput.h"
 #include "DeadlockDetect.h"
+#include "TickTrace.h"
 #include "LoggerListeners.h"
 #include "BuildInfo.h"
 #include "IniFile.h"
 #include "OverridesSettingsRepository.h"
 #include "Logger.h"
+#include "WorldStorage/PlayerDataWriter.h"
 #include "ClientHandle.h"
 #include "AllTags/AbstractTag.h"
 
@@ -119,6 +121,15 @@ bool cRoot::Run(cSettingsRepositoryInterface & a_OverridesRepo)
 		fileAttachment = cLogger::GetInstance().AttachListener(std::move(fileLogListenerRet.second));
 	}
 
+	const struct AsyncLoggingRAII
+	{
+		~AsyncLoggingRAII()
+		{
+			// Write out the queued messages while the listeners are still attached:
+			cLogger::GetInstance().StopAsync();
+		}
+	} AsyncLogging;
+
 	LOG("--- Started Log ---");
 
 #ifdef BUILD_ID
@@ -163,6 +174,12 @@ bool cRoot::Run(cSettingsRepositoryInterface & a_OverridesRepo)
 
 	auto settingsRepo = std::make_unique<cOverridesSettingsRepository>(std::move(IniFile), a_OverridesRepo);
 
+	// Write the log from a separate thread, so that the logging threads don't wait for the console and disk:
+	if (settingsRepo->GetValueSetB("Server", "AsyncLogging", true))
+	{
+		cLogger::GetInstance().StartAsync();
+	}
+
 	LOG("Starting server...");
 
 	// cClientHandle::FASTBREAK_PERCENTAGE = settingsRepo->GetValueSetI("AntiCheat", "FastBreakPercentage", 97) / 100.0f;
@@ -208,6 +225,15 @@ bool cRoot::Run(cSettingsRepositoryInterface & a_OverridesRepo)
 	LOGD("Starting Authenticator...");
 	m_Authenticator.Start(*settingsRepo);
 
+	LOGD("Starting player data writer...");
+	cPlayerDataWriter::Get().Start();
+
+	cTickTrace::Configure(
+		settingsRepo->GetValueSetB("TickTrace", "Enabled", true),
+		std::chrono::milliseconds(settingsRepo->GetValueSetI("TickTrace", "BudgetMSec", 200)),
+		settingsRepo->GetValueSet("TickTrace", "Folder", "ticktraces")
+	);
+
 	LOGD("Starting worlds...");
 	StartWorlds(dd);
 
@@ -251,6 +277,10 @@ bool cRoot::Run(cSettingsRepositoryInterface & a_OverridesRepo)
 	LOGD("Stopping authenticator...");
 	m_Authenticator.Stop();
 
+	// Writes out the player saves queued while the worlds were stopping, the later saves are synchronous:
+	LOGD("Stopping player data writer...");
+	cPlayerDataWriter::Get().Stop();
+
 	LOGD("Freeing MonsterConfig...");
 	delete m_MonsterConfig; m_MonsterConfig = nullptr;
 	delete m_WebAdmin; m_WebAdmin = nullptr;
@@ -995,6 +1025,16 @@ void cRoot::LogChunkStats(cCommandOutputCallback & a_Output)
 	a_Output.OutLn(fmt::format(FMT_STRING("  heightmap:      {:06} bytes ({:3} KiB)"), sizeof(cChunkDef::HeightMap), (sizeof(cChunkDef::HeightMap) + 1023) / 1024));
 	a_Output.OutLn(fmt::format(FMT_STRING("  biomemap:       {:06} bytes ({:3} KiB)"), sizeof(cChunkDef::BiomeMap), (sizeof(cChunkDef::BiomeMap) + 1023) / 1024));
 	*/
+
+	a_Output.OutLn("Chunk section pools:");
+	for (const auto & Pool : GetChunkSectionPoolStats())
+	{
+		const auto Mem = Pool.m_ItemSize * Pool.m_NumItems;
+		a_Output.OutLn(fmt::format(
+			FMT_STRING("  {:6} byte sections: {} slabs, {} of {} sections used, {} KiB reserved"),
+			Pool.m_ItemSize, Pool.m_NumSlabs, Pool.m_NumUsed, Pool.m_NumItems, (Mem + 1023) / 1024
+		));
+	}
 }
 
 
@@ -577,6 +577,13 @@ void cServer::ExecuteConsoleCommand(const AString & a_Cmd, cCommandOutputCallbac
 		a_Output.Finished();
 		return;
 	}
+
+	else if (split[0].compare("pregen") == 0)
+	{
+		ExecutePregenCommand(split, a_Output);
+		a_Output.Finished();
+		return;
+	}
 	else if (cPluginManager::Get()->ExecuteConsoleCommand(split, a_Output, a_Cmd))
 	{
 		a_Output.Finished();
@@ -635,6 +642,75 @@ void cServer::PrintHelp(const AStringVector & a_Split, cCommandOutputCallback &
 
 
 
+void cServer::ExecutePregenCommand(const AStringVector & a_Split, cCommandOutputCallback & a_Output)
+{
+	const auto PrintUsage = [&a_Output]()
+	{
+		a_Output.OutLn("Usage:");
+		a_Output.OutLn("  pregen <World> spiral <CenterChunkX> <CenterChunkZ> <RadiusChunks>");
+		a_Output.OutLn("  pregen <World> square <Chunk1X> <Chunk1Z> <Chunk2X> <Chunk2Z>");
+		a_Output.OutLn("  pregen <World> status");
+		a_Output.OutLn("  pregen <World> stop");
+	};
+	if (a_Split.size() < 3)
+	{
+		PrintUsage();
+		return;
+	}
+
+	auto World = cRoot::Get()->GetWorld(a_Split[1]);
+	if (World == nullptr)
+	{
+		a_Output.OutLn(fmt::format(FMT_STRING("There is no world \"{}\"."), a_Split[1]));
+		return;
+	}
+
+	// Parse the numeric params, if any:
+	std::vector<int> Params;
+	for (size_t i = 3; i < a_Split.size(); i++)
+	{
+		int Value;
+		if (!StringToInteger(a_Split[i], Value))
+		{
+			a_Output.OutLn(fmt::format(FMT_STRING("\"{}\" is not a number."), a_Split[i]));
+			return;
+		}
+		Params.push_back(Value);
+	}
+
+	const auto & Action = a_Split[2];
+	if ((NoCaseCompare(Action, "status") == 0) && Params.empty())
+	{
+		a_Output.OutLn(World->GetPregenerationStatus());
+	}
+	else if ((NoCaseCompare(Action, "stop") == 0) && Params.empty())
+	{
+		a_Output.OutLn(World->StopPregeneration() ? "Pregeneration stopped." : "No pregeneration is running in that world.");
+	}
+	else if ((NoCaseCompare(Action, "spiral") == 0) && (Params.size() == 3))
+	{
+		a_Output.OutLn(
+			World->StartPregenerationSpiral(Params[0], Params[1], Params[2]) ?
+			"Pregeneration started." : "A pregeneration is already running in that world."
+		);
+	}
+	else if ((NoCaseCompare(Action, "square") == 0) && (Params.size() == 4))
+	{
+		a_Output.OutLn(
+			World->StartPregenerationSquare(Params[0], Params[1], Params[2], Params[3]) ?
+			"Pregeneration started." : "A pregeneration is already running in that world."
+		);
+	}
+	else
+	{
+		PrintUsage();
+	}
+}
+
+
+
+
+
 void cServer::BindBuiltInConsoleCommands(void)
 {
 	// Create an empty handler - the actual handling for the commands is performed before they are handed off to cPluginManager
@@ -664,6 +740,7 @@ void cServer::BindBuiltInConsoleCommands(void)
 	PlgMgr->BindConsoleCommand("load",            nullptr, handler, "Adds and enables the specified plugin");
 	PlgMgr->BindConsoleCommand("unload",          nullptr, handler, "Disables the specified plugin");
 	PlgMgr->BindConsoleCommand("destroyentities", nullptr, handler, "Destroys all entities in all worlds");
+	PlgMgr->BindConsoleCommand("pregen",          nullptr, handler, "Pregenerates an area of a world in the background");
 }
 
 
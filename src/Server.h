@@ -117,6 +117,9 @@ public:
 	/** Lists all available console commands and their helpstrings */
 	void PrintHelp(const AStringVector & a_Split, cCommandOutputCallback & a_Output);
 
+	/** Handles the "pregen" console command that starts, stops and queries the pregeneration of a world. */
+	void ExecutePregenCommand(const AStringVector & a_Split, cCommandOutputCallback & a_Output);
+
 	/** Binds the built-in console commands with the plugin manager */
 	static void BindBuiltInConsoleCommands(void);
 
@@ -18,22 +18,26 @@
 ////////////////////////////////////////////////////////////////////////////////
 // cDelayedFluidSimulatorChunkData::cSlot
 
-bool cDelayedFluidSimulatorChunkData::cSlot::Add(int a_RelX, int a_RelY, int a_RelZ)
+bool cDelayedFluidSimulatorChunkData::cSlot::Add(Vector3i a_RelPos)
 {
-	ASSERT(a_RelZ >= 0);
-	ASSERT(a_RelZ < static_cast<int>(ARRAYCOUNT(m_Blocks)));
+	static_assert(cChunkDef::NumBlocks <= std::numeric_limits<UInt16>::max() + 1, "Block indices must fit into UInt16");
+	ASSERT(cChunkDef::IsValidRelPos(a_RelPos));
 
-	auto & Blocks = m_Blocks[a_RelZ];
-	const auto Index = cChunkDef::MakeIndex(a_RelX, a_RelY, a_RelZ);
-	for (const auto & Block : Blocks)
+	const auto Index = cChunkDef::MakeIndex(a_RelPos);
+	auto & Queued = m_Queued[Index / SectionBlockCount];
+	if (Queued == nullptr)
 	{
-		if (Block.Data == Index)
-		{
-			// Already present
-			return false;
-		}
-	}  // for itr - Blocks[]
-	Blocks.emplace_back(a_RelX, a_RelY, a_RelZ, Index);
+		Queued = std::make_unique<cSectionBits>();
+	}
+
+	const auto Bit = Index % SectionBlockCount;
+	if (Queued->test(Bit))
+	{
+		// Already present
+		return false;
+	}
+	Queued->set(Bit);
+	m_Blocks.push_back(static_cast<UInt16>(Index));
 	return true;
 }
 
@@ -41,6 +45,23 @@ bool cDelayedFluidSimulatorChunkData::cSlot::Add(int a_RelX, int a_RelY, int a_R
 
 
 
+void cDelayedFluidSimulatorChunkData::cSlot::TakeBlocks(std::vector<UInt16> & a_Blocks)
+{
+	// Swap the buffers, so that both keep their allocations for the next ticks:
+	a_Blocks.clear();
+	std::swap(a_Blocks, m_Blocks);
+
+	for (const auto Index : a_Blocks)
+	{
+		m_Queued[Index / SectionBlockCount]->reset(Index % SectionBlockCount);
+	}
+	std::sort(a_Blocks.begin(), a_Blocks.end());
+}
+
+
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 // cDelayedFluidSimulatorChunkData:
 
@@ -97,23 +118,20 @@ void cDelayedFluidSimulator::SimulateChunk(std::chrono::milliseconds a_Dt, int a
 {
 	auto ChunkDataRaw = (m_FluidBlock == BlockType::Water) ? a_Chunk->GetWaterSimulatorData() : a_Chunk->GetLavaSimulatorData();
 	cDelayedFluidSimulatorChunkData * ChunkData = static_cast<cDelayedFluidSimulatorChunkData *>(ChunkDataRaw);
-	cDelayedFluidSimulatorChunkData::cSlot & Slot = ChunkData->m_Slots[m_SimSlotNum];
+
+	// Take the blocks out of the slot first, the simulation may queue more blocks (even into the same slot, if the delay is 1):
+	ChunkData->m_Slots[m_SimSlotNum].TakeBlocks(m_SimulatingBlocks);
+	if (m_SimulatingBlocks.empty())
+	{
+		return;
+	}
 
 	// Simulate all the blocks in the scheduled slot:
-	for (size_t i = 0; i < ARRAYCOUNT(Slot.m_Blocks); i++)
+	for (const auto Index : m_SimulatingBlocks)
 	{
-		auto & Blocks = Slot.m_Blocks[i];
-		if (Blocks.empty())
-		{
-			continue;
-		}
-		for (const auto & Block : Blocks)
-		{
-			SimulateBlock(a_Chunk, {Block.x, Block.y, Block.z});
-		}
-		m_TotalBlocks -= static_cast<int>(Blocks.size());
-		Blocks.clear();
+		SimulateBlock(a_Chunk, cChunkDef::IndexToCoordinate(Index));
 	}
+	m_TotalBlocks -= static_cast<int>(m_SimulatingBlocks.size());
 }
 
 
@@ -127,15 +145,69 @@ void cDelayedFluidSimulator::AddBlock(cChunk & a_Chunk, Vector3i a_Position, Blo
 		return;
 	}
 
+	// Settled fluid doesn't need simulating until a neighbor changes:
+	if (IsDormant(a_Chunk, a_Position, a_Block))
+	{
+		return;
+	}
+
 	auto ChunkDataRaw = (m_FluidBlock == BlockType::Water) ? a_Chunk.GetWaterSimulatorData() : a_Chunk.GetLavaSimulatorData();
 	cDelayedFluidSimulatorChunkData * ChunkData = static_cast<cDelayedFluidSimulatorChunkData *>(ChunkDataRaw);
 	cDelayedFluidSimulatorChunkData::cSlot & Slot = ChunkData->m_Slots[m_AddSlotNum];
 
 	// Add, if not already present:
-	if (!Slot.Add(a_Position.x, a_Position.y, a_Position.z))
+	if (!Slot.Add(a_Position))
 	{
 		return;
 	}
 
 	++m_TotalBlocks;
 }
+
+
+
+
+
+bool cDelayedFluidSimulator::IsDormant(cChunk & a_Chunk, Vector3i a_RelPos, BlockState a_Block)
+{
+	if (cBlockFluidHandler::GetFalloff(a_Block) != m_StationaryFalloffValue)
+	{
+		// Flowing fluid needs to check its tributaries:
+		return false;
+	}
+
+	// A source spreads down and to the sides, it does nothing if it can't flow anywhere:
+	const auto IsSettledNeighbor = [this](BlockState a_Neighbor)
+	{
+		if (a_Neighbor.Type() == m_FluidBlock)
+		{
+			return (cBlockFluidHandler::GetFalloff(a_Neighbor) == m_StationaryFalloffValue);
+		}
+		return !IsPassableForFluid(a_Neighbor) && (a_Neighbor.Type() != BlockType::Water) && (a_Neighbor.Type() != BlockType::Lava);
+	};
+
+	if ((a_RelPos.y > 0) && !IsSettledNeighbor(a_Chunk.GetBlock(a_RelPos.addedY(-1))))
+	{
+		return false;
+	}
+	for (const auto & Offset : FlatCrossCoords)
+	{
+		BlockState Neighbor;
+		if (!a_Chunk.UnboundedRelGetBlock(a_RelPos + Offset, Neighbor) || !IsSettledNeighbor(Neighbor))
+		{
+			// Also when the neighbor chunk isn't loaded, the block will need to be simulated once it is
+			return false;
+		}
+	}
+
+	// The other fluid above would harden this block:
+	if (a_RelPos.y < cChunkDef::Height - 1)
+	{
+		const auto Above = a_Chunk.GetBlock(a_RelPos.addedY(1)).Type();
+		if ((Above != m_FluidBlock) && ((Above == BlockType::Water) || (Above == BlockType::Lava)))
+		{
+			return false;
+		}
+	}
+	return true;
+}
@@ -22,16 +22,24 @@ public:
 	class cSlot
 	{
 	public:
-		/** Returns true if the specified block is stored */
-		bool HasBlock(int a_RelX, int a_RelY, int a_RelZ);
-
 		/** Adds the specified block unless already present; returns true if added, false if the block was already present */
-		bool Add(int a_RelX, int a_RelY, int a_RelZ);
+		bool Add(Vector3i a_RelPos);
+
+		/** Moves all the queued blocks into a_Blocks, as chunk block indices, and empties the slot.
+		The indices are sorted, so that the blocks are simulated section by section. */
+		void TakeBlocks(std::vector<UInt16> & a_Blocks);
+
+	private:
+
+		static constexpr size_t SectionBlockCount = cChunkDef::Width * cChunkDef::Width * cChunkDef::SectionHeight;
+		using cSectionBits = std::bitset<SectionBlockCount>;
 
-		/** Array of block containers, each item stores blocks for one Z coord
-		size_t param is the block index (for faster duplicate comparison in Add())
-		*/
-		std::vector<cCoordWithData<size_t>> m_Blocks[16];
+		/** For each section, the set of blocks queued in this slot, for constant-time duplicate checks in Add().
+		Allocated only for the sections that have ever had a block queued. */
+		std::array<std::unique_ptr<cSectionBits>, cChunkDef::NumSections> m_Queued;
+
+		/** The queued blocks, as chunk block indices, in the order in which they were added. */
+		std::vector<UInt16> m_Blocks;
 	} ;
 
 	cDelayedFluidSimulatorChunkData(size_t a_TickDelay);
@@ -67,12 +75,20 @@ protected:
 
 	int m_TotalBlocks;  // Statistics only: the total number of blocks currently queued
 
+	/** The blocks being simulated by SimulateChunk(), kept between the calls to reuse the allocation. */
+	std::vector<UInt16> m_SimulatingBlocks;
+
 	/* Slots:
 	| 0 | 1 | ... | m_AddSlotNum | m_SimSlotNum | ... | m_TickDelay - 1 |
 	|       adding blocks here ^ | ^ simulating here */
 
 	/** Called from SimulateChunk() to simulate each block in one slot of blocks. Descendants override this method to provide custom simulation. */
 	virtual void SimulateBlock(cChunk * a_Chunk, Vector3i a_RelPos) = 0;
+
+	/** Returns true if the specified fluid block is a source that is fully surrounded by sources of the same fluid or by solid blocks.
+	Simulating such a block would do nothing, so it isn't queued at all (settled oceans and lakes). It is re-evaluated
+	whenever one of its neighbors changes, since that wakes it up again through AddBlock(). */
+	bool IsDormant(cChunk & a_Chunk, Vector3i a_RelPos, BlockState a_Block);
 } ;
 
 
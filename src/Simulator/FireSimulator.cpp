@@ -36,6 +36,16 @@
 
 
 
+/** Converts a time in msec into the number of ticks, rounding up and at least one tick. */
+static int MSecToTicks(int a_MSec)
+{
+	return std::max(1, (a_MSec + 49) / 50);
+}
+
+
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 // cFireSimulator:
 
@@ -55,19 +65,19 @@ cFireSimulator::cFireSimulator(cWorld & a_World, cIniFile & a_IniFile) :
 
 void cFireSimulator::SimulateChunk(std::chrono::milliseconds a_Dt, int a_ChunkX, int a_ChunkZ, cChunk * a_Chunk)
 {
-	cCoordWithIntList & Data = a_Chunk->GetFireSimulatorData();
+	auto & Data = a_Chunk->GetFireSimulatorData();
 
-	int NumMSecs = static_cast<int>(a_Dt.count());
-	for (cCoordWithIntList::iterator itr = Data.begin(); itr != Data.end();)
+	// Only the blocks scheduled for this tick are simulated:
+	Data.TakeDue(m_DueBlocks);
+	for (const auto & [RelPos, NumTicks] : m_DueBlocks)
 	{
-		Vector3i RelPos(itr->x, itr->y, itr->z);
 		auto Self = a_Chunk->GetBlock(RelPos);
 
 		if (!IsAllowedBlock(Self))
 		{
 			// The block is no longer eligible (not a fire block anymore; a player probably placed a block over the fire)
 			FIRE_FLOG("FS: Removing block {0}", AbsPos);
-			itr = Data.erase(itr);
+			Data.Remove(RelPos);
 			continue;
 		}
 
@@ -84,24 +94,20 @@ void cFireSimulator::SimulateChunk(std::chrono::milliseconds a_Dt, int a_ChunkX,
 			return false;
 		});
 
-		// Randomly burn out the fire if it is raining:
-		if (!BurnsForever && Raining && GetRandomProvider().RandBool(CHANCE_BASE_RAIN_EXTINGUISH + (a_Chunk->GetBlock(RelPos.addedY(-1)).ID * CHANCE_AGE_M_RAIN_EXTINGUISH)))
+		// Randomly burn out the fire if it is raining, with the chance of it happening in any of the ticks since the last simulation:
+		if (!BurnsForever && Raining)
 		{
-			a_Chunk->SetBlock(RelPos, Block::Air::Air());
-			itr = Data.erase(itr);
-			continue;
+			const auto ChancePerTick = std::clamp(CHANCE_BASE_RAIN_EXTINGUISH + (a_Chunk->GetBlock(RelPos.addedY(-1)).ID * CHANCE_AGE_M_RAIN_EXTINGUISH), 0.0, 1.0);
+			if (GetRandomProvider().RandBool(1 - std::pow(1 - ChancePerTick, NumTicks)))
+			{
+				a_Chunk->SetBlock(RelPos, Block::Air::Air());
+				Data.Remove(RelPos);
+				continue;
+			}
 		}
 
 		// Try to spread the fire:
-		TrySpreadFire(a_Chunk, RelPos);
-
-		itr->Data -= NumMSecs;
-		if (itr->Data >= 0)
-		{
-			// Not yet, wait for it longer
-			++itr;
-			continue;
-		}
+		TrySpreadFire(a_Chunk, RelPos, NumTicks);
 
 		// FIRE_FLOG("FS: Fire at {0} is stepping", AbsPos);
 
@@ -111,7 +117,7 @@ void cFireSimulator::SimulateChunk(std::chrono::milliseconds a_Dt, int a_ChunkX,
 		{
 			// Fire has no fuel or ground block, extinguish flame
 			a_Chunk->SetBlock(RelPos, Block::Air::Air());
-			itr = Data.erase(itr);
+			Data.Remove(RelPos);
 			continue;
 		}
 
@@ -122,7 +128,7 @@ void cFireSimulator::SimulateChunk(std::chrono::milliseconds a_Dt, int a_ChunkX,
 			FIRE_FLOG("FS: Fire at {0} burnt out, removing the fire block", AbsPos);
 			a_Chunk->SetBlock(RelPos, Block::Air::Air());
 			RemoveFuelNeighbors(a_Chunk, RelPos);
-			itr = Data.erase(itr);
+			Data.Remove(RelPos);
 			continue;
 		}
 
@@ -141,9 +147,8 @@ void cFireSimulator::SimulateChunk(std::chrono::milliseconds a_Dt, int a_ChunkX,
 			));
 		}
 
-		itr->Data = BurnStep;
-		++itr;
-	}  // for itr - Data[]
+		Data.Schedule(RelPos, MSecToTicks(BurnStep));
+	}  // for RelPos - m_DueBlocks[]
 }
 
 
@@ -161,7 +166,28 @@ bool cFireSimulator::IsAllowedBlock(BlockState a_Block)
 
 bool cFireSimulator::IsFuel(BlockState a_Block)
 {
-	switch (a_Block.Type())
+	static const auto FuelTable = []
+	{
+		std::bitset<NumBlockTypes> Table;
+		for (size_t i = 0; i < Table.size(); i++)
+		{
+			Table[i] = IsFuelType(static_cast<BlockType>(i));
+		}
+		return Table;
+	}();
+
+	const auto Index = static_cast<size_t>(a_Block.Type());
+	ASSERT(Index < FuelTable.size());
+	return FuelTable[Index];
+}
+
+
+
+
+
+bool cFireSimulator::IsFuelType(BlockType a_BlockType)
+{
+	switch (a_BlockType)
 	{
 		case BlockType::Bookshelf:
 		case BlockType::Tnt:
@@ -318,28 +344,23 @@ void cFireSimulator::AddBlock(cChunk & a_Chunk, Vector3i a_Position, BlockState
 		return;
 	}
 
-	// Check for duplicates:
 	cFireSimulatorChunkData & ChunkData = a_Chunk.GetFireSimulatorData();
-	for (cCoordWithIntList::iterator itr = ChunkData.begin(), end = ChunkData.end(); itr != end; ++itr)
+	const auto TicksLeft = ChunkData.GetTicksLeft(a_Position);
+	if (TicksLeft >= 0)
 	{
-		const Vector3i ItrPos{itr->x, itr->y, itr->z};
-		if (ItrPos == a_Position)
+		// Block already present, check if burn step should decrease
+		// This means if fuel is removed, then the fire burns out sooner
+		const auto NewBurnStep = MSecToTicks(GetBurnStepTime(&a_Chunk, a_Position));
+		if (TicksLeft > NewBurnStep)
 		{
-			// Block already present, check if burn step should decrease
-			// This means if fuel is removed, then the fire burns out sooner
-			const auto NewBurnStep = GetBurnStepTime(&a_Chunk, a_Position);
-			if (itr->Data > NewBurnStep)
-			{
-				FIRE_FLOG("FS: Block lost its fuel at {0}", a_Block);
-				itr->Data = NewBurnStep;
-			}
-
-			return;
+			FIRE_FLOG("FS: Block lost its fuel at {0}", a_Block);
+			ChunkData.Schedule(a_Position, NewBurnStep);
 		}
-	}  // for itr - ChunkData[]
+		return;
+	}
 
 	FIRE_FLOG("FS: Adding block {0}", a_Block);
-	ChunkData.emplace_back(a_Position.x, a_Position.y, a_Position.z, 100);
+	ChunkData.Schedule(a_Position, MSecToTicks(100));
 }
 
 
@@ -389,8 +410,11 @@ int cFireSimulator::GetBurnStepTime(cChunk * a_Chunk, Vector3i a_RelPos)
 
 
 
-void cFireSimulator::TrySpreadFire(cChunk * a_Chunk, Vector3i a_RelPos)
+void cFireSimulator::TrySpreadFire(cChunk * a_Chunk, Vector3i a_RelPos, int a_NumTicks)
 {
+	// The chance of a neighbor catching fire in any of the ticks since the last simulation:
+	const auto Chance = 1 - std::pow(1 - m_Flammability * (1.0 / MAX_CHANCE_FLAMMABILITY), a_NumTicks);
+
 	/*
 	if (GetRandomProvider().RandBool(0.99))
 	{
@@ -408,7 +432,7 @@ void cFireSimulator::TrySpreadFire(cChunk * a_Chunk, Vector3i a_RelPos)
 				// No need to check the coords for equality with the parent block,
 				// it cannot catch fire anyway (because it's not an air block)
 
-				if (!GetRandomProvider().RandBool(m_Flammability * (1.0 / MAX_CHANCE_FLAMMABILITY)))
+				if (!GetRandomProvider().RandBool(Chance))
 				{
 					continue;
 				}
@@ -2,6 +2,7 @@
 #pragma once
 
 #include "Simulator.h"
+#include "FireSimulatorChunkData.h"
 #include "../IniFile.h"
 
 
@@ -10,9 +11,9 @@
 
 /** The fire simulator takes care of the fire blocks.
 It periodically increases their meta ("steps") until they "burn out"; it also supports the forever burning netherrack.
-Each individual fire block gets stored in per-chunk data; that list is then used for fast retrieval.
-The data value associated with each coord is used as the number of msec that the fire takes until
-it progresses to the next step (blockmeta++). This value is updated if a neighbor is changed.
+Each individual fire block gets scheduled in per-chunk data (cFireSimulatorChunkData) for the tick in which
+it progresses to the next step (blockmeta++), and is only simulated in that tick. The schedule is moved sooner if a neighbor is changed.
+The chances of spreading and of being extinguished by rain are applied for all the ticks since the block was last simulated.
 The simulator reads its parameters from the ini file given to the constructor.
 */
 class cFireSimulator :
@@ -22,6 +23,7 @@ public:
 
 	cFireSimulator(cWorld & a_World, cIniFile & a_IniFile);
 
+	/** Returns true if the block can catch fire. Uses a table precomputed for all block types. */
 	static bool IsFuel         (BlockState a_BlockType);
 	static bool DoesBurnForever(BlockState a_BlockType);
 
@@ -31,6 +33,12 @@ private:
 
 	static bool IsAllowedBlock(BlockState a_Block);
 
+	/** Returns true if the block type can catch fire, used to build the table for IsFuel(). */
+	static bool IsFuelType(BlockType a_BlockType);
+
+	/** The fire blocks due in the current SimulateChunk() call, kept between the calls to reuse the allocation. */
+	std::vector<std::pair<Vector3i, int>> m_DueBlocks;
+
 	/** Time (in msec) that a fire block takes to burn with a fuel block into the next step */
 	unsigned m_BurnStepTimeFuel;
 
@@ -48,8 +56,8 @@ private:
 	/** Returns the time [msec] after which the specified fire block is stepped again; based on surrounding fuels */
 	int GetBurnStepTime(cChunk * a_Chunk, Vector3i a_RelPos);
 
-	/** Tries to spread fire to a neighborhood of the specified block */
-	void TrySpreadFire(cChunk * a_Chunk, Vector3i a_RelPos);
+	/** Tries to spread fire to a neighborhood of the specified block, with the chances for a_NumTicks ticks */
+	void TrySpreadFire(cChunk * a_Chunk, Vector3i a_RelPos, int a_NumTicks);
 
 	/** Removes all burnable blocks neighboring the specified block */
 	void RemoveFuelNeighbors(cChunk * a_Chunk, Vector3i a_RelPos);
@@ -64,6 +72,3 @@ private:
 
 
 
-
-/** Stores individual fire blocks in the chunk; the int data is used as the time [msec] the fire takes to step to another stage (blockmeta++) */
-typedef cCoordWithIntList cFireSimulatorChunkData;
@@ -0,0 +1,110 @@
+
+// FireSimulatorChunkData.cpp
+
+// Implements the cFireSimulatorChunkData class that schedules the fire blocks of a single chunk
+
+#include "Globals.h"
+#include "FireSimulatorChunkData.h"
+
+
+
+
+
+void cFireSimulatorChunkData::Schedule(Vector3i a_RelPos, int a_NumTicks)
+{
+	ASSERT(a_NumTicks > 0);
+
+	if (m_Wheel.empty())
+	{
+		m_Wheel.resize(WheelSize);
+	}
+
+	const auto Index = static_cast<UInt16>(cChunkDef::MakeIndex(a_RelPos));
+	const auto DueTick = m_CurrentTick + a_NumTicks;
+	const auto [itr, IsNew] = m_Fires.try_emplace(Index, sFire{ DueTick, m_CurrentTick });
+	if (!IsNew)
+	{
+		const auto OldDueTick = std::exchange(itr->second.m_DueTick, DueTick);
+		if ((OldDueTick > m_CurrentTick) && ((OldDueTick % WheelSize) == (DueTick % WheelSize)))
+		{
+			// The old entry is still pending in the same bucket, which is visited at the new due tick as well.
+			// An entry already due has been taken out of its bucket by TakeDue(), so it needs to be pushed again:
+			return;
+		}
+	}
+	m_Wheel[static_cast<size_t>(DueTick % WheelSize)].push_back(Index);
+}
+
+
+
+
+
+int cFireSimulatorChunkData::GetTicksLeft(Vector3i a_RelPos) const
+{
+	const auto itr = m_Fires.find(static_cast<UInt16>(cChunkDef::MakeIndex(a_RelPos)));
+	if (itr == m_Fires.end())
+	{
+		return -1;
+	}
+	return static_cast<int>(itr->second.m_DueTick - m_CurrentTick);
+}
+
+
+
+
+
+void cFireSimulatorChunkData::Remove(Vector3i a_RelPos)
+{
+	// The entry in the wheel becomes stale and is dropped when its bucket is visited:
+	m_Fires.erase(static_cast<UInt16>(cChunkDef::MakeIndex(a_RelPos)));
+}
+
+
+
+
+
+void cFireSimulatorChunkData::TakeDue(std::vector<std::pair<Vector3i, int>> & a_Due)
+{
+	a_Due.clear();
+	m_CurrentTick += 1;
+	if (m_Fires.empty())
+	{
+		return;
+	}
+
+	const auto BucketIndex = static_cast<size_t>(m_CurrentTick % WheelSize);
+	auto & Bucket = m_Wheel[BucketIndex];
+
+	// Walk the bucket, taking out the due blocks, dropping the stale entries and keeping the ones due in a later round:
+	size_t NumKept = 0;
+	for (const auto Index : Bucket)
+	{
+		const auto itr = m_Fires.find(Index);
+		if ((itr == m_Fires.end()) || (static_cast<size_t>(itr->second.m_DueTick % WheelSize) != BucketIndex))
+		{
+			// Removed or rescheduled into another bucket
+			continue;
+		}
+
+		auto & Fire = itr->second;
+		if (Fire.m_DueTick > m_CurrentTick)
+		{
+			Bucket[NumKept++] = Index;
+			continue;
+		}
+		if (Fire.m_LastTick == m_CurrentTick)
+		{
+			// A duplicate entry, the block has already been taken
+			continue;
+		}
+
+		a_Due.emplace_back(cChunkDef::IndexToCoordinate(Index), static_cast<int>(m_CurrentTick - Fire.m_LastTick));
+		Fire.m_LastTick = m_CurrentTick;
+	}
+	Bucket.resize(NumKept);
+}
+
+
+
+
+
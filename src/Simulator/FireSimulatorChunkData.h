@@ -0,0 +1,56 @@
+// FireSimulatorChunkData.h
+
+// Declares the cFireSimulatorChunkData class that schedules the fire blocks of a single chunk
+
+
+
+
+
+#pragma once
+
+#include "../ChunkDef.h"
+
+
+
+
+
+/** Stores the fire blocks in a chunk, scheduled for the tick in which they step to another stage (blockmeta++).
+The schedule is a time wheel of WheelSize buckets, each tick only the bucket of that tick is visited.
+Blocks scheduled more than WheelSize ticks ahead stay in their bucket until it comes around at the right tick. */
+class cFireSimulatorChunkData
+{
+public:
+
+	/** Schedules the fire block at the specified position to be simulated after a_NumTicks ticks (at least one), replacing its previous schedule. */
+	void Schedule(Vector3i a_RelPos, int a_NumTicks);
+
+	/** Returns the number of ticks until the specified block is simulated, or -1 if it isn't scheduled. */
+	int GetTicksLeft(Vector3i a_RelPos) const;
+
+	/** Removes the specified block from the schedule. */
+	void Remove(Vector3i a_RelPos);
+
+	/** Advances the time by one tick and fills a_Due with the blocks scheduled for the new tick,
+	each with the number of ticks since it was last simulated (or scheduled for the first time). */
+	void TakeDue(std::vector<std::pair<Vector3i, int>> & a_Due);
+
+private:
+
+	static constexpr size_t WheelSize = 64;
+
+	struct sFire
+	{
+		Int64 m_DueTick;
+		Int64 m_LastTick;
+	};
+
+	/** The number of ticks simulated in this chunk. */
+	Int64 m_CurrentTick = 0;
+
+	/** All the scheduled fire blocks, by their chunk block index. */
+	std::unordered_map<UInt16, sFire> m_Fires;
+
+	/** Block indices in the buckets by (due tick % WheelSize). May contain stale entries for rescheduled or removed blocks, those are skipped.
+	Allocated on the first Schedule() call, so that chunks without fire don't pay for it. */
+	std::vector<std::vector<UInt16>> m_Wheel;
+};
@@ -9,6 +9,8 @@
 #include "../Chunk.h"
 #include "../IniFile.h"
 #include "../EffectID.h"
+#include "../ClientHandle.h"
+#include "../Entities/Player.h"
 
 #include "../Blocks/BlockSlab.h"
 #include "../Blocks/BlockAnvil.h"
@@ -25,6 +27,7 @@ cSandSimulator::cSandSimulator(cWorld & a_World, cIniFile & a_IniFile) :
 	m_TotalBlocks(0)
 {
 	m_IsInstantFall = a_IniFile.GetValueSetB("Physics", "SandInstantFall", false);
+	m_FallingEntityDistance = a_IniFile.GetValueSetI("Physics", "SandFallingEntityDistance", 48);
 }
 
 
@@ -39,6 +42,15 @@ void cSandSimulator::SimulateChunk(std::chrono::milliseconds a_Dt, int a_ChunkX,
 		return;
 	}
 
+	// Falling block entities are only worth their cost if a player is close enough to see them fall:
+	const bool IsInstantFall = m_IsInstantFall || !IsPlayerNearby(*a_Chunk);
+
+	// Process the blocks bottom-up, so that whole columns settle in a single pass:
+	ChunkData.sort([](const cCoordWithInt & a_Lhs, const cCoordWithInt & a_Rhs)
+	{
+		return a_Lhs.y < a_Rhs.y;
+	});
+
 	int BaseX = a_Chunk->GetPosX() * cChunkDef::Width;
 	int BaseZ = a_Chunk->GetPosZ() * cChunkDef::Width;
 	for (cSandSimulatorChunkData::const_iterator itr = ChunkData.begin(), end = ChunkData.end(); itr != end; ++itr)
@@ -52,9 +64,9 @@ void cSandSimulator::SimulateChunk(std::chrono::milliseconds a_Dt, int a_ChunkX,
 		auto BlockBelow = (itr->y > 0) ? a_Chunk->GetBlock(itr->x, itr->y - 1, itr->z) : Block::Air::Air();
 		if (CanStartFallingThrough(BlockBelow))
 		{
-			if (m_IsInstantFall)
+			if (IsInstantFall)
 			{
-				DoInstantFall(a_Chunk, {itr->x, itr->y, itr->z});
+				DoInstantFallColumn(a_Chunk, {itr->x, itr->y, itr->z});
 				continue;
 			}
 			Vector3i Pos;
@@ -460,3 +472,55 @@ void cSandSimulator::DoInstantFall(cChunk * a_Chunk, Vector3i a_RelPos)
 
 
 
+
+void cSandSimulator::DoInstantFallColumn(cChunk * a_Chunk, Vector3i a_RelPos)
+{
+	// Each block lands on top of the one that fell before it, the blocks above are then left hanging over air:
+	for (auto Pos = a_RelPos; (Pos.y < cChunkDef::Height) && IsAllowedBlock(a_Chunk->GetBlock(Pos)); Pos.y++)
+	{
+		if ((Pos.y <= 0) || !CanStartFallingThrough(a_Chunk->GetBlock(Pos.addedY(-1))))
+		{
+			break;
+		}
+		DoInstantFall(a_Chunk, Pos);
+	}
+}
+
+
+
+
+
+bool cSandSimulator::IsPlayerNearby(const cChunk & a_Chunk) const
+{
+	if (m_FallingEntityDistance <= 0)
+	{
+		return false;
+	}
+
+	// The players that may be close enough must have this chunk loaded, no need to look further:
+	const Vector3d ChunkCenter(
+		a_Chunk.GetPosX() * cChunkDef::Width + cChunkDef::Width / 2,
+		0,
+		a_Chunk.GetPosZ() * cChunkDef::Width + cChunkDef::Width / 2
+	);
+	const double MaxDistance = m_FallingEntityDistance + cChunkDef::Width / 2;
+	for (const auto Client : a_Chunk.GetAllClients())
+	{
+		const cPlayer * Player = Client->GetPlayer();
+		if (Player == nullptr)
+		{
+			continue;
+		}
+		auto Diff = Player->GetPosition() - ChunkCenter;
+		Diff.y = 0;
+		if (Diff.SqrLength() <= MaxDistance * MaxDistance)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+
+
+
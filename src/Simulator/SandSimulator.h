@@ -61,10 +61,20 @@ private:
 
 	bool m_IsInstantFall;  // If set to true, blocks don't fall using cFallingBlock entity, but instantly instead
 
+	/** Horizontal distance from a chunk within which a player makes the blocks fall using cFallingBlock entities.
+	Blocks in chunks with no player this close fall instantly. Zero or negative makes all blocks fall instantly. */
+	int m_FallingEntityDistance;
+
 	int  m_TotalBlocks;    // Total number of blocks currently in the queue for simulating
 
 	virtual void AddBlock(cChunk & a_Chunk, Vector3i a_Position, BlockState a_Block) override;
 
 	/** Performs the instant fall of the block - removes it from top, Finishes it at the bottom */
 	void DoInstantFall(cChunk * a_Chunk, Vector3i a_RelPos);
+
+	/** Instantly drops the block at the specified coords together with the column of falling-able blocks resting on it. */
+	void DoInstantFallColumn(cChunk * a_Chunk, Vector3i a_RelPos);
+
+	/** Returns true if there's a player close enough to the chunk to see the blocks fall. */
+	bool IsPlayerNearby(const cChunk & a_Chunk) const;
 };
@@ -184,6 +184,18 @@ Compression::Result Compression::Extractor::ExtractZLib(ContiguousByteBufferView
 
 
 
+void Compression::Extractor::ExtractZLib(const ContiguousByteBufferView Input, std::byte * const a_Output, const size_t UncompressedSize)
+{
+	if (libdeflate_zlib_decompress(m_Handle, Input.data(), Input.size(), a_Output, UncompressedSize, nullptr) != libdeflate_result::LIBDEFLATE_SUCCESS)
+	{
+		throw std::runtime_error("Data extraction failed.");
+	}
+}
+
+
+
+
+
 template <auto Algorithm>
 Compression::Result Compression::Extractor::Extract(const ContiguousByteBufferView Input)
 {
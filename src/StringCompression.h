@@ -73,6 +73,10 @@ namespace Compression
 		Result ExtractZLib(ContiguousByteBufferView Input);
 		Result ExtractZLib(ContiguousByteBufferView Input, size_t UncompressedSize);
 
+		/** Extracts the data of a known uncompressed size directly into a_Output, which must have space for UncompressedSize bytes.
+		Throws on failure. */
+		void ExtractZLib(ContiguousByteBufferView Input, std::byte * a_Output, size_t UncompressedSize);
+
 	private:
 
 		template <auto Algorithm> Result Extract(ContiguousByteBufferView Input);
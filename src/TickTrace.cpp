@@ -0,0 +1,379 @@
+
+// TickTrace.cpp
+
+// Implements the cTickTrace class that records what the tick threads spend their time on and dumps the trace of overlong ticks
+
+#include "Globals.h"
+#include "TickTrace.h"
+#include "OSSupport/File.h"
+
+
+
+
+
+namespace
+{
+	/** Marks events that aren't tied to a chunk. */
+	constexpr int NoChunk = std::numeric_limits<int>::min();
+
+	/** Number of events kept per thread, a single tick that records more than this loses its oldest events. */
+	constexpr size_t EventsPerThread = 32 * 1024;
+
+	/** A single finished event. */
+	struct sEvent
+	{
+		const char * m_Name;
+		Int64 m_Start;
+		Int64 m_End;
+		int m_ChunkX;
+		int m_ChunkZ;
+		char m_Detail[40];
+	};
+
+	/** The ring buffer of events of a single thread that runs ticks. */
+	struct sThreadTrace
+	{
+		std::vector<sEvent> m_Events = std::vector<sEvent>(EventsPerThread);
+
+		/** Index into m_Events where the next event is written. */
+		size_t m_Next = 0;
+
+		/** Set once m_Events has been filled up, and the oldest events are being overwritten. */
+		bool m_IsWrapped = false;
+
+		AString m_ThreadName;
+
+		/** Start of the tick currently in progress. */
+		Int64 m_TickStart = 0;
+	};
+
+	/** The trace of the current thread, allocated by the first BeginTick() on the thread. */
+	thread_local std::unique_ptr<sThreadTrace> t_Trace;
+
+	std::atomic<bool> g_IsEnabled(true);
+	std::atomic<Int64> g_BudgetNSec(std::chrono::nanoseconds(std::chrono::milliseconds(200)).count());
+
+	/** Protects g_Folder and g_LastDump. */
+	cCriticalSection g_CS;
+	AString g_Folder("ticktraces");
+	std::chrono::steady_clock::time_point g_LastDump;
+
+	/** Minimum time between two dumps, so that a sustained overload doesn't flood the disk with traces. */
+	constexpr auto MinTimeBetweenDumps = std::chrono::seconds(10);
+
+
+
+
+
+	/** Appends a_Text to a_Out as the contents of a JSON string. */
+	void AppendJsonEscaped(AString & a_Out, std::string_view a_Text)
+	{
+		for (const auto Char : a_Text)
+		{
+			switch (Char)
+			{
+				case '"':  a_Out.append("\\\""); break;
+				case '\\': a_Out.append("\\\\"); break;
+				default:
+				{
+					if (static_cast<unsigned char>(Char) < 0x20)
+					{
+						a_Out.append(fmt::format(FMT_STRING("\\u{:04x}"), static_cast<int>(Char)));
+					}
+					else
+					{
+						a_Out.push_back(Char);
+					}
+					break;
+				}
+			}
+		}
+	}
+
+
+
+
+
+	/** Writes the events of a_Trace that ended within the current tick into a Chrome trace JSON file. */
+	void Dump(const sThreadTrace & a_Trace, Int64 a_TickEnd, const AString & a_Folder)
+	{
+		const auto TickStart = a_Trace.m_TickStart;
+		const auto TickMSec = (a_TickEnd - TickStart) / 1000000;
+
+		// Timestamps are in microseconds, relative to the tick start:
+		AString Json;
+		Json.append("{\"displayTimeUnit\":\"ms\",\"otherData\":{\"thread\":\"");
+		AppendJsonEscaped(Json, a_Trace.m_ThreadName);
+		Json.append(fmt::format(FMT_STRING("\",\"tickMSec\":{}"), TickMSec));
+		bool IsTruncated = false;
+		const auto OldestIdx = a_Trace.m_IsWrapped ? a_Trace.m_Next : 0;
+		if (a_Trace.m_IsWrapped && (a_Trace.m_Events[OldestIdx].m_End > TickStart))
+		{
+			IsTruncated = true;
+		}
+		Json.append(fmt::format(FMT_STRING(",\"truncated\":{}}},\"traceEvents\":["), IsTruncated));
+		Json.append("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"");
+		AppendJsonEscaped(Json, a_Trace.m_ThreadName);
+		Json.append("\"}}");
+		Json.append(fmt::format(
+			FMT_STRING(",{{\"name\":\"Tick\",\"cat\":\"Tick\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":0,\"dur\":{:.3f}}}"),
+			static_cast<double>(a_TickEnd - TickStart) / 1000
+		));
+
+		const auto NumEvents = a_Trace.m_IsWrapped ? EventsPerThread : a_Trace.m_Next;
+		for (size_t i = 0; i < NumEvents; i++)
+		{
+			const auto & Event = a_Trace.m_Events[(OldestIdx + i) % EventsPerThread];
+			if (Event.m_End < TickStart)
+			{
+				continue;
+			}
+
+			// Show the detail, if any, as the name of the event, so that it's readable right in the timeline:
+			Json.append(",{\"name\":\"");
+			AppendJsonEscaped(Json, (Event.m_Detail[0] != 0) ? Event.m_Detail : Event.m_Name);
+			Json.append("\",\"cat\":\"");
+			AppendJsonEscaped(Json, Event.m_Name);
+			Json.append(fmt::format(
+				FMT_STRING("\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":{:.3f},\"dur\":{:.3f}"),
+				static_cast<double>(std::max<Int64>(Event.m_Start - TickStart, 0)) / 1000,
+				static_cast<double>(Event.m_End - std::max(Event.m_Start, TickStart)) / 1000
+			));
+			if (Event.m_ChunkX != NoChunk)
+			{
+				Json.append(fmt::format(FMT_STRING(",\"args\":{{\"chunkX\":{},\"chunkZ\":{}}}"), Event.m_ChunkX, Event.m_ChunkZ));
+			}
+			Json.push_back('}');
+		}
+		Json.append("]}\n");
+
+		// Write into a file named after the thread and the current time:
+		cFile::CreateFolderRecursive(a_Folder);
+		auto t = time(nullptr);
+		struct tm stm;
+		#ifdef _MSC_VER
+			localtime_s(&stm, &t);
+		#else
+			localtime_r(&t, &stm);
+		#endif
+		const auto FileName = fmt::format(
+			FMT_STRING("{}{}{}-{}-{:02d}-{:02d}-{:02d}-{:02d}-{:02d}-{}ms.json"),
+			a_Folder, cFile::PathSeparator(), a_Trace.m_ThreadName,
+			stm.tm_year + 1900, stm.tm_mon + 1, stm.tm_mday, stm.tm_hour, stm.tm_min, stm.tm_sec, TickMSec
+		);
+		cFile f;
+		if (!f.Open(FileName, cFile::fmWrite))
+		{
+			LOGWARNING("Cannot open file %s for writing the tick trace.", FileName);
+			return;
+		}
+		f.Write(Json.data(), Json.size());
+		LOGWARNING("Tick of %s took %d ms, the trace has been written into %s", a_Trace.m_ThreadName, static_cast<int>(TickMSec), FileName);
+	}
+
+
+
+
+
+	/** Formats and writes the dumped traces in its own thread, so that the dump doesn't make the overlong tick even longer. */
+	class cDumpWriter
+	{
+	public:
+
+		/** Returns the singleton, starting its thread on first use.
+		Deliberately leaked, with the thread detached; a trace still being written when the server exits is lost. */
+		static cDumpWriter & Get()
+		{
+			static cDumpWriter & Writer = *new cDumpWriter;
+			return Writer;
+		}
+
+		/** Queues the trace for writing the events of the tick that ended at a_TickEnd into a_Folder. */
+		void Queue(std::unique_ptr<sThreadTrace> a_Trace, Int64 a_TickEnd, AString a_Folder)
+		{
+			{
+				cCSLock Lock(m_CS);
+				m_Queue.push_back({std::move(a_Trace), a_TickEnd, std::move(a_Folder)});
+			}
+			m_QueueChanged.Set();
+		}
+
+	private:
+
+		struct sDump
+		{
+			std::unique_ptr<sThreadTrace> m_Trace;
+			Int64 m_TickEnd;
+			AString m_Folder;
+		};
+
+		/** Protects m_Queue. */
+		cCriticalSection m_CS;
+
+		/** Set whenever a trace is added to m_Queue. */
+		cEvent m_QueueChanged;
+
+		std::deque<sDump> m_Queue;
+
+		cDumpWriter()
+		{
+			std::thread(&cDumpWriter::Execute, this).detach();
+		}
+
+		void Execute()
+		{
+			for (;;)
+			{
+				sDump Item;
+				{
+					cCSLock Lock(m_CS);
+					if (m_Queue.empty())
+					{
+						Lock.Unlock();
+						m_QueueChanged.Wait();
+						continue;
+					}
+					Item = std::move(m_Queue.front());
+					m_Queue.pop_front();
+				}
+				Dump(*Item.m_Trace, Item.m_TickEnd, Item.m_Folder);
+			}
+		}
+	};
+}  // namespace (anonymous)
+
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+// cTickTrace::cScope:
+
+cTickTrace::cScope::cScope(const char * a_Name, std::string_view a_Detail) :
+	m_Name(a_Name),
+	m_Detail(a_Detail),
+	m_ChunkX(NoChunk),
+	m_ChunkZ(NoChunk),
+	m_Start(((t_Trace != nullptr) && g_IsEnabled.load(std::memory_order_relaxed)) ? Now() : -1)
+{
+}
+
+
+
+
+
+cTickTrace::cScope::cScope(const char * a_Name, int a_ChunkX, int a_ChunkZ) :
+	m_Name(a_Name),
+	m_ChunkX(a_ChunkX),
+	m_ChunkZ(a_ChunkZ),
+	m_Start(((t_Trace != nullptr) && g_IsEnabled.load(std::memory_order_relaxed)) ? Now() : -1)
+{
+}
+
+
+
+
+
+cTickTrace::cScope::~cScope()
+{
+	if (m_Start < 0)
+	{
+		return;
+	}
+
+	auto & Trace = *t_Trace;
+	auto & Event = Trace.m_Events[Trace.m_Next];
+	Event.m_Name = m_Name;
+	Event.m_Start = m_Start;
+	Event.m_End = Now();
+	Event.m_ChunkX = m_ChunkX;
+	Event.m_ChunkZ = m_ChunkZ;
+	const auto DetailLength = std::min(m_Detail.size(), sizeof(Event.m_Detail) - 1);
+	std::copy_n(m_Detail.data(), DetailLength, Event.m_Detail);
+	Event.m_Detail[DetailLength] = 0;
+
+	Trace.m_Next += 1;
+	if (Trace.m_Next == EventsPerThread)
+	{
+		Trace.m_Next = 0;
+		Trace.m_IsWrapped = true;
+	}
+}
+
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+// cTickTrace:
+
+void cTickTrace::Configure(bool a_IsEnabled, std::chrono::milliseconds a_Budget, const AString & a_Folder)
+{
+	g_IsEnabled = a_IsEnabled;
+	g_BudgetNSec = std::chrono::nanoseconds(a_Budget).count();
+	cCSLock Lock(g_CS);
+	g_Folder = a_Folder;
+}
+
+
+
+
+
+void cTickTrace::BeginTick(const AString & a_ThreadName)
+{
+	if (!g_IsEnabled.load(std::memory_order_relaxed))
+	{
+		return;
+	}
+	if (t_Trace == nullptr)
+	{
+		t_Trace = std::make_unique<sThreadTrace>();
+	}
+	t_Trace->m_ThreadName = a_ThreadName;
+	t_Trace->m_TickStart = Now();
+}
+
+
+
+
+
+void cTickTrace::EndTick()
+{
+	if ((t_Trace == nullptr) || !g_IsEnabled.load(std::memory_order_relaxed))
+	{
+		return;
+	}
+	const auto TickEnd = Now();
+	if (TickEnd - t_Trace->m_TickStart <= g_BudgetNSec.load(std::memory_order_relaxed))
+	{
+		return;
+	}
+
+	AString Folder;
+	{
+		cCSLock Lock(g_CS);
+		const auto CurrentTime = std::chrono::steady_clock::now();
+		if ((g_LastDump != std::chrono::steady_clock::time_point()) && (CurrentTime - g_LastDump < MinTimeBetweenDumps))
+		{
+			return;
+		}
+		g_LastDump = CurrentTime;
+		Folder = g_Folder;
+	}
+
+	// Hand the whole buffer over to the writer thread and continue with a fresh one:
+	auto Trace = std::move(t_Trace);
+	t_Trace = std::make_unique<sThreadTrace>();
+	t_Trace->m_ThreadName = Trace->m_ThreadName;
+	cDumpWriter::Get().Queue(std::move(Trace), TickEnd, std::move(Folder));
+}
+
+
+
+
+
+Int64 cTickTrace::Now()
+{
+	static const auto ProcessStart = std::chrono::steady_clock::now();
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - ProcessStart).count();
+}
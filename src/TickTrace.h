@@ -0,0 +1,68 @@
+
+// TickTrace.h
+
+// Declares the cTickTrace class that records what the tick threads spend their time on and dumps the trace of overlong ticks
+
+/*
+Each tick thread keeps the most recent scoped events (tick phases, chunks, entities, block entities, plugin hooks,
+Lua callbacks) in its own ring buffer; recording an event is just two clock reads and a copy into the buffer, so it's always on.
+When a tick takes longer than the configured budget, all the events recorded during that tick are written, by a background thread, into
+a file in the Chrome trace JSON format, which can be opened in chrome://tracing or https://ui.perfetto.dev.
+This allows diagnosing intermittent lag spikes after the fact, without having to reproduce them.
+Threads that don't run ticks don't record anything, their scopes are no-ops.
+*/
+
+
+
+
+
+#pragma once
+
+
+
+
+
+class cTickTrace
+{
+public:
+
+	/** Records the time spent in its own lifetime as a single event in the current thread's trace.
+	The name must be a string literal or otherwise outlive the trace; the detail is copied (and possibly truncated). */
+	class cScope
+	{
+	public:
+
+		cScope(const char * a_Name, std::string_view a_Detail = {});
+		cScope(const char * a_Name, int a_ChunkX, int a_ChunkZ);
+		~cScope();
+
+		cScope(const cScope &) = delete;
+		cScope & operator = (const cScope &) = delete;
+
+	private:
+
+		const char * m_Name;
+		std::string_view m_Detail;
+		int m_ChunkX, m_ChunkZ;
+
+		/** Start of the scope, in nanoseconds since the process start. Negative if the thread isn't traced. */
+		Int64 m_Start;
+	};
+
+
+	/** Enables or disables the tracing and sets the tick duration over which the trace is dumped into a_Folder. */
+	static void Configure(bool a_IsEnabled, std::chrono::milliseconds a_Budget, const AString & a_Folder);
+
+	/** Marks the start of a tick on the current thread, enabling the recording for the thread if needed.
+	a_ThreadName identifies the thread in the dumped traces. */
+	static void BeginTick(const AString & a_ThreadName);
+
+	/** Marks the end of the tick started by the last BeginTick() on this thread.
+	If the tick took longer than the budget, hands the events recorded since over to a background thread that dumps them into a file. */
+	static void EndTick();
+
+private:
+
+	/** Returns the current time, in nanoseconds since the process start. */
+	static Int64 Now();
+};
@@ -12,6 +12,7 @@
 #include "Generating/ComposableGenerator.h"
 #include "SetChunkData.h"
 #include "DeadlockDetect.h"
+#include "TickTrace.h"
 #include "LineBlockTracer.h"
 #include "UUID.h"
 #include "BlockInServerPluginInterface.h"
@@ -124,7 +125,9 @@ void cWorld::cTickThread::Execute()
 	{
 		auto NowTime = std::chrono::steady_clock::now();
 		auto WaitTime = std::chrono::duration_cast<std::chrono::milliseconds>(NowTime - LastTime);
+		cTickTrace::BeginTick(m_World.GetName());
 		m_World.Tick(WaitTime, TickTime);
+		cTickTrace::EndTick();
 		TickTime = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - NowTime);
 
 		if (TickTime < 1_tick)
@@ -180,6 +183,7 @@ cWorld::cWorld(
 	m_IsDeepSnowEnabled(false),
 	m_ShouldLavaSpawnFire(true),
 	m_VillagersShouldHarvestCrops(true),
+	m_RandomTickSpeed(3),
 	m_SimulatorManager(),
 	m_SandSimulator(),
 	m_WaterSimulator(nullptr),
@@ -224,6 +228,7 @@ cWorld::cWorld(
 	m_GeneratorCallbacks(*this),
 	m_ChunkSender(*this),
 	m_Lighting(*this),
+	m_Pregenerator(*this),
 	m_TickThread(*this)
 {
 	LOGD("cWorld::cWorld(\"%s\")", a_WorldName);
@@ -317,11 +322,14 @@ cWorld::cWorld(
 	m_MaxNetherPortalWidth        = IniFile.GetValueSetI("Mechanics",     "MaxNetherPortalWidth",        21);
 	m_MinNetherPortalHeight       = IniFile.GetValueSetI("Mechanics",     "MinNetherPortalHeight",       3);
 	m_MaxNetherPortalHeight       = IniFile.GetValueSetI("Mechanics",     "MaxNetherPortalHeight",       21);
+	int RandomTickSpeed           = IniFile.GetValueSetI("Mechanics",     "RandomTickSpeed",             m_RandomTickSpeed);
 	m_VillagersShouldHarvestCrops = IniFile.GetValueSetB("Monsters",      "VillagersShouldHarvestCrops", true);
 	m_IsDaylightCycleEnabled      = IniFile.GetValueSetB("General",       "IsDaylightCycleEnabled",      true);
 	int GameMode                  = IniFile.GetValueSetI("General",       "Gamemode",                    static_cast<int>(m_GameMode));
 	int Weather                   = IniFile.GetValueSetI("General",       "Weather",                     static_cast<int>(m_Weather));
 
+	SetRandomTickSpeed(RandomTickSpeed);
+
 	m_WorldAge = std::chrono::milliseconds(IniFile.GetValueSetI("General", "WorldAgeMS", 0LL));
 
 	// Load the weather frequency data:
@@ -436,6 +444,7 @@ cWorld::cWorld(
 
 	m_Storage.Initialize(*this, m_StorageSchema, m_StorageCompressionFactor);
 	m_Generator.Initialize(m_GeneratorCallbacks, m_GeneratorCallbacks, IniFile);
+	m_Pregenerator.Initialize(IniFile);
 
 	m_MapManager.LoadMapData();
 
@@ -701,6 +710,7 @@ void cWorld::Start()
 	m_Generator.Start();
 	m_ChunkSender.Start();
 	m_TickThread.Start();
+	m_Pregenerator.ResumeIfInterrupted();
 }
 
 
@@ -1040,6 +1050,7 @@ void cWorld::Stop(cDeadlockDetect & a_DeadlockDetect)
 	IniFile.WriteFile(m_IniFileName);
 
 	m_TickThread.Stop();
+	m_Pregenerator.Stop();  // Keeps the job for resuming on the next start
 	m_Lighting.Stop();
 	m_Generator.Stop();
 	m_ChunkSender.Stop();
@@ -1091,27 +1102,42 @@ void cWorld::Tick(std::chrono::milliseconds a_Dt, std::chrono::milliseconds a_La
 	}
 
 	// Process all clients' buffered actions:
-	for (const auto Player : m_Players)
 	{
-		Player->GetClientHandle()->ProcessProtocolIn();
+		cTickTrace::cScope Trace("ProcessProtocolIn");
+		for (const auto Player : m_Players)
+		{
+			Player->GetClientHandle()->ProcessProtocolIn();
+		}
 	}
 
 	TickClients(a_Dt);
 	TickQueuedChunkDataSets();
 	TickQueuedBlocks();
-	m_ChunkMap.Tick(a_Dt);
+	{
+		cTickTrace::cScope Trace("ChunkMap");
+		m_ChunkMap.Tick(a_Dt);
+	}
 	TickMobs(a_Dt);
 	TickQueuedEntityAdditions();
-	m_MapManager.TickMaps();
+	{
+		cTickTrace::cScope Trace("Maps");
+		m_MapManager.TickMaps();
+	}
 	TickQueuedTasks();
 	TickWeather(static_cast<float>(a_Dt.count()));
 
-	GetSimulatorManager()->Simulate(static_cast<float>(a_Dt.count()));
+	{
+		cTickTrace::cScope Trace("Simulators");
+		GetSimulatorManager()->Simulate(static_cast<float>(a_Dt.count()));
+	}
 
 	// Flush out all clients' buffered data:
-	for (const auto Player : m_Players)
 	{
-		Player->GetClientHandle()->ProcessProtocolOut();
+		cTickTrace::cScope Trace("ProcessProtocolOut");
+		for (const auto Player : m_Players)
+		{
+			Player->GetClientHandle()->ProcessProtocolOut();
+		}
 	}
 
 	if (m_WorldAge - m_LastChunkCheck > std::chrono::seconds(10))
@@ -1138,6 +1164,7 @@ void cWorld::Tick(std::chrono::milliseconds a_Dt, std::chrono::milliseconds a_La
 
 void cWorld::TickClients(const std::chrono::milliseconds a_Dt)
 {
+	cTickTrace::cScope Trace("TickClients");
 	for (const auto Player : m_Players)
 	{
 		Player->GetClientHandle()->Tick(a_Dt);
@@ -1150,6 +1177,7 @@ void cWorld::TickClients(const std::chrono::milliseconds a_Dt)
 
 void cWorld::TickWeather(float a_Dt)
 {
+	cTickTrace::cScope Trace("TickWeather");
 	UNUSED(a_Dt);
 	// There are no weather changes anywhere but in the Overworld:
 	if (GetDimension() != dimOverworld)
@@ -1218,10 +1246,11 @@ void cWorld::TickWeather(float a_Dt)
 
 void cWorld::TickMobs(std::chrono::milliseconds a_Dt)
 {
+	cTickTrace::cScope Trace("TickMobs");
 	// _X 2013_10_22: This is a quick fix for #283 - the world needs to be locked while ticking mobs
 	cWorld::cLock Lock(*this);
 
-	// before every Mob action, we have to count them depending on the distance to players, on their family ...
+	// before every Mob action, we have to count them by their family; the chunks keep the counts up to date, this only sums them up
 	cMobCensus MobCensus;
 	m_ChunkMap.CollectMobCensus(MobCensus);
 	if (m_bAnimals)
@@ -1275,6 +1304,7 @@ void cWorld::TickMobs(std::chrono::milliseconds a_Dt)
 			// Tick close mobs
 			if (Monster.GetParentChunk()->HasAnyClients())
 			{
+				cTickTrace::cScope Trace("Entity", Monster.GetClass());
 				Monster.Tick(a_Dt, *(a_Entity.GetParentChunk()));
 			}
 			// Destroy far hostile mobs except if last target was a player
@@ -1304,6 +1334,7 @@ void cWorld::TickMobs(std::chrono::milliseconds a_Dt)
 
 void cWorld::TickQueuedChunkDataSets()
 {
+	cTickTrace::cScope Trace("TickQueuedChunkDataSets");
 	decltype(m_SetChunkDataQueue) SetChunkDataQueue;
 	{
 		cCSLock Lock(m_CSSetChunkDataQueue);
@@ -1346,6 +1377,7 @@ void cWorld::TickQueuedChunkDataSets()
 
 void cWorld::TickQueuedEntityAdditions(void)
 {
+	cTickTrace::cScope Trace("TickQueuedEntityAdditions");
 	decltype(m_EntitiesToAdd) EntitiesToAdd;
 	{
 		cCSLock Lock(m_CSEntitiesToAdd);
@@ -1385,6 +1417,7 @@ void cWorld::TickQueuedEntityAdditions(void)
 
 void cWorld::TickQueuedTasks(void)
 {
+	cTickTrace::cScope Trace("TickQueuedTasks");
 	// Move the tasks to be executed to a seperate vector to avoid deadlocks on accessing m_Tasks
 	decltype(m_Tasks) Tasks;
 	{
@@ -2170,6 +2203,24 @@ bool cWorld::GetBlocks(sSetBlockVector & a_Blocks, bool a_ContinueOnFailure)
 
 
 
+size_t cWorld::SetBlocks(const sSetBlockVector & a_Blocks)
+{
+	return m_ChunkMap.SetBlocks(a_Blocks);
+}
+
+
+
+
+
+bool cWorld::GetBlocksInCuboid(const cCuboid & a_Cuboid, std::vector<BlockState> & a_Blocks) const
+{
+	return m_ChunkMap.GetBlocksInCuboid(a_Cuboid, a_Blocks);
+}
+
+
+
+
+
 bool cWorld::DigBlock(Vector3i a_BlockPos, const cEntity * a_Digger)
 {
 	BlockState Block;
@@ -2334,6 +2385,7 @@ bool cWorld::HasChunkAnyClients(int a_ChunkX, int a_ChunkZ) const
 
 void cWorld::UnloadUnusedChunks(void)
 {
+	cTickTrace::cScope Trace("UnloadUnusedChunks");
 	m_LastChunkCheck = m_WorldAge;
 	m_ChunkMap.UnloadUnusedChunks();
 }
@@ -2808,6 +2860,7 @@ bool cWorld::ForEachLoadedChunk(cFunctionRef<bool(int, int)> a_Callback)
 
 void cWorld::SaveAllChunks(void)
 {
+	cTickTrace::cScope Trace("SaveAllChunks");
 	if (IsSavingEnabled())
 	{
 		m_LastSave = m_WorldAge;
@@ -2934,6 +2987,7 @@ void cWorld::GetChunkStats(int & a_NumValid, int & a_NumDirty, int & a_NumInLigh
 
 void cWorld::TickQueuedBlocks(void)
 {
+	cTickTrace::cScope Trace("TickQueuedBlocks");
 	if (m_BlockTickQueue.empty())
 	{
 		return;
@@ -9,6 +9,7 @@
 #include "WorldStorage/WorldStorage.h"
 #include "ChunkGeneratorThread.h"
 #include "ChunkSender.h"
+#include "ChunkPregenerator.h"
 #include "Defines.h"
 #include "LightingThread.h"
 #include "IniFile.h"
@@ -135,6 +136,12 @@ public:
 
 	bool VillagersShouldHarvestCrops(void) const { return m_VillagersShouldHarvestCrops; }
 
+	/** Returns the number of random block ticks per chunk section per game tick (vanilla's randomTickSpeed gamerule) */
+	int GetRandomTickSpeed(void) const { return m_RandomTickSpeed; }
+
+	/** Sets the number of random block ticks per chunk section per game tick; 0 disables the random block ticks */
+	void SetRandomTickSpeed(int a_RandomTickSpeed) { m_RandomTickSpeed = std::max(a_RandomTickSpeed, 0); }
+
 	virtual eDimension GetDimension(void) const override { return m_Dimension; }
 
 	// tolua_end
@@ -528,6 +535,15 @@ public:
 	/** Retrieves block types of the specified blocks. If a chunk is not loaded, doesn't modify the block. Returns true if all blocks were read. */
 	bool GetBlocks(sSetBlockVector & a_Blocks, bool a_ContinueOnFailure);
 
+	/** Sets all the specified blocks, as SetBlock() would, but as a single batch under one chunkmap lock.
+	Group the blocks by chunk for the best performance.
+	Blocks in chunks that are not loaded are skipped. Returns the number of blocks that were set. */
+	size_t SetBlocks(const sSetBlockVector & a_Blocks);
+
+	/** Reads all the blocks in the cuboid (sorted, both coords inclusive) into a flat array, in cBlockArea index order.
+	Blocks in chunks that are not loaded are reported as air. Returns true if all the chunks were loaded. */
+	bool GetBlocksInCuboid(const cCuboid & a_Cuboid, std::vector<BlockState> & a_Blocks) const;
+
 	using cWorldInterface::SendBlockTo;
 
 	// tolua_begin
@@ -761,6 +777,30 @@ public:
 
 	cLightingThread & GetLightingThread(void) { return m_Lighting; }
 
+	// tolua_begin
+
+	/** Starts pregenerating the chunks in the rectangle between the two chunks (inclusive) in the background, directly into the world storage.
+	Returns false if a pregeneration is already running in this world. */
+	bool StartPregenerationSquare(int a_Chunk1X, int a_Chunk1Z, int a_Chunk2X, int a_Chunk2Z) { return m_Pregenerator.StartSquare(a_Chunk1X, a_Chunk1Z, a_Chunk2X, a_Chunk2Z); }
+
+	/** Starts pregenerating the chunks within a_Radius chunks of the center chunk in the background, directly into the world storage, outwards from the center.
+	Returns false if a pregeneration is already running in this world. */
+	bool StartPregenerationSpiral(int a_CenterChunkX, int a_CenterChunkZ, int a_Radius) { return m_Pregenerator.StartSpiral(a_CenterChunkX, a_CenterChunkZ, a_Radius); }
+
+	/** Stops the pregeneration running in this world, it will not be resumed. Returns false if there was none running. */
+	bool StopPregeneration(void) { return m_Pregenerator.Cancel(); }
+
+	bool IsPregenerating(void) const { return m_Pregenerator.IsRunning(); }
+
+	/** Returns the number of chunks processed, and the total number of chunks, of the current (or last) pregeneration. */
+	size_t GetPregenerationNumChunksDone (void) const { return m_Pregenerator.GetNumChunksDone(); }
+	size_t GetPregenerationNumChunksTotal(void) const { return m_Pregenerator.GetNumChunksTotal(); }
+
+	/** Returns a human readable description of the pregeneration progress. */
+	AString GetPregenerationStatus(void) const { return m_Pregenerator.GetStatus(); }
+
+	// tolua_end
+
 	void InitializeSpawn(void);
 
 	/** Starts threads that belong to this world. */
@@ -997,6 +1037,7 @@ private:
 	bool m_IsDeepSnowEnabled;
 	bool m_ShouldLavaSpawnFire;
 	bool m_VillagersShouldHarvestCrops;
+	int m_RandomTickSpeed;
 
 	std::vector<BlockTickQueueItem *> m_BlockTickQueue;
 	std::vector<BlockTickQueueItem *> m_BlockTickQueueCopy;  // Second is for safely removing the objects from the queue
@@ -1079,6 +1120,9 @@ private:
 
 	cChunkSender     m_ChunkSender;
 	cLightingThread  m_Lighting;
+
+	/** Generates areas of the world in the background, directly into the storage. */
+	cChunkPregenerator m_Pregenerator;
 	cTickThread      m_TickThread;
 
 	/** Guards the m_Tasks */
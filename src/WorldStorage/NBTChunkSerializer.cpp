@@ -1281,6 +1281,19 @@ public:
 // NBTChunkSerializer:
 
 void NBTChunkSerializer::Serialize(const cWorld & aWorld, cChunkCoords aCoords, cFastNBTWriter & aWriter)
+{
+	Serialize(aCoords, aWorld.GetWorldAge().count(), aWriter, [&aWorld, aCoords](cChunkDataCallback & aCallback)
+	{
+		[[maybe_unused]] const bool Result = aWorld.GetChunkData(aCoords, aCallback);  // Chunk must be present in order to save
+		ASSERT(Result);
+	});
+}
+
+
+
+
+
+void NBTChunkSerializer::Serialize(cChunkCoords aCoords, Int64 aLastUpdate, cFastNBTWriter & aWriter, cFunctionRef<void(cChunkDataCallback &)> aDataSource)
 {
 	SerializerCollector serializer(aWriter);
 	// set to 1.21.1
@@ -1288,8 +1301,7 @@ void NBTChunkSerializer::Serialize(const cWorld & aWorld, cChunkCoords aCoords,
 
 	aWriter.AddInt("xPos", aCoords.m_ChunkX);
 	aWriter.AddInt("zPos", aCoords.m_ChunkZ);
-	[[maybe_unused]] const bool Result = aWorld.GetChunkData(aCoords, serializer);  // Chunk must be present in order to save
-	ASSERT(Result);
+	aDataSource(serializer);
 	serializer.Finish();  // Close NBT tags
 
 	aWriter.BeginList("sections", TAG_Compound);
@@ -1355,7 +1367,8 @@ void NBTChunkSerializer::Serialize(const cWorld & aWorld, cChunkCoords aCoords,
 			UInt64 tbuf = 0;
 			int BitIndex = 0;
 			int longindex = 0;
-			auto toloop = Blocks->size();
+			// A uniform section is fully described by its palette, there's no data to pack:
+			auto toloop = (newsize > 1) ? Blocks->size() : 0;
 			// int bitswritten = 0;
 			// std::vector<int> bw = {0};
 			for (size_t i = 0; i < toloop; i++)
@@ -1410,14 +1423,11 @@ void NBTChunkSerializer::Serialize(const cWorld & aWorld, cChunkCoords aCoords,
 				}
 			}
 
-			if (Blocks != nullptr)
+			// Same as vanilla, the data is left out for uniform sections, the loader fills the section with the single palette entry:
+			if (newsize > 1)
 			{
 				aWriter.AddLongArray("data", arr, static_cast<UInt64>(longindex));
 			}
-			else
-			{
-				// aWriter.AddByteArray("BlockStates", ChunkBlockData::SectionBlockCount, ChunkBlockData::DefaultValue);  // BROKEN
-			}
 			aWriter.EndCompound();
 			delete[] arr;
 		}
@@ -1443,7 +1453,7 @@ void NBTChunkSerializer::Serialize(const cWorld & aWorld, cChunkCoords aCoords,
 	}
 	aWriter.EndList();  // "Sections"
 
-	aWriter.AddLong("LastUpdate", aWorld.GetWorldAge().count());
+	aWriter.AddLong("LastUpdate", aLastUpdate);
 
 	aWriter.AddLong("InhabitedTime", 0);
 
@@ -3,10 +3,12 @@
 #pragma once
 
 #include "ChunkDef.h"
+#include "FunctionRef.h"
 
 
 
 // fwd:
+class cChunkDataCallback;
 class cFastNBTWriter;
 class cWorld;
 
@@ -23,4 +25,8 @@ public:
 
 	/** Serializes the chunk into the specified writer. The chunk must be present. */
 	static void Serialize(const cWorld & aWorld, cChunkCoords aCoords, cFastNBTWriter & aWriter);
+
+	/** Serializes a chunk whose data is provided by aDataSource, which is expected to feed the whole chunk into the callback
+	the same way cWorld::GetChunkData() does. Used for chunks that aren't loaded in any world, such as by the pregenerator. */
+	static void Serialize(cChunkCoords aCoords, Int64 aLastUpdate, cFastNBTWriter & aWriter, cFunctionRef<void(cChunkDataCallback &)> aDataSource);
 };
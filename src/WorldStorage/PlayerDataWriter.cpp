@@ -0,0 +1,251 @@
+
+// PlayerDataWriter.cpp
+
+// Implements the cPlayerDataWriter class that serializes and writes player data files in a background thread
+
+#include "Globals.h"
+#include "PlayerDataWriter.h"
+
+#include <filesystem>
+
+
+
+
+
+cPlayerDataWriter & cPlayerDataWriter::Get()
+{
+	static cPlayerDataWriter Instance;
+	return Instance;
+}
+
+
+
+
+
+cPlayerDataWriter::cPlayerDataWriter(void):
+	Super("Player data writer"),
+	m_IsRunning(false)
+{
+}
+
+
+
+
+
+cPlayerDataWriter::~cPlayerDataWriter()
+{
+	Stop();
+}
+
+
+
+
+
+void cPlayerDataWriter::Start(void)
+{
+	{
+		cCSLock Lock(m_CS);
+		if (m_IsRunning)
+		{
+			return;
+		}
+		m_IsRunning = true;
+	}
+	Super::Start();
+}
+
+
+
+
+
+void cPlayerDataWriter::Stop(void)
+{
+	{
+		cCSLock Lock(m_CS);
+		if (!m_IsRunning)
+		{
+			return;
+		}
+		m_IsRunning = false;
+	}
+
+	// The thread writes out the rest of the queue before terminating:
+	m_ShouldTerminate = true;
+	m_QueueNonempty.Set();
+	Super::Stop();
+}
+
+
+
+
+
+void cPlayerDataWriter::QueueWrite(const AString & a_FileName, cSerializer && a_Serializer)
+{
+	{
+		cCSLock Lock(m_CS);
+		if (m_IsRunning)
+		{
+			m_Queue.insert_or_assign(a_FileName, std::move(a_Serializer));
+			m_QueueNonempty.Set();
+			return;
+		}
+	}
+
+	// The writer thread is not running, write synchronously:
+	Write(a_FileName, a_Serializer);
+}
+
+
+
+
+
+void cPlayerDataWriter::WaitForFile(const AString & a_FileName)
+{
+	for (;;)
+	{
+		{
+			cCSLock Lock(m_CS);
+			if ((m_Queue.count(a_FileName) == 0) && (m_CurrentFile != a_FileName))
+			{
+				return;
+			}
+		}
+
+		// The timeout covers the case of another waiter consuming the event:
+		m_FileWritten.Wait(50);
+	}
+}
+
+
+
+
+
+void cPlayerDataWriter::ForgetFile(const AString & a_FileName)
+{
+	cCSLock Lock(m_CS);
+	if ((m_Queue.count(a_FileName) != 0) || (m_CurrentFile == a_FileName))
+	{
+		// Forget it in Execute(), once the write is done:
+		m_FilesToForget.insert(a_FileName);
+		return;
+	}
+	m_LastWrittenHashes.erase(a_FileName);
+}
+
+
+
+
+
+void cPlayerDataWriter::Execute(void)
+{
+	for (;;)
+	{
+		AString FileName;
+		cSerializer Serializer;
+		{
+			cCSLock Lock(m_CS);
+			if (
+				!m_CurrentFile.empty() &&
+				(m_Queue.count(m_CurrentFile) == 0) &&
+				(m_FilesToForget.erase(m_CurrentFile) != 0)
+			)
+			{
+				m_LastWrittenHashes.erase(m_CurrentFile);
+			}
+			m_CurrentFile.clear();
+			if (!m_Queue.empty())
+			{
+				auto Node = m_Queue.extract(m_Queue.begin());
+				FileName = std::move(Node.key());
+				Serializer = std::move(Node.mapped());
+				m_CurrentFile = FileName;
+			}
+		}
+		m_FileWritten.SetAll();
+
+		if (FileName.empty())
+		{
+			if (m_ShouldTerminate)
+			{
+				return;
+			}
+			m_QueueNonempty.Wait();
+			continue;
+		}
+
+		Write(FileName, Serializer);
+	}
+}
+
+
+
+
+
+void cPlayerDataWriter::Write(const AString & a_FileName, const cSerializer & a_Serializer)
+{
+	try
+	{
+		WriteFile(a_FileName, a_Serializer);
+	}
+	catch (const std::exception & a_Exception)
+	{
+		LOGWARNING("Error writing player data to file \"%s\": %s. Player will lose their progress", a_FileName.c_str(), a_Exception.what());
+
+		// Make sure the next attempt writes the file even if the data is the same:
+		cCSLock Lock(m_CS);
+		m_LastWrittenHashes.erase(a_FileName);
+	}
+}
+
+
+
+
+
+void cPlayerDataWriter::WriteFile(const AString & a_FileName, const cSerializer & a_Serializer)
+{
+	const auto Data = a_Serializer();
+
+	// Skip the write if the file already contains the same data:
+	const auto Hash = std::hash<AString>()(Data);
+	{
+		cCSLock Lock(m_CS);
+		auto & LastWrittenHash = m_LastWrittenHashes[a_FileName];
+		if (LastWrittenHash == Hash)
+		{
+			return;
+		}
+		LastWrittenHash = Hash;
+	}
+
+	const auto FolderEnd = a_FileName.find_last_of("/\\");
+	if (FolderEnd != AString::npos)
+	{
+		cFile::CreateFolderRecursive(a_FileName.substr(0, FolderEnd));
+	}
+
+	// Write into a temporary file first, so that a crash mid-write doesn't leave a truncated file behind:
+	const auto TempFileName = a_FileName + ".tmp";
+	bool IsSuccessful = false;
+	{
+		cFile f;
+		if (f.Open(TempFileName, cFile::fmWrite))
+		{
+			IsSuccessful = (f.Write(Data.data(), Data.size()) == static_cast<int>(Data.size()));
+		}
+	}
+	std::error_code Error;
+	if (IsSuccessful)
+	{
+		std::filesystem::rename(TempFileName, a_FileName, Error);
+		IsSuccessful = !Error;
+	}
+
+	if (!IsSuccessful)
+	{
+		LOGWARNING("Error writing player data to file \"%s\". Player will lose their progress", a_FileName.c_str());
+
+		// Make sure the next attempt writes the file even if the data is the same:
+		cCSLock Lock(m_CS);
+		m_LastWrittenHashes.erase(a_FileName);
+	}
+}
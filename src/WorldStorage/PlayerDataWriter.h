@@ -0,0 +1,96 @@
+
+// PlayerDataWriter.h
+
+// Declares the cPlayerDataWriter class that serializes and writes player data files in a background thread
+
+
+
+
+
+#pragma once
+
+#include <functional>
+
+#include "../OSSupport/IsThread.h"
+
+
+
+
+
+/** Writes the player save files from a background thread, so that saving players doesn't block the tick threads.
+The players snapshot their state in the tick thread and queue a serializer for each file.
+Repeated writes of the same file that haven't been processed yet are coalesced into the latest one,
+and a file is not rewritten if the serialized data is the same as what was last written into it.
+The files are written atomically, into a temporary file that then replaces the original. */
+class cPlayerDataWriter:
+	public cIsThread
+{
+	using Super = cIsThread;
+
+public:
+
+	/** Produces the data to be written into the file. Called in the writer thread. */
+	using cSerializer = std::function<AString()>;
+
+	/** Returns the singleton instance. A singleton rather than a cRoot member so that players
+	can be saved in their destructor even while the server is being torn down. */
+	static cPlayerDataWriter & Get();
+
+	/** Starts the writer thread. Until then, the writes are done synchronously. */
+	void Start(void);
+
+	/** Writes all the queued files and stops the writer thread. Any writes after this are done synchronously. */
+	void Stop(void);
+
+	/** Queues the data produced by a_Serializer to be written into the specified file.
+	Replaces any queued write of the same file that hasn't been processed yet.
+	If the writer thread isn't running, the file is written right away. */
+	void QueueWrite(const AString & a_FileName, cSerializer && a_Serializer);
+
+	/** Blocks until there's no queued or in-progress write of the specified file, so that it can be read back. */
+	void WaitForFile(const AString & a_FileName);
+
+	/** Drops what is remembered about the last write of the specified file, once its queued writes are done.
+	To be called after the last write of a file that won't be written again soon, such as when the player disconnects. */
+	void ForgetFile(const AString & a_FileName);
+
+private:
+
+	cPlayerDataWriter(void);
+	virtual ~cPlayerDataWriter() override;
+
+	/** Protects all the members below. */
+	cCriticalSection m_CS;
+
+	/** Set while the writer thread is accepting writes. */
+	bool m_IsRunning;
+
+	/** The writes waiting to be processed, by file name. */
+	std::unordered_map<AString, cSerializer> m_Queue;
+
+	/** The name of the file currently being written by the writer thread, empty if none. */
+	AString m_CurrentFile;
+
+	/** Hashes of the data last written into each file, used to skip writing unchanged data. */
+	std::unordered_map<AString, size_t> m_LastWrittenHashes;
+
+	/** Files passed to ForgetFile() while they still had a write queued or in progress.
+	Their m_LastWrittenHashes entry is removed once the writes are done. */
+	std::unordered_set<AString> m_FilesToForget;
+
+	/** Set when a new write is queued, wakes up the writer thread. */
+	cEvent m_QueueNonempty;
+
+	/** Set when a file has been written, wakes up the threads waiting in WaitForFile(). */
+	cEvent m_FileWritten;
+
+	// cIsThread override:
+	virtual void Execute(void) override;
+
+	/** Serializes the data and writes it into the file, unless it hasn't changed since the last write.
+	Logs any failure, including exceptions thrown by the serializer. */
+	void Write(const AString & a_FileName, const cSerializer & a_Serializer);
+
+	/** Implements Write(), may throw. */
+	void WriteFile(const AString & a_FileName, const cSerializer & a_Serializer);
+};
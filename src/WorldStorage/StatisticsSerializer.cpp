@@ -6,6 +6,7 @@
 #include "StatisticsManager.h"
 #include "StatisticsSerializer.h"
 #include "NamespaceSerializer.h"
+#include "../JsonUtils.h"
 
 #include <json/json.h>
 
@@ -13,18 +14,12 @@
 
 
 
-static auto MakeStatisticsDirectory(const std::string & WorldPath, std::string && FileName)
+static auto MakeStatisticsFileName(const std::string & WorldPath, std::string && FileName)
 {
 	// Even though stats are shared between worlds, they are (usually) saved
 	// inside the folder of the default world.
-
-	// Path to the world's statistics folder.
-	const auto Path = WorldPath + cFile::GetPathSeparator() + "stats";
-
-	// Ensure that the directory exists.
-	cFile::CreateFolder(Path);
-
-	return Path + cFile::GetPathSeparator() + std::move(FileName) + ".json";
+	// The folder is created by the writer, only when the file is saved.
+	return WorldPath + cFile::GetPathSeparator() + "stats" + cFile::GetPathSeparator() + std::move(FileName) + ".json";
 }
 
 
@@ -74,7 +69,7 @@ static void LoadCustomStatFromJSON(StatisticsManager & Manager, const Json::Valu
 void StatisticsSerializer::Load(StatisticsManager & Manager, const std::string & WorldPath, std::string && FileName)
 {
 	Json::Value Root;
-	InputFileStream(MakeStatisticsDirectory(WorldPath, std::move(FileName))) >> Root;
+	InputFileStream(MakeStatisticsFileName(WorldPath, std::move(FileName))) >> Root;
 
 	LoadCustomStatFromJSON(Manager, Root["stats"]["custom"]);
 }
@@ -83,12 +78,21 @@ void StatisticsSerializer::Load(StatisticsManager & Manager, const std::string &
 
 
 
-void StatisticsSerializer::Save(const StatisticsManager & Manager, const std::string & WorldPath, std::string && FileName)
+std::string StatisticsSerializer::Save(const StatisticsManager & Manager)
 {
 	Json::Value Root;
 
 	SaveStatToJSON(Manager, Root["stats"]);
 	Root["DataVersion"] = NamespaceSerializer::DataVersion();
 
-	OutputFileStream(MakeStatisticsDirectory(WorldPath, std::move(FileName))) << Root;
+	return JsonUtils::WriteStyledString(Root);
+}
+
+
+
+
+
+std::string StatisticsSerializer::GetFileName(const std::string & WorldPath, std::string && FileName)
+{
+	return MakeStatisticsFileName(WorldPath, std::move(FileName));
 }
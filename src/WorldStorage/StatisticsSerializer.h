@@ -25,6 +25,9 @@ namespace StatisticsSerializer
 	/* Try to load the player statistics. */
 	void Load(StatisticsManager & Manager, const std::string & WorldPath, std::string && FileName);
 
-	/* Try to save the player statistics. */
-	void Save(const StatisticsManager & Manager, const std::string & WorldPath, std::string && FileName);
+	/* Serializes the player statistics into the contents of the statistics file. */
+	std::string Save(const StatisticsManager & Manager);
+
+	/* Returns the path of the statistics file. The folder is not created, the writer creates it when saving. */
+	std::string GetFileName(const std::string & WorldPath, std::string && FileName);
 }
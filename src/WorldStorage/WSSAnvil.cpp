@@ -85,6 +85,7 @@ Since only the header is actually in the memory, this number can be high, but st
 
 cWSSAnvil::cWSSAnvil(cWorld * a_World, int a_CompressionFactor):
 	Super(a_World),
+	m_CompressionFactor(a_CompressionFactor),
 	m_Compressor(a_CompressionFactor)
 {
 	// Create a level.dat file for mapping tools, if it doesn't already exist:
@@ -176,6 +177,51 @@ bool cWSSAnvil::SaveChunk(const cChunkCoords & a_Chunk)
 
 
 
+bool cWSSAnvil::IsChunkStored(const cChunkCoords & a_Chunk)
+{
+	cCSLock Lock(m_CS);
+	auto File = LoadMCAFile(a_Chunk);
+	if (File == nullptr)
+	{
+		return false;
+	}
+	return File->HasChunk(a_Chunk);
+}
+
+
+
+
+
+size_t cWSSAnvil::SaveUnloadedChunk(const cChunkCoords & a_Chunk, cFunctionRef<void(cChunkDataCallback &)> a_DataSource)
+{
+	try
+	{
+		cFastNBTWriter Writer;
+		NBTChunkSerializer::Serialize(a_Chunk, m_World->GetWorldAge().count(), Writer, a_DataSource);
+		Writer.Finish();
+
+		// m_Compressor belongs to the storage thread, this is called from other threads:
+		Compression::Compressor Compressor(m_CompressionFactor);
+		const auto Compressed = Compressor.CompressZLib(Writer.GetResult());
+		const auto Data = Compressed.GetView();
+		if (!SetChunkData(a_Chunk, Data))
+		{
+			LOGWARNING("Cannot store chunk [%d, %d] data", a_Chunk.m_ChunkX, a_Chunk.m_ChunkZ);
+			return 0;
+		}
+		return Data.size();
+	}
+	catch (const std::exception & Oops)
+	{
+		LOGWARNING("Cannot serialize chunk [%d, %d] into data: %s", a_Chunk.m_ChunkX, a_Chunk.m_ChunkZ, Oops.what());
+		return 0;
+	}
+}
+
+
+
+
+
 void cWSSAnvil::ChunkLoadFailed(const cChunkCoords a_ChunkCoords, const AString & a_Reason, const ContiguousByteBufferView a_ChunkDataToSave)
 {
 	// Construct the filename for offloading:
@@ -4320,6 +4366,22 @@ bool cWSSAnvil::cMCAFile::GetChunkData(const cChunkCoords & a_Chunk, ContiguousB
 
 
 
+bool cWSSAnvil::cMCAFile::HasChunk(const cChunkCoords & a_Chunk)
+{
+	if (!OpenFile(true))
+	{
+		return false;
+	}
+
+	const int LocalX = a_Chunk.m_ChunkX - FAST_FLOOR_DIV(a_Chunk.m_ChunkX, 32) * 32;
+	const int LocalZ = a_Chunk.m_ChunkZ - FAST_FLOOR_DIV(a_Chunk.m_ChunkZ, 32) * 32;
+	return ((ntohl(m_Header[LocalX + 32 * LocalZ]) >> 8) >= 2);
+}
+
+
+
+
+
 const std::byte * cWSSAnvil::GetSectionData(const cParsedNBT & a_NBT, int a_Tag, const AString & a_ChildName, size_t a_Length)
 {
 	int Child = a_NBT.FindChildByName(a_Tag, a_ChildName);
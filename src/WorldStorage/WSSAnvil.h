@@ -61,6 +61,9 @@ protected:
 		bool GetChunkData  (const cChunkCoords & a_Chunk, ContiguousByteBuffer & a_Data);
 		bool SetChunkData  (const cChunkCoords & a_Chunk, ContiguousByteBufferView a_Data);
 
+		/** Returns true if the file has data stored for the specified chunk. */
+		bool HasChunk      (const cChunkCoords & a_Chunk);
+
 		int             GetRegionX () const {return m_RegionX; }
 		int             GetRegionZ () const {return m_RegionZ; }
 		const AString & GetFileName() const {return m_FileName; }
@@ -95,6 +98,9 @@ protected:
 	Protected against multithreaded access by m_CS. */
 	std::list<std::shared_ptr<cMCAFile>> m_Files;
 
+	/** The compression factor given in the constructor, for compressors created outside the storage thread. */
+	int m_CompressionFactor;
+
 	Compression::Extractor m_Extractor;
 	Compression::Compressor m_Compressor;
 
@@ -307,4 +313,6 @@ protected:
 	virtual bool LoadChunk(const cChunkCoords & a_Chunk) override;
 	virtual bool SaveChunk(const cChunkCoords & a_Chunk) override;
 	virtual const AString GetName() const override {return "anvil"; }
+	virtual bool IsChunkStored(const cChunkCoords & a_Chunk) override;
+	virtual size_t SaveUnloadedChunk(const cChunkCoords & a_Chunk, cFunctionRef<void(cChunkDataCallback &)> a_DataSource) override;
 } ;
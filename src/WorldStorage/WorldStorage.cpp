@@ -138,6 +138,24 @@ size_t cWorldStorage::GetSaveQueueLength(void)
 
 
 
+bool cWorldStorage::IsChunkStored(cChunkCoords a_Chunk)
+{
+	return m_SaveSchema->IsChunkStored(a_Chunk);
+}
+
+
+
+
+
+size_t cWorldStorage::SaveUnloadedChunk(cChunkCoords a_Chunk, cFunctionRef<void(cChunkDataCallback &)> a_DataSource)
+{
+	return m_SaveSchema->SaveUnloadedChunk(a_Chunk, a_DataSource);
+}
+
+
+
+
+
 void cWorldStorage::QueueLoadChunk(int a_ChunkX, int a_ChunkZ)
 {
 	ASSERT((a_ChunkX > -0x08000000) && (a_ChunkX < 0x08000000));
@@ -15,11 +15,13 @@
 #include "../OSSupport/IsThread.h"
 #include "../OSSupport/Queue.h"
 #include "ChunkDef.h"
+#include "FunctionRef.h"
 
 
 
 
 // fwd:
+class cChunkDataCallback;
 class cWorld;
 
 
@@ -37,6 +39,19 @@ public:
 	virtual bool SaveChunk(const cChunkCoords & a_Chunk) = 0;
 	virtual const AString GetName(void) const = 0;
 
+	/** Returns true if the chunk is already present in the storage.
+	Schemas that cannot tell report all chunks as not stored. May be called from any thread. */
+	virtual bool IsChunkStored(const cChunkCoords & a_Chunk) { UNUSED(a_Chunk); return false; }
+
+	/** Saves a chunk that isn't loaded in the world; a_DataSource feeds the chunk data into the callback given to it.
+	Returns the number of bytes written, or 0 if the schema doesn't support this or the saving failed. May be called from any thread. */
+	virtual size_t SaveUnloadedChunk(const cChunkCoords & a_Chunk, cFunctionRef<void(cChunkDataCallback &)> a_DataSource)
+	{
+		UNUSED(a_Chunk);
+		UNUSED(a_DataSource);
+		return 0;
+	}
+
 protected:
 
 	cWorld * m_World;
@@ -75,6 +90,13 @@ public:
 	size_t GetLoadQueueLength(void);
 	size_t GetSaveQueueLength(void);
 
+	/** Returns true if the chunk is already present in the storage used for saving. May be called from any thread. */
+	bool IsChunkStored(cChunkCoords a_Chunk);
+
+	/** Saves a chunk that isn't loaded in the world directly through the saving schema, bypassing the save queue.
+	Used by the pregenerator. May be called from any thread. Returns the number of bytes written, 0 on failure. */
+	size_t SaveUnloadedChunk(cChunkCoords a_Chunk, cFunctionRef<void(cChunkDataCallback &)> a_DataSource);
+
 protected:
 
 	cWorld * m_World;
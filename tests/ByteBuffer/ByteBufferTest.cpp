@@ -100,10 +100,36 @@ static void TestXZYPositionRoundtrip(void)
 
 
 
+static void TestStringRoundtrip(void)
+{
+	cByteBuffer buf(50);
+	buf.WriteVarUTF8String("Hello");
+	buf.WriteVarUTF8String("a longer string, past the SSO");
+	AString Copy;
+	TEST_TRUE(buf.ReadVarUTF8String(Copy));
+	TEST_EQUAL(Copy, "Hello");
+	std::string_view View;
+	TEST_TRUE(buf.ReadVarUTF8String(View));
+	TEST_EQUAL(View, "a longer string, past the SSO");
+	TEST_FALSE(buf.ReadVarUTF8String(View));
+
+	// After clearing, the data is written contiguously from the start again:
+	buf.Clear();
+	TEST_EQUAL(buf.GetReadableSpace(), 0);
+	buf.WriteVarUTF8String("a longer string, past the SSO");
+	TEST_TRUE(buf.ReadVarUTF8String(View));
+	TEST_EQUAL(View, "a longer string, past the SSO");
+}
+
+
+
+
+
 IMPLEMENT_TEST_MAIN("ByteBuffer",
 	TestRead();
 	TestWrite();
 	TestWrap();
 	TestXYZPositionRoundtrip();
 	TestXZYPositionRoundtrip();
+	TestStringRoundtrip();
 )
@@ -136,6 +136,114 @@ static void Test()
 		CopyAll(buffer, &ChunkLightData::GetSkyLightSection, ChunkLightData::DefaultSkyLightValue, DstLightBuffer);
 		TEST_EQUAL(memcmp(SrcLightBuffer, DstLightBuffer, (16 * 16 * 256 / 2) - 1), 0);
 	}
+
+	{
+		// Identical sections are shared, and copied when written to:
+		ChunkBlockData buffer1;
+		ChunkBlockData buffer2;
+
+		BlockState SrcBlockBuffer[16 * 16 * 256];
+		std::fill(std::begin(SrcBlockBuffer), std::end(SrcBlockBuffer), BlockState(10));
+		SrcBlockBuffer[3 * 16 * 16 * 16] = BlockState(11);  // Section 3 differs from the others
+		buffer1.SetAll(SrcBlockBuffer);
+		buffer2.SetAll(SrcBlockBuffer);
+		TEST_EQUAL(buffer1.GetSection(3), buffer2.GetSection(3));
+
+		buffer2.SetBlock({ 3, 50, 4 }, 0xDE);
+		TEST_NOTEQUAL(buffer1.GetSection(3), buffer2.GetSection(3));
+		TEST_EQUAL(buffer1.GetBlock({ 3, 50, 4 }), BlockState(10));
+		TEST_EQUAL(buffer2.GetBlock({ 3, 50, 4 }), 0xDE);
+
+		// No longer shared, so the remaining owner writes into the section in place:
+		const auto Section = buffer1.GetSection(3);
+		buffer1.SetBlock({ 3, 50, 4 }, 0xDF);
+		TEST_EQUAL(buffer1.GetSection(3), Section);
+		TEST_EQUAL(buffer1.GetBlock({ 3, 50, 4 }), 0xDF);
+
+		ChunkBlockData copy;
+		copy.Assign(buffer1);
+		TEST_EQUAL(copy.GetSection(0), buffer1.GetSection(0));
+
+		// Interning the same data again doesn't find the detached section:
+		buffer2.SetAll(SrcBlockBuffer);
+		TEST_EQUAL(buffer2.GetSection(0), buffer1.GetSection(0));
+		TEST_NOTEQUAL(buffer2.GetSection(3), buffer1.GetSection(3));
+		TEST_EQUAL(buffer2.GetBlock({ 3, 50, 4 }), BlockState(10));
+
+		// Default data frees the section:
+		std::fill(std::begin(SrcBlockBuffer), std::end(SrcBlockBuffer), ChunkBlockData::DefaultValue);
+		buffer2.SetAll(SrcBlockBuffer);
+		TEST_TRUE(buffer2.GetSection(3) == nullptr);
+		TEST_EQUAL(buffer2.GetBlock({ 3, 50, 4 }), ChunkBlockData::DefaultValue);
+	}
+
+	{
+		// Uniformly lit sections are recognized and shared, with the light level available without scanning:
+		static LIGHTTYPE BlockLights[16 * 16 * 256 / 2];
+		static LIGHTTYPE SkyLights[16 * 16 * 256 / 2];
+		memset(BlockLights, 0x00, sizeof(BlockLights));
+		memset(SkyLights, 0xff, sizeof(SkyLights));
+		BlockLights[0] = 0x21;  // Section 0 has varying block light
+
+		ChunkLightData buffer1, buffer2;
+		buffer1.SetAll(BlockLights, SkyLights);
+		buffer2.SetAll(BlockLights, SkyLights);
+		TEST_TRUE(!buffer1.GetUniformBlockLight(0).has_value());
+		TEST_TRUE(!buffer1.GetUniformBlockLight(1).has_value());  // Default light, not allocated
+		TEST_TRUE(buffer1.GetBlockLightSection(1) == nullptr);
+		TEST_EQUAL(buffer1.GetUniformSkyLight(1).value_or(0xff), 15);
+		TEST_EQUAL(buffer1.GetSkyLightSection(1), buffer2.GetSkyLightSection(1));
+		TEST_EQUAL(buffer1.GetSkyLight({ 3, 20, 5 }), 15);
+
+		// Modifying a uniform section makes a private copy:
+		ChunkLightData copy;
+		copy.Assign(buffer1);
+		TEST_EQUAL(copy.GetUniformSkyLight(1).value_or(0xff), 15);
+		memset(SkyLights, 0x77, sizeof(SkyLights));
+		copy.SetAll(BlockLights, SkyLights);
+		TEST_EQUAL(copy.GetUniformSkyLight(1).value_or(0xff), 7);
+		TEST_EQUAL(buffer1.GetUniformSkyLight(1).value_or(0xff), 15);
+
+		// A uniformly dark section that replaces a lit one is stored as uniform too:
+		memset(SkyLights, 0x00, sizeof(SkyLights));
+		copy.SetAll(BlockLights, SkyLights);
+		TEST_EQUAL(copy.GetUniformSkyLight(1).value_or(0xff), 0);
+		TEST_EQUAL(copy.GetSkyLight({ 3, 20, 5 }), 0);
+	}
+
+	{
+		// Sections freed by unloaded chunks are reused, the pools don't grow by repeated loading and unloading:
+		auto LoadUnload = []
+		{
+			std::vector<std::unique_ptr<ChunkBlockData>> Chunks;
+			for (int i = 0; i < 50; i++)
+			{
+				auto & Chunk = *Chunks.emplace_back(std::make_unique<ChunkBlockData>());
+				for (int y = 0; y < 256; y += 16)
+				{
+					Chunk.SetBlock({ i % 16, y, 0 }, BlockState(static_cast<BlockState::DataType>(i + 1)));
+				}
+			}
+		};
+		auto NumSlabs = []
+		{
+			size_t Total = 0;
+			for (const auto & Stats : GetChunkSectionPoolStats())
+			{
+				Total += Stats.m_NumSlabs;
+			}
+			return Total;
+		};
+
+		LoadUnload();
+		const auto NumSlabsAfterFirst = NumSlabs();
+		TEST_GREATER_THAN_OR_EQUAL(NumSlabsAfterFirst, 1);
+		for (int i = 0; i < 10; i++)
+		{
+			LoadUnload();
+		}
+		TEST_EQUAL(NumSlabs(), NumSlabsAfterFirst);
+	}
 }
 
 
@@ -0,0 +1,149 @@
+// ChunkPregeneratorJobTest.cpp
+
+// Tests the region order and the saving and resuming of the cChunkPregeneratorJob class
+
+#include "Globals.h"
+#include "../TestHelpers.h"
+#include "ChunkPregeneratorJob.h"
+#include "IniFile.h"
+
+
+
+
+
+/** Checks that the job's regions cover each chunk of its area exactly once. */
+static void TestCoversArea(const cChunkPregeneratorJob & a_Job)
+{
+	std::set<cChunkCoords> Regions(a_Job.m_Regions.begin(), a_Job.m_Regions.end());
+	TEST_EQUAL(Regions.size(), a_Job.m_Regions.size());
+
+	size_t NumChunks = 0;
+	for (const auto & Region : a_Job.m_Regions)
+	{
+		int MinX, MinZ, MaxX, MaxZ;
+		a_Job.GetRegionArea(Region, MinX, MinZ, MaxX, MaxZ);
+		TEST_LESS_THAN_OR_EQUAL(MinX, MaxX);
+		TEST_LESS_THAN_OR_EQUAL(MinZ, MaxZ);
+		TEST_EQUAL(FAST_FLOOR_DIV(MinX, cChunkPregeneratorJob::RegionWidth), Region.m_ChunkX);
+		TEST_EQUAL(FAST_FLOOR_DIV(MaxZ, cChunkPregeneratorJob::RegionWidth), Region.m_ChunkZ);
+		NumChunks += static_cast<size_t>((MaxX - MinX + 1) * (MaxZ - MinZ + 1));
+	}
+	TEST_EQUAL(NumChunks, a_Job.GetNumChunks());
+}
+
+
+
+
+
+/** The square shape processes the regions row by row. */
+static void TestSquareOrder()
+{
+	// Corners given in any order, the area spans regions -1 .. 1 in X and 0 .. 1 in Z:
+	cChunkPregeneratorJob Job(cChunkPregeneratorJob::eShape::Square, 40, 63, -5, 10);
+	TEST_EQUAL(Job.m_MinChunkX, -5);
+	TEST_EQUAL(Job.m_MaxChunkX, 40);
+	TEST_EQUAL(Job.GetNumChunks(), 46 * 54);
+
+	const std::vector<cChunkCoords> Expected
+	{
+		{-1, 0}, {0, 0}, {1, 0},
+		{-1, 1}, {0, 1}, {1, 1},
+	};
+	TEST_TRUE((Job.m_Regions == Expected));
+	TEST_EQUAL(Job.m_NextRegion, 0);
+	TestCoversArea(Job);
+
+	// A single chunk is a single region:
+	cChunkPregeneratorJob Single(cChunkPregeneratorJob::eShape::Square, -1, -1, -1, -1);
+	TEST_EQUAL(Single.m_Regions.size(), 1);
+	TEST_TRUE((Single.m_Regions[0] == cChunkCoords(-1, -1)));
+	TEST_EQUAL(Single.GetNumChunks(), 1);
+}
+
+
+
+
+
+/** The spiral shape starts in the center region and proceeds outward, ring by ring. */
+static void TestSpiralOrder()
+{
+	// Radius of 70 chunks around chunk {16, 16} spans regions -2 .. 2 in both directions:
+	cChunkPregeneratorJob Job(cChunkPregeneratorJob::eShape::Spiral, 16 - 70, 16 - 70, 16 + 70, 16 + 70);
+	TEST_EQUAL(Job.m_Regions.size(), 25);
+	TEST_TRUE((Job.m_Regions[0] == cChunkCoords(0, 0)));
+
+	int PrevRing = 0;
+	for (const auto & Region : Job.m_Regions)
+	{
+		const int Ring = std::max(std::abs(Region.m_ChunkX), std::abs(Region.m_ChunkZ));
+		TEST_GREATER_THAN_OR_EQUAL(Ring, PrevRing);
+		PrevRing = Ring;
+	}
+	TestCoversArea(Job);
+
+	// Consecutive regions within a ring are neighbors, except when closing the ring:
+	for (size_t i = 2; i < 9; i++)
+	{
+		const auto & Prev = Job.m_Regions[i - 1];
+		const auto & Cur = Job.m_Regions[i];
+		TEST_LESS_THAN_OR_EQUAL(std::max(std::abs(Prev.m_ChunkX - Cur.m_ChunkX), std::abs(Prev.m_ChunkZ - Cur.m_ChunkZ)), 1);
+	}
+}
+
+
+
+
+
+/** A saved job resumes at the region that was being processed, with the chunk count from that region's start. */
+static void TestResume()
+{
+	cChunkPregeneratorJob Job(cChunkPregeneratorJob::eShape::Spiral, -100, -100, 100, 100);
+	Job.FinishRegion(1024);
+	Job.FinishRegion(2048);
+	TEST_EQUAL(Job.m_NextRegion, 2);
+
+	cIniFile State;
+	Job.Save(State);
+
+	cChunkPregeneratorJob Resumed;
+	TEST_TRUE(Resumed.Load(State));
+	TEST_TRUE((Resumed.m_Shape == cChunkPregeneratorJob::eShape::Spiral));
+	TEST_EQUAL(Resumed.m_MinChunkX, -100);
+	TEST_EQUAL(Resumed.m_MinChunkZ, -100);
+	TEST_EQUAL(Resumed.m_MaxChunkX, 100);
+	TEST_EQUAL(Resumed.m_MaxChunkZ, 100);
+	TEST_TRUE((Resumed.m_Regions == Job.m_Regions));
+	TEST_EQUAL(Resumed.m_NextRegion, 2);
+	TEST_EQUAL(Resumed.m_NumChunksDoneBeforeRegion, 2048);
+	TEST_FALSE(Resumed.IsFinished());
+
+	// Finishing all the remaining regions finishes the job:
+	while (!Resumed.IsFinished())
+	{
+		Resumed.FinishRegion(Resumed.m_NumChunksDoneBeforeRegion + 1);
+	}
+	TEST_EQUAL(Resumed.m_NextRegion, Resumed.m_Regions.size());
+
+	// A state with the next region beyond the area (the area was edited in the file) resumes as finished:
+	State.SetValue("Pregenerator", "NextRegion", "1000");
+	cChunkPregeneratorJob Beyond;
+	TEST_TRUE(Beyond.Load(State));
+	TEST_TRUE(Beyond.IsFinished());
+
+	// A state without a job isn't loaded:
+	cIniFile Empty;
+	cChunkPregeneratorJob None;
+	TEST_FALSE(None.Load(Empty));
+	TEST_TRUE(None.IsFinished());
+	TEST_EQUAL(None.GetNumChunks(), 0);
+}
+
+
+
+
+
+IMPLEMENT_TEST_MAIN("ChunkPregeneratorJob",
+	TestSquareOrder();
+	TestSpiralOrder();
+	TestResume();
+)
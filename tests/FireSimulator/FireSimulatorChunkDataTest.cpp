@@ -0,0 +1,159 @@
+// FireSimulatorChunkDataTest.cpp
+
+// Tests the scheduling of the fire blocks in the cFireSimulatorChunkData class
+
+#include "Globals.h"
+#include "../TestHelpers.h"
+#include "Simulator/FireSimulatorChunkData.h"
+
+
+
+
+
+/** Advances the data by one tick and returns the number of ticks since the last simulation of the block, or 0 if it isn't due. */
+static int TakeDueBlock(cFireSimulatorChunkData & a_Data, Vector3i a_RelPos)
+{
+	std::vector<std::pair<Vector3i, int>> Due;
+	a_Data.TakeDue(Due);
+	int Res = 0;
+	for (const auto & [Pos, NumTicks] : Due)
+	{
+		if (Pos == a_RelPos)
+		{
+			TEST_EQUAL(Res, 0);  // Reported only once
+			Res = NumTicks;
+		}
+	}
+	return Res;
+}
+
+
+
+
+
+/** Checks that a block rescheduled right after being taken is simulated again, for delays that are multiples of the wheel size. */
+static void TestRescheduleAfterDue()
+{
+	const Vector3i Pos(3, 70, 12);
+	for (int Delay: {64, 128, 1, 63, 65})
+	{
+		cFireSimulatorChunkData Data;
+		Data.Schedule(Pos, 10);
+		for (int i = 1; i < 10; i++)
+		{
+			TEST_EQUAL(TakeDueBlock(Data, Pos), 0);
+		}
+		TEST_EQUAL(TakeDueBlock(Data, Pos), 10);
+
+		// Reschedule as SimulateChunk() does, for several rounds:
+		for (int Round = 0; Round < 3; Round++)
+		{
+			Data.Schedule(Pos, Delay);
+			TEST_EQUAL(Data.GetTicksLeft(Pos), Delay);
+			for (int i = 1; i < Delay; i++)
+			{
+				TEST_EQUAL(TakeDueBlock(Data, Pos), 0);
+			}
+			TEST_EQUAL(TakeDueBlock(Data, Pos), Delay);
+		}
+	}
+}
+
+
+
+
+
+/** Checks that rescheduling a pending block into the same bucket moves it to the new tick. */
+static void TestReschedulePending()
+{
+	const Vector3i Pos(0, 0, 0);
+	cFireSimulatorChunkData Data;
+	Data.Schedule(Pos, 5);
+	Data.Schedule(Pos, 5 + 64);
+	for (int i = 1; i < 5 + 64; i++)
+	{
+		TEST_EQUAL(TakeDueBlock(Data, Pos), 0);
+	}
+	TEST_EQUAL(TakeDueBlock(Data, Pos), 5 + 64);
+
+	// Moving it sooner, into the same bucket:
+	Data.Schedule(Pos, 2 + 128);
+	Data.Schedule(Pos, 2);
+	TEST_EQUAL(TakeDueBlock(Data, Pos), 0);
+	TEST_EQUAL(TakeDueBlock(Data, Pos), 2);
+	for (int i = 0; i < 200; i++)
+	{
+		TEST_EQUAL(TakeDueBlock(Data, Pos), 0);
+	}
+}
+
+
+
+
+
+/** Compares random schedules, removals and reschedules of the due blocks against a plain map of the due ticks. */
+static void TestRandom()
+{
+	std::minstd_rand Random(0x1357);
+	cFireSimulatorChunkData Data;
+	std::map<size_t, Int64> Expected;  // Block index -> due tick
+	Int64 CurrentTick = 0;
+	for (int Tick = 0; Tick < 5000; Tick++)
+	{
+		// Schedule or remove a few blocks out of a small set, so that they get rescheduled often:
+		for (int i = 0; i < 3; i++)
+		{
+			const auto Index = static_cast<size_t>(Random() % 32) * 97;
+			const auto Pos = cChunkDef::IndexToCoordinate(Index);
+			if ((Random() % 8) == 0)
+			{
+				Data.Remove(Pos);
+				Expected.erase(Index);
+			}
+			else
+			{
+				const int Delay = 1 + static_cast<int>(Random() % 200);
+				Data.Schedule(Pos, Delay);
+				Expected[Index] = CurrentTick + Delay;
+			}
+		}
+
+		std::vector<std::pair<Vector3i, int>> Due;
+		Data.TakeDue(Due);
+		CurrentTick += 1;
+
+		std::set<size_t> ExpectedDue;
+		for (const auto & [Index, DueTick] : Expected)
+		{
+			TEST_LESS_THAN_OR_EQUAL(CurrentTick, DueTick);  // Nothing is ever left behind
+			if (DueTick == CurrentTick)
+			{
+				ExpectedDue.insert(Index);
+			}
+		}
+		std::set<size_t> ActualDue;
+		for (const auto & Item : Due)
+		{
+			TEST_TRUE(ActualDue.insert(cChunkDef::MakeIndex(Item.first)).second);
+		}
+		TEST_TRUE((ActualDue == ExpectedDue));
+
+		// Reschedule the due blocks, with the delays that are multiples of the wheel size being common:
+		for (const auto Index : ActualDue)
+		{
+			const int Delay = ((Random() % 2) == 0) ? 64 * static_cast<int>(1 + Random() % 3) : static_cast<int>(1 + Random() % 100);
+			Data.Schedule(cChunkDef::IndexToCoordinate(Index), Delay);
+			Expected[Index] = CurrentTick + Delay;
+		}
+	}
+}
+
+
+
+
+
+IMPLEMENT_TEST_MAIN("FireSimulatorChunkData",
+	TestRescheduleAfterDue();
+	TestReschedulePending();
+	TestRandom();
+)
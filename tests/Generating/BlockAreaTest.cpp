@@ -0,0 +1,440 @@
+// BlockAreaTest.cpp
+
+// Implements the test of the cBlockArea merge, fill, rotate and mirror kernels against per-block reference implementations
+
+#include "Globals.h"
+#include "../TestHelpers.h"
+#include "BlockArea.h"
+#include "Registries/BlockStates.h"
+
+
+
+
+
+/** The blocks that the random areas are made of.
+Contains all the blocks that the merge strategies treat specially, and blocks with multiple states of the same type. */
+static const BlockState g_Palette[] =
+{
+	Block::Air::Air(),
+	Block::CaveAir::CaveAir(),
+	Block::VoidAir::VoidAir(),
+	Block::Sponge::Sponge(),
+	Block::Stone::Stone(),
+	Block::Dirt::Dirt(),
+	Block::ShortGrass::ShortGrass(),
+	Block::Mycelium::Mycelium(true),
+	Block::Mycelium::Mycelium(false),
+	Block::Water::Water(0),
+	Block::Water::Water(3),
+	Block::Lava::Lava(0),
+	Block::Lava::Lava(5),
+	Block::OakLog::OakLog(Block::OakLog::Axis::X),
+	Block::OakLog::OakLog(Block::OakLog::Axis::Y),
+	Block::OakLog::OakLog(Block::OakLog::Axis::Z),
+};
+
+
+
+
+
+/** Fills the area with random blocks from g_Palette, and random light values if present. */
+static void FillRandom(cBlockArea & a_Area, std::minstd_rand & a_Rnd)
+{
+	for (int y = 0; y < a_Area.GetSizeY(); y++)
+	{
+		for (int z = 0; z < a_Area.GetSizeZ(); z++)
+		{
+			for (int x = 0; x < a_Area.GetSizeX(); x++)
+			{
+				a_Area.SetRelBlock({x, y, z}, g_Palette[a_Rnd() % ARRAYCOUNT(g_Palette)]);
+				if (a_Area.HasBlockLights())
+				{
+					a_Area.SetRelBlockLight({x, y, z}, static_cast<LIGHTTYPE>(a_Rnd() % 16));
+				}
+				if (a_Area.HasBlockSkyLights())
+				{
+					a_Area.SetRelBlockSkyLight({x, y, z}, static_cast<LIGHTTYPE>(a_Rnd() % 16));
+				}
+			}
+		}
+	}
+}
+
+
+
+
+
+/** Creates a copy of the area, with the same size and data. */
+static std::unique_ptr<cBlockArea> Clone(const cBlockArea & a_Area)
+{
+	auto Res = std::make_unique<cBlockArea>();
+	a_Area.CopyTo(*Res);
+	return Res;
+}
+
+
+
+
+
+/** Checks that the two areas have the same size and the same blocks and light values. */
+static void CompareAreas(const cBlockArea & a_Actual, const cBlockArea & a_Expected, const AString & a_Operation)
+{
+	TEST_EQUAL_MSG(a_Actual.GetSize(), a_Expected.GetSize(), a_Operation);
+	for (int y = 0; y < a_Expected.GetSizeY(); y++)
+	{
+		for (int z = 0; z < a_Expected.GetSizeZ(); z++)
+		{
+			for (int x = 0; x < a_Expected.GetSizeX(); x++)
+			{
+				const Vector3i Pos(x, y, z);
+				TEST_EQUAL_MSG(a_Actual.GetRelBlock(Pos).ID, a_Expected.GetRelBlock(Pos).ID, fmt::format(FMT_STRING("{} at {}"), a_Operation, Pos));
+				if (a_Expected.HasBlockLights())
+				{
+					TEST_EQUAL_MSG(a_Actual.GetRelBlockLight(Pos), a_Expected.GetRelBlockLight(Pos), fmt::format(FMT_STRING("{} light at {}"), a_Operation, Pos));
+				}
+				if (a_Expected.HasBlockSkyLights())
+				{
+					TEST_EQUAL_MSG(a_Actual.GetRelBlockSkyLight(Pos), a_Expected.GetRelBlockSkyLight(Pos), fmt::format(FMT_STRING("{} skylight at {}"), a_Operation, Pos));
+				}
+			}
+		}
+	}
+}
+
+
+
+
+
+static bool IsAirType(BlockState a_Block)
+{
+	switch (a_Block.Type())
+	{
+		case BlockType::Air:
+		case BlockType::CaveAir:
+		case BlockType::VoidAir:
+			return true;
+		default: return false;
+	}
+}
+
+
+
+
+
+/** Merges a single block using the specified strategy, in the straightforward per-block way, comparing block types. */
+static BlockState ReferenceMergeBlock(BlockState a_Dst, BlockState a_Src, cBlockArea::eMergeStrategy a_Strategy)
+{
+	switch (a_Strategy)
+	{
+		case cBlockArea::msOverwrite:
+		{
+			return a_Src;
+		}
+		case cBlockArea::msFillAir:
+		{
+			return IsAirType(a_Dst) ? a_Src : a_Dst;
+		}
+		case cBlockArea::msImprint:
+		{
+			return IsAirType(a_Src) ? a_Dst : a_Src;
+		}
+		case cBlockArea::msLake:
+		{
+			if (a_Src.Type() == BlockType::Sponge)
+			{
+				return a_Dst;
+			}
+			if (IsAirType(a_Src))
+			{
+				return Block::Air::Air();
+			}
+			if ((a_Dst.Type() == BlockType::Water) || (a_Dst.Type() == BlockType::Lava))
+			{
+				return a_Dst;
+			}
+			if ((a_Src.Type() == BlockType::Water) || (a_Src.Type() == BlockType::Lava))
+			{
+				return a_Src;
+			}
+			if (
+				(a_Src.Type() == BlockType::Stone) &&
+				((a_Dst.Type() == BlockType::Dirt) || (a_Dst.Type() == BlockType::ShortGrass) || (a_Dst.Type() == BlockType::Mycelium))
+			)
+			{
+				return BlockType::Stone;
+			}
+			return a_Dst;
+		}
+		case cBlockArea::msSpongePrint:
+		{
+			return (a_Src.Type() == BlockType::Sponge) ? a_Dst : a_Src;
+		}
+		case cBlockArea::msDifference:
+		{
+			return (a_Dst.Type() == a_Src.Type()) ? BlockState(BlockType::Air) : a_Src;
+		}
+		case cBlockArea::msSimpleCompare:
+		{
+			return (a_Dst == a_Src) ? Block::Air::Air() : Block::Stone::Stone();
+		}
+		case cBlockArea::msMask:
+		{
+			return (a_Dst.Type() == a_Src.Type()) ? a_Dst : BlockState(BlockType::Air);
+		}
+	}
+	UNREACHABLE("Unsupported block area merge strategy");
+}
+
+
+
+
+
+/** Merges the areas block by block, using ReferenceMergeBlock(). */
+static void ReferenceMerge(cBlockArea & a_Dst, const cBlockArea & a_Src, Vector3i a_RelPos, cBlockArea::eMergeStrategy a_Strategy)
+{
+	for (int y = 0; y < a_Src.GetSizeY(); y++)
+	{
+		for (int z = 0; z < a_Src.GetSizeZ(); z++)
+		{
+			for (int x = 0; x < a_Src.GetSizeX(); x++)
+			{
+				const Vector3i DstPos = a_RelPos + Vector3i(x, y, z);
+				if (!a_Dst.IsValidRelCoords(DstPos))
+				{
+					continue;
+				}
+				a_Dst.SetRelBlock(DstPos, ReferenceMergeBlock(a_Dst.GetRelBlock(DstPos), a_Src.GetRelBlock({x, y, z}), a_Strategy));
+			}
+		}
+	}
+}
+
+
+
+
+
+/** Tests all the merge strategies at various relative positions, including the partial overlaps in each direction,
+and full-width merges that are copied in whole layers. */
+static void TestMerge(void)
+{
+	static const cBlockArea::eMergeStrategy Strategies[] =
+	{
+		cBlockArea::msOverwrite,
+		cBlockArea::msFillAir,
+		cBlockArea::msImprint,
+		cBlockArea::msLake,
+		cBlockArea::msSpongePrint,
+		cBlockArea::msDifference,
+		cBlockArea::msSimpleCompare,
+		cBlockArea::msMask,
+	};
+	static const Vector3i SrcSizes[] =
+	{
+		{5, 4, 6},
+		{11, 3, 9},  // The same width as the dst, so that the rows of a layer are contiguous in both
+		{1, 1, 1},
+		{20, 12, 15},  // Larger than the dst in all directions
+	};
+	static const Vector3i RelPositions[] =
+	{
+		{0, 0, 0},
+		{3, 2, 1},
+		{-2, -1, -3},
+		{8, 5, 7},
+		{-4, 3, 2},
+		{2, -2, -1},
+		{40, 0, 0},  // No overlap at all
+	};
+
+	std::minstd_rand Rnd(0x1234);
+	for (const auto Strategy: Strategies)
+	{
+		for (const auto & SrcSize: SrcSizes)
+		{
+			for (const auto & RelPos: RelPositions)
+			{
+				cBlockArea Src, Dst;
+				Src.Create(SrcSize, cBlockArea::baBlocks);
+				Dst.Create(11, 7, 9, cBlockArea::baBlocks);
+				FillRandom(Src, Rnd);
+				FillRandom(Dst, Rnd);
+				auto Expected = Clone(Dst);
+
+				Dst.Merge(Src, RelPos, Strategy);
+				ReferenceMerge(*Expected, Src, RelPos, Strategy);
+				CompareAreas(Dst, *Expected, fmt::format(FMT_STRING("Merge (strategy {}, src size {}, relpos {})"), static_cast<int>(Strategy), SrcSize, RelPos));
+			}
+		}
+	}
+}
+
+
+
+
+
+/** Tests filling the whole area and its sub-cuboids, with each combination of the data types. */
+static void TestFill(void)
+{
+	static const int DataTypes[] =
+	{
+		cBlockArea::baBlocks,
+		cBlockArea::baLight,
+		cBlockArea::baSkyLight,
+		cBlockArea::baBlocks | cBlockArea::baLight,
+		cBlockArea::baBlocks | cBlockArea::baLight | cBlockArea::baSkyLight,
+	};
+	static const cCuboid Cuboids[] =
+	{
+		{{0, 0, 0}, {8, 5, 6}},  // The whole area
+		{{2, 1, 3}, {4, 4, 5}},
+		{{0, 3, 0}, {8, 3, 6}},  // A single full layer
+		{{5, 0, 2}, {5, 5, 2}},  // A single column
+		{{7, 2, 4}, {7, 2, 4}},  // A single block
+	};
+
+	std::minstd_rand Rnd(0x5678);
+	const auto Block = Block::OakLog::OakLog(Block::OakLog::Axis::Z);
+	for (const auto Types: DataTypes)
+	{
+		// Fill the whole area:
+		{
+			cBlockArea Area;
+			Area.Create(9, 6, 7, cBlockArea::baBlocks | cBlockArea::baLight | cBlockArea::baSkyLight);
+			FillRandom(Area, Rnd);
+			auto Expected = Clone(Area);
+			Area.Fill(Types, Block, 3, 11);
+			for (int y = 0; y < Expected->GetSizeY(); y++) for (int z = 0; z < Expected->GetSizeZ(); z++) for (int x = 0; x < Expected->GetSizeX(); x++)
+			{
+				if ((Types & cBlockArea::baBlocks) != 0)
+				{
+					Expected->SetRelBlock({x, y, z}, Block);
+				}
+				if ((Types & cBlockArea::baLight) != 0)
+				{
+					Expected->SetRelBlockLight({x, y, z}, 3);
+				}
+				if ((Types & cBlockArea::baSkyLight) != 0)
+				{
+					Expected->SetRelBlockSkyLight({x, y, z}, 11);
+				}
+			}  // for x, z, y
+			CompareAreas(Area, *Expected, fmt::format(FMT_STRING("Fill (types {})"), Types));
+		}
+
+		// Fill the sub-cuboids:
+		for (const auto & Cuboid: Cuboids)
+		{
+			cBlockArea Area;
+			Area.Create(9, 6, 7, cBlockArea::baBlocks | cBlockArea::baLight | cBlockArea::baSkyLight);
+			FillRandom(Area, Rnd);
+			auto Expected = Clone(Area);
+			Area.FillRelCuboid(Cuboid, Types, Block, 3, 11);
+			for (int y = Cuboid.p1.y; y <= Cuboid.p2.y; y++) for (int z = Cuboid.p1.z; z <= Cuboid.p2.z; z++) for (int x = Cuboid.p1.x; x <= Cuboid.p2.x; x++)
+			{
+				if ((Types & cBlockArea::baBlocks) != 0)
+				{
+					Expected->SetRelBlock({x, y, z}, Block);
+				}
+				if ((Types & cBlockArea::baLight) != 0)
+				{
+					Expected->SetRelBlockLight({x, y, z}, 3);
+				}
+				if ((Types & cBlockArea::baSkyLight) != 0)
+				{
+					Expected->SetRelBlockSkyLight({x, y, z}, 11);
+				}
+			}  // for x, z, y
+			CompareAreas(Area, *Expected, fmt::format(FMT_STRING("FillRelCuboid (types {}, cuboid {} - {})"), Types, Cuboid.p1, Cuboid.p2));
+		}
+	}
+}
+
+
+
+
+
+/** Tests the rotations and mirroring against the per-block coord transformations, for areas of various shapes.
+The test build's block handlers don't change the block states, so only the block positions are checked. */
+static void TestRotateMirror(void)
+{
+	static const Vector3i Sizes[] =
+	{
+		{7, 3, 5},
+		{4, 2, 9},
+		{6, 1, 6},
+		{1, 4, 8},
+		{8, 4, 1},
+		{1, 1, 1},
+	};
+
+	std::minstd_rand Rnd(0x9abc);
+	for (const auto & Size: Sizes)
+	{
+		cBlockArea Orig;
+		Orig.Create(Size, cBlockArea::baBlocks);
+		FillRandom(Orig, Rnd);
+
+		// Build the expected results block by block:
+		cBlockArea ExpectedCW, ExpectedCCW, ExpectedXY, ExpectedXZ, ExpectedYZ;
+		ExpectedCW.Create(Size.z, Size.y, Size.x, cBlockArea::baBlocks);
+		ExpectedCCW.Create(Size.z, Size.y, Size.x, cBlockArea::baBlocks);
+		ExpectedXY.Create(Size, cBlockArea::baBlocks);
+		ExpectedXZ.Create(Size, cBlockArea::baBlocks);
+		ExpectedYZ.Create(Size, cBlockArea::baBlocks);
+		for (int y = 0; y < Size.y; y++) for (int z = 0; z < Size.z; z++) for (int x = 0; x < Size.x; x++)
+		{
+			const auto Block = Orig.GetRelBlock({x, y, z});
+			ExpectedCW.SetRelBlock({Size.z - z - 1, y, x}, Block);
+			ExpectedCCW.SetRelBlock({z, y, Size.x - x - 1}, Block);
+			ExpectedXY.SetRelBlock({x, y, Size.z - z - 1}, Block);
+			ExpectedXZ.SetRelBlock({x, Size.y - y - 1, z}, Block);
+			ExpectedYZ.SetRelBlock({Size.x - x - 1, y, z}, Block);
+		}  // for x, z, y
+
+		auto Area = Clone(Orig);
+		Area->RotateCW();
+		CompareAreas(*Area, ExpectedCW, fmt::format(FMT_STRING("RotateCW (size {})"), Size));
+
+		Area = Clone(Orig);
+		Area->RotateCCW();
+		CompareAreas(*Area, ExpectedCCW, fmt::format(FMT_STRING("RotateCCW (size {})"), Size));
+
+		Area = Clone(Orig);
+		Area->MirrorXY();
+		CompareAreas(*Area, ExpectedXY, fmt::format(FMT_STRING("MirrorXY (size {})"), Size));
+
+		Area = Clone(Orig);
+		Area->MirrorXZ();
+		CompareAreas(*Area, ExpectedXZ, fmt::format(FMT_STRING("MirrorXZ (size {})"), Size));
+
+		Area = Clone(Orig);
+		Area->MirrorYZ();
+		CompareAreas(*Area, ExpectedYZ, fmt::format(FMT_STRING("MirrorYZ (size {})"), Size));
+
+		// Rotating there and back, and a full turn in either direction, produce the original:
+		Area = Clone(Orig);
+		Area->RotateCW();
+		Area->RotateCCW();
+		CompareAreas(*Area, Orig, fmt::format(FMT_STRING("RotateCW + RotateCCW (size {})"), Size));
+		for (int i = 0; i < 4; i++)
+		{
+			Area->RotateCW();
+		}
+		CompareAreas(*Area, Orig, fmt::format(FMT_STRING("4x RotateCW (size {})"), Size));
+		for (int i = 0; i < 4; i++)
+		{
+			Area->RotateCCW();
+		}
+		CompareAreas(*Area, Orig, fmt::format(FMT_STRING("4x RotateCCW (size {})"), Size));
+	}
+}
+
+
+
+
+
+IMPLEMENT_TEST_MAIN("BlockArea",
+	TestMerge();
+	TestFill();
+	TestRotateMirror();
+)
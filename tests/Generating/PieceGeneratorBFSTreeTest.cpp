@@ -3,7 +3,9 @@
 // Implements the test for the cPieceGeneratorBFSTree class
 
 /*
-Unlike most tests, this is actually not meant as much for unit-testing, but more like performance-testing.
+The hitbox grid used for the collision checks is verified against a brute-force check first.
+
+Other than that, this is actually not meant as much for unit-testing, but more like performance-testing.
 Compile this project in Release mode, then run it in folder that has NetherFort.cubeset prefabs, too, using
 a higher number of repetitions (each repetition takes time on the order of a second); investigate the
 runtime performance with a profiler.
@@ -25,6 +27,94 @@ numRepetitions is the number of NetherFort structures to be generated (default =
 
 
 
+/** Exposes the generator's hitbox grid for testing. */
+class cTestPieceGenerator :
+	public cPieceGeneratorBFSTree
+{
+public:
+	using cPieceGeneratorBFSTree::cHitBoxGrid;
+};
+
+
+
+
+
+/** Returns a random sorted cuboid, spanning up to several grid cells, on both sides of the zero coords. */
+static cCuboid RandomCuboid(std::minstd_rand & a_Rnd)
+{
+	std::uniform_int_distribution<int> Pos(-100, 100);
+	std::uniform_int_distribution<int> Size(0, 40);
+	const Vector3i p1(Pos(a_Rnd), Pos(a_Rnd), Pos(a_Rnd));
+	cCuboid Cuboid(p1, p1 + Vector3i(Size(a_Rnd), Size(a_Rnd), Size(a_Rnd)));
+	Cuboid.Sort();
+	return Cuboid;
+}
+
+
+
+
+
+/** Checks the hitbox grid against testing each of the added hitboxes one by one. */
+static int testHitBoxGrid()
+{
+	std::minstd_rand Rnd(0x2468);
+	for (int Round = 0; Round < 50; ++Round)
+	{
+		cTestPieceGenerator::cHitBoxGrid Grid;
+		std::vector<cCuboid> HitBoxes;
+		for (int i = 0; i < 30; ++i)
+		{
+			const auto HitBox = RandomCuboid(Rnd);
+			Grid.Add(HitBox);
+			HitBoxes.push_back(HitBox);
+
+			// Check a few random hitboxes after each addition, as the generator does:
+			for (int Check = 0; Check < 20; ++Check)
+			{
+				const auto Tested = RandomCuboid(Rnd);
+				const bool Expected = std::any_of(HitBoxes.begin(), HitBoxes.end(),
+					[&Tested](const cCuboid & a_HitBox)
+					{
+						return a_HitBox.DoesIntersect(Tested);
+					}
+				);
+				if (Grid.DoesIntersect(Tested) != Expected)
+				{
+					LOGERROR("Hitbox grid mismatch in round %d for {%d, %d, %d} - {%d, %d, %d}: expected %s",
+						Round, Tested.p1.x, Tested.p1.y, Tested.p1.z, Tested.p2.x, Tested.p2.y, Tested.p2.z,
+						Expected ? "an intersection" : "no intersection"
+					);
+					return -1;
+				}
+			}
+		}
+
+		// Each added hitbox must be found by itself:
+		for (const auto & HitBox : HitBoxes)
+		{
+			if (!Grid.DoesIntersect(HitBox))
+			{
+				LOGERROR("Hitbox grid doesn't find an added hitbox in round %d", Round);
+				return -1;
+			}
+		}
+
+		// A cleared grid doesn't find anything:
+		Grid.Clear();
+		if (Grid.DoesIntersect(HitBoxes.front()))
+		{
+			LOGERROR("Hitbox grid finds a hitbox after being cleared in round %d", Round);
+			return -1;
+		}
+	}
+	LOGD("The hitbox grid matches the brute-force check.");
+	return 0;
+}
+
+
+
+
+
 static int test(int a_NumRepetitions)
 {
 	// Load the piece pool:
@@ -71,9 +161,15 @@ int main(int argc, char * argv[])
 			numRepetitions = rep;
 		}
 	}
-	LOGD("Performing %d repetitions", numRepetitions);
+	auto res = testHitBoxGrid();
+	if (res != 0)
+	{
+		LOGD("Test failed.");
+		return res;
+	}
 
-	auto res = test(numRepetitions);
+	LOGD("Performing %d repetitions", numRepetitions);
+	res = test(numRepetitions);
 	if (res != 0)
 	{
 		LOGD("Test failed.");
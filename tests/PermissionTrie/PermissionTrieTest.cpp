@@ -0,0 +1,115 @@
+// PermissionTrieTest.cpp
+
+// Tests the cPermissionTrie class against matching the split permission against each template one by one
+
+#include "Globals.h"
+#include "../TestHelpers.h"
+#include "PermissionTrie.h"
+
+
+
+
+
+/** Returns a random dot-delimited string made of a few short parts, including wildcards, empty parts and a trailing dot. */
+static AString RandomPermission(std::minstd_rand & a_Rnd)
+{
+	static const char * Parts[] = { "a", "b", "ab", "core", "*", "" };
+	std::uniform_int_distribution<size_t> NumParts(0, 4);
+	std::uniform_int_distribution<size_t> Part(0, std::size(Parts) - 1);
+
+	AString Res;
+	const auto Count = NumParts(a_Rnd);
+	for (size_t i = 0; i < Count; i++)
+	{
+		if (i > 0)
+		{
+			Res.push_back('.');
+		}
+		Res.append(Parts[Part(a_Rnd)]);
+	}
+	if ((Count > 0) && (Part(a_Rnd) == 0))
+	{
+		Res.push_back('.');
+	}
+	return Res;
+}
+
+
+
+
+
+/** Returns true if a_Permission matches any of a_Templates, the way the permissions were checked before the trie. */
+static bool MatchesAny(const AString & a_Permission, const AStringVector & a_Templates)
+{
+	const auto SplitPermission = StringSplit(a_Permission, ".");
+	return std::any_of(a_Templates.begin(), a_Templates.end(),
+		[&SplitPermission](const AString & a_Template)
+		{
+			return cPermissionTrie::TemplateMatches(SplitPermission, StringSplit(a_Template, "."));
+		}
+	);
+}
+
+
+
+
+
+/** Tests a few well-known cases. */
+static void TestKnownCases()
+{
+	cPermissionTrie Trie;
+	Trie.Set({ "core.teleport", "worldedit.*", "a.b.c" });
+	TEST_TRUE(Trie.Matches("core.teleport"));
+	TEST_TRUE(!Trie.Matches("core"));
+	TEST_TRUE(!Trie.Matches("core.teleport.other"));
+	TEST_TRUE(Trie.Matches("worldedit.wand"));
+	TEST_TRUE(Trie.Matches("worldedit.selection.pos1"));
+	TEST_TRUE(!Trie.Matches("worldedit"));
+	TEST_TRUE(!Trie.Matches("a.b"));
+	TEST_TRUE(Trie.Matches("a.b.c"));
+
+	Trie.Set({ "*" });
+	TEST_TRUE(Trie.Matches("anything.at.all"));
+
+	Trie.Clear();
+	TEST_TRUE(!Trie.Matches("core.teleport"));
+}
+
+
+
+
+
+/** Compares the trie against MatchesAny() on random templates and permissions. */
+static void TestRandom()
+{
+	std::minstd_rand Rnd(0x1357);
+	std::uniform_int_distribution<size_t> NumTemplates(0, 6);
+	for (int Round = 0; Round < 2000; Round++)
+	{
+		AStringVector Templates;
+		const auto Count = NumTemplates(Rnd);
+		for (size_t i = 0; i < Count; i++)
+		{
+			Templates.push_back(RandomPermission(Rnd));
+		}
+
+		cPermissionTrie Trie;
+		Trie.Set(Templates);
+		for (int Check = 0; Check < 50; Check++)
+		{
+			const auto Permission = RandomPermission(Rnd);
+			TEST_EQUAL_MSG(Trie.Matches(Permission), MatchesAny(Permission, Templates),
+				fmt::format(FMT_STRING("Permission \"{}\", templates \"{}\""), Permission, fmt::join(Templates, "\", \""))
+			);
+		}
+	}
+}
+
+
+
+
+
+IMPLEMENT_TEST_MAIN("PermissionTrie",
+	TestKnownCases();
+	TestRandom();
+)